@@ -202,7 +202,8 @@ brave_shields::AdBlockService* BraveBrowserProcessImpl::ad_block_service() {
             brave_component_updater_delegate(),
             AdBlockSubscriptionDownloadManagerGetter(),
             profile_manager()->user_data_dir().Append(
-                profile_manager()->GetInitialProfileDir())));
+                profile_manager()->GetInitialProfileDir())),
+        profile_manager()->user_data_dir());
   }
   return ad_block_service_.get();
 }
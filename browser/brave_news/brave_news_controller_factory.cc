@@ -53,7 +53,8 @@ KeyedService* BraveNewsControllerFactory::BuildServiceInstanceFor(
       profile, ServiceAccessType::EXPLICIT_ACCESS);
   return new BraveNewsController(profile->GetPrefs(), ads_service,
                                  history_service,
-                                 profile->GetURLLoaderFactory());
+                                 profile->GetURLLoaderFactory(),
+                                 profile->GetPath());
 }
 
 content::BrowserContext* BraveNewsControllerFactory::GetBrowserContextToUse(
@@ -98,7 +98,7 @@ void RewardsTabHelper::ResourceLoadComplete(
     // Formerly ResourceType::kImage
     case network::mojom::RequestDestination::kImage:
     case network::mojom::RequestDestination::kScript:
-      rewards_service_->OnXHRLoad(tab_id_, GURL(resource_load_info.final_url),
+      rewards_service_->OnXHRLoad(tab_id_, resource_load_info.final_url,
                                   web_contents()->GetURL(),
                                   resource_load_info.referrer);
       break;
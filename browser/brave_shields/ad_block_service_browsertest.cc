@@ -22,6 +22,7 @@
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
+#include "brave/components/brave_shields/browser/ad_block_resource_store.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service_manager.h"
@@ -1695,14 +1696,15 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, RedirectWithoutBlockIsNoop) {
   GetTestDataDir(&test_data_dir);
   LoadDAT(test_data_dir.AppendASCII("adblock-data")
               .AppendASCII("redirect-rule.dat"));
-  g_brave_browser_process->ad_block_service()->AddResources(R"([{
+  g_brave_browser_process->ad_block_service()->AddResources(
+      base::MakeRefCounted<brave_shields::AdBlockResourceStore>(R"([{
         "name": "noop.js",
         "aliases": ["noopjs"],
         "kind": {
           "mime":"application/javascript"
         },
         "content": "KGZ1bmN0aW9uKCkgewogICAgJ3VzZSBzdHJpY3QnOwp9KSgpOwo="
-      }])");
+      }])"));
   WaitForAdBlockServiceThreads();
 
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
@@ -9,6 +9,8 @@
 #include <utility>
 
 #include "brave/browser/brave_news/brave_news_controller_factory.h"
+#include "brave/browser/brave_rewards/rewards_service_factory.h"
+#include "brave/components/brave_rewards/browser/rewards_service.h"
 #include "brave/components/brave_today/buildflags/buildflags.h"
 #include "brave/components/content_settings/core/browser/brave_content_settings_pref_provider.h"
 #include "brave/components/content_settings/core/browser/brave_content_settings_utils.h"
@@ -68,6 +70,13 @@ void BraveBrowsingDataRemoverDelegate::RemoveEmbedderData(
   if (remove_mask & content::BrowsingDataRemover::DATA_TYPE_CACHE)
     ClearIPFSCache();
 #endif
+  // Auto-contribute visits waiting to be saved
+  if (remove_mask & chrome_browsing_data_remover::DATA_TYPE_HISTORY) {
+    auto* rewards_service =
+        brave_rewards::RewardsServiceFactory::GetForProfile(profile_);
+    if (rewards_service)
+      rewards_service->OnBrowsingHistoryDeleted();
+  }
 #if BUILDFLAG(ENABLE_BRAVE_NEWS)
   // Brave News feed cache
   if (remove_mask & chrome_browsing_data_remover::DATA_TYPE_HISTORY) {
@@ -0,0 +1,109 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/decentralized_dns/resolution_cache.h"
+
+#include <string>
+#include <vector>
+
+#include "base/test/bind.h"
+#include "base/test/simple_test_tick_clock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace decentralized_dns {
+
+class ResolutionCacheUnitTest : public testing::Test {
+ public:
+  ResolutionCacheUnitTest() : cache_(&clock_) {}
+  ~ResolutionCacheUnitTest() override = default;
+
+  // Records the lookup result in |results_|.
+  ResolutionCache<std::string>::ResultCallback RecordResult() {
+    return base::BindLambdaForTesting(
+        [&](bool success, const std::string& result) {
+          results_.push_back(success ? result : "<failed>");
+        });
+  }
+
+  base::SimpleTestTickClock clock_;
+  ResolutionCache<std::string> cache_;
+  std::vector<std::string> results_;
+};
+
+TEST_F(ResolutionCacheUnitTest, CachesResolvedResultUntilExpiry) {
+  EXPECT_FALSE(cache_.Get("brave.eth"));
+
+  ASSERT_TRUE(cache_.AddPendingRequest("brave.eth", RecordResult()));
+  cache_.GetResolvedCallback("brave.eth").Run(true, "hash");
+  EXPECT_EQ(std::vector<std::string>({"hash"}), results_);
+
+  const auto* entry = cache_.Get("brave.eth");
+  ASSERT_TRUE(entry);
+  EXPECT_TRUE(entry->success);
+  EXPECT_EQ("hash", entry->result);
+  EXPECT_FALSE(cache_.Get("other.eth"));
+
+  clock_.Advance(kResolvedTTL - base::TimeDelta::FromSeconds(1));
+  EXPECT_TRUE(cache_.Get("brave.eth"));
+  clock_.Advance(base::TimeDelta::FromSeconds(1));
+  EXPECT_FALSE(cache_.Get("brave.eth"));
+}
+
+TEST_F(ResolutionCacheUnitTest, CachesFailureBriefly) {
+  ASSERT_TRUE(cache_.AddPendingRequest("brave.eth", RecordResult()));
+  cache_.GetResolvedCallback("brave.eth").Run(false, "");
+  EXPECT_EQ(std::vector<std::string>({"<failed>"}), results_);
+
+  const auto* entry = cache_.Get("brave.eth");
+  ASSERT_TRUE(entry);
+  EXPECT_FALSE(entry->success);
+
+  clock_.Advance(kFailedTTL);
+  EXPECT_FALSE(cache_.Get("brave.eth"));
+}
+
+TEST_F(ResolutionCacheUnitTest, CoalescesConcurrentLookups) {
+  EXPECT_TRUE(cache_.AddPendingRequest("brave.eth", RecordResult()));
+  EXPECT_FALSE(cache_.AddPendingRequest("brave.eth", RecordResult()));
+  EXPECT_TRUE(cache_.AddPendingRequest("other.eth", RecordResult()));
+
+  cache_.GetResolvedCallback("brave.eth").Run(true, "hash");
+  EXPECT_EQ(std::vector<std::string>({"hash", "hash"}), results_);
+
+  // A new lookup starts once the previous one finished.
+  EXPECT_TRUE(cache_.AddPendingRequest("brave.eth", RecordResult()));
+}
+
+TEST_F(ResolutionCacheUnitTest, Clear) {
+  ASSERT_TRUE(cache_.AddPendingRequest("brave.eth", RecordResult()));
+  cache_.GetResolvedCallback("brave.eth").Run(true, "hash");
+  ASSERT_TRUE(cache_.Get("brave.eth"));
+
+  cache_.Clear();
+  EXPECT_FALSE(cache_.Get("brave.eth"));
+}
+
+TEST_F(ResolutionCacheUnitTest, ClearFencesLookupsInFlight) {
+  ASSERT_TRUE(cache_.AddPendingRequest("brave.eth", RecordResult()));
+  auto stale_callback = cache_.GetResolvedCallback("brave.eth");
+
+  // E.g. the resolve method pref changed while the lookup was running.
+  cache_.Clear();
+  ASSERT_TRUE(cache_.AddPendingRequest("brave.eth", RecordResult()));
+  auto fresh_callback = cache_.GetResolvedCallback("brave.eth");
+
+  // The stale result still answers its own caller but isn't cached.
+  std::move(stale_callback).Run(true, "stale");
+  EXPECT_EQ(std::vector<std::string>({"stale"}), results_);
+  EXPECT_FALSE(cache_.Get("brave.eth"));
+
+  std::move(fresh_callback).Run(true, "fresh");
+  EXPECT_EQ(std::vector<std::string>({"stale", "fresh"}), results_);
+  const auto* entry = cache_.Get("brave.eth");
+  ASSERT_TRUE(entry);
+  EXPECT_EQ("fresh", entry->result);
+}
+
+}  // namespace decentralized_dns
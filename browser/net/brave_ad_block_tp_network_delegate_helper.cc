@@ -13,12 +13,16 @@
 #include "base/base64url.h"
 #include "base/feature_list.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "base/time/time.h"
 #include "brave/browser/brave_browser_process.h"
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/url_constants.h"
+#include "brave/components/brave_shields/browser/ad_block_base_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/brave_shields/common/features.h"
@@ -50,9 +54,109 @@ namespace brave {
 
 network::HostResolver* g_testing_host_resolver;
 
+namespace {
+
+// How long a resolved canonical name is reused. The host resolver doesn't
+// report record TTLs to its clients, so this stays below common CNAME TTLs.
+constexpr base::TimeDelta kCanonicalNameTTL = base::TimeDelta::FromMinutes(1);
+constexpr size_t kCanonicalNameCacheSize = 256;
+constexpr size_t kUncloakedDecisionCacheSize = 256;
+
+const char kAdBlockUncloakingCacheKey[] = "brave_ad_block_uncloaking_cache";
+
+// Bumped when tests swap the host resolver, since canonical names from a
+// previous resolver no longer apply.
+uint64_t g_host_resolver_generation = 0;
+
+// YouTube is always checked in aggressive mode.
+bool ShouldForceAggressiveBlocking(const GURL& initiator_url) {
+  return SameDomainOrHost(
+      initiator_url,
+      url::Origin::CreateFromNormalizedTuple("https", "youtube.com", 80),
+      net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+}
+
+}  // namespace
+
+// static
+AdBlockUncloakingCache* AdBlockUncloakingCache::FromBrowserContext(
+    content::BrowserContext* browser_context) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK(browser_context);
+  auto* cache = static_cast<AdBlockUncloakingCache*>(
+      browser_context->GetUserData(kAdBlockUncloakingCacheKey));
+  if (!cache) {
+    auto new_cache = std::make_unique<AdBlockUncloakingCache>();
+    cache = new_cache.get();
+    browser_context->SetUserData(kAdBlockUncloakingCacheKey,
+                                 std::move(new_cache));
+  }
+  return cache;
+}
+
+AdBlockUncloakingCache::AdBlockUncloakingCache()
+    : canonical_names_(kCanonicalNameCacheSize),
+      resolver_generation_(g_host_resolver_generation),
+      decisions_(kUncloakedDecisionCacheSize),
+      engine_generation_(
+          brave_shields::AdBlockBaseService::GetEngineGeneration()) {}
+
+AdBlockUncloakingCache::~AdBlockUncloakingCache() = default;
+
+absl::optional<std::string> AdBlockUncloakingCache::GetCanonicalName(
+    const std::string& host) {
+  MaybeInvalidate();
+  auto it = canonical_names_.Get(host);
+  if (it == canonical_names_.end())
+    return absl::nullopt;
+  if (it->second.expiry <= base::TimeTicks::Now()) {
+    canonical_names_.Erase(it);
+    return absl::nullopt;
+  }
+  return it->second.cname;
+}
+
+void AdBlockUncloakingCache::PutCanonicalName(const std::string& host,
+                                              const std::string& cname) {
+  MaybeInvalidate();
+  canonical_names_.Put(host,
+                       {cname, base::TimeTicks::Now() + kCanonicalNameTTL});
+}
+
+const AdBlockUncloakingCache::Decision* AdBlockUncloakingCache::GetDecision(
+    const std::string& key) {
+  MaybeInvalidate();
+  auto it = decisions_.Get(key);
+  return it == decisions_.end() ? nullptr : &it->second;
+}
+
+void AdBlockUncloakingCache::PutDecision(const std::string& key,
+                                         uint64_t engine_generation,
+                                         const Decision& decision) {
+  MaybeInvalidate();
+  if (engine_generation != engine_generation_)
+    return;
+  decisions_.Put(key, decision);
+}
+
+void AdBlockUncloakingCache::MaybeInvalidate() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (resolver_generation_ != g_host_resolver_generation) {
+    canonical_names_.Clear();
+    resolver_generation_ = g_host_resolver_generation;
+  }
+  const uint64_t engine_generation =
+      brave_shields::AdBlockBaseService::GetEngineGeneration();
+  if (engine_generation_ != engine_generation) {
+    decisions_.Clear();
+    engine_generation_ = engine_generation;
+  }
+}
+
 void SetAdblockCnameHostResolverForTesting(
     network::HostResolver* host_resolver) {
   g_testing_host_resolver = host_resolver;
+  ++g_host_resolver_generation;
 }
 
 // These strings are duplicated in subresource_redirect_util.cc and
@@ -64,14 +168,6 @@ void SetRedirectUrlAllowedDomainForTesting(std::string domain) {
   pcdn_domains[0] = domain;
 }
 
-// Used to keep track of state between a primary adblock engine query and one
-// after CNAME uncloaking the request.
-struct EngineFlags {
-  bool did_match_rule = false;
-  bool did_match_exception = false;
-  bool did_match_important = false;
-};
-
 void UseCnameResult(scoped_refptr<base::SequencedTaskRunner> task_runner,
                     const ResponseCallback& next_callback,
                     std::shared_ptr<BraveRequestInfo> ctx,
@@ -83,6 +179,8 @@ class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
   mojo::Receiver<network::mojom::ResolveHostClient> receiver_{this};
   base::OnceCallback<void(absl::optional<std::string>)> cb_;
   base::TimeTicks start_time_;
+  std::string host_;
+  base::WeakPtr<AdBlockUncloakingCache> cache_;
 
  public:
   AdblockCnameResolveHostClient(
@@ -93,6 +191,10 @@ class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
     DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
     cb_ = base::BindOnce(&UseCnameResult, task_runner, std::move(next_callback),
                          ctx, previous_result);
+    host_ = ctx->request_url.host();
+    cache_ =
+        AdBlockUncloakingCache::FromBrowserContext(ctx->browser_context)
+            ->AsWeakPtr();
 
     const auto network_isolation_key = ctx->network_isolation_key;
 
@@ -149,8 +251,10 @@ class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
                         base::TimeTicks::Now() - start_time_);
     if (result == net::OK && resolved_addresses) {
       DCHECK(resolved_addresses.has_value() && !resolved_addresses->empty());
-      std::move(cb_).Run(
-          absl::optional<std::string>(resolved_addresses->GetCanonicalName()));
+      const std::string& cname = resolved_addresses->GetCanonicalName();
+      if (cache_)
+        cache_->PutCanonicalName(host_, cname);
+      std::move(cb_).Run(absl::optional<std::string>(cname));
     } else {
       std::move(cb_).Run(absl::nullopt);
     }
@@ -177,6 +281,11 @@ bool IsValidPrivateCDNDomain(GURL url) {
   return false;
 }
 
+// Sets the blocking decision and any adblock redirect on `ctx` from an engine
+// query result.
+void ApplyEngineResult(std::shared_ptr<BraveRequestInfo> ctx,
+                       EngineFlags previous_result);
+
 // If `canonical_url` is specified, this will only check if the CNAME-uncloaked
 // response should be blocked. Otherwise, it will run the check for the
 // original request URL.
@@ -196,10 +305,7 @@ EngineFlags ShouldBlockRequestOnTaskRunner(
     url_to_check = ctx->request_url;
   }
 
-  bool force_aggressive = SameDomainOrHost(
-      ctx->initiator_url,
-      url::Origin::CreateFromNormalizedTuple("https", "youtube.com", 80),
-      net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  bool force_aggressive = ShouldForceAggressiveBlocking(ctx->initiator_url);
 
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.Adblock.ShouldBlockRequest");
   g_brave_browser_process->ad_block_service()->ShouldStartRequest(
@@ -208,6 +314,28 @@ EngineFlags ShouldBlockRequestOnTaskRunner(
       &previous_result.did_match_rule, &previous_result.did_match_exception,
       &previous_result.did_match_important, &ctx->adblock_replacement_url);
 
+  ApplyEngineResult(ctx, previous_result);
+  return previous_result;
+}
+
+// Returns a key covering every input of the engine query made by
+// ShouldBlockRequestOnTaskRunner for `canonical_url`.
+std::string GetUncloakedDecisionKey(std::shared_ptr<BraveRequestInfo> ctx,
+                                    EngineFlags previous_result,
+                                    const GURL& canonical_url) {
+  const bool aggressive = ctx->aggressive_blocking ||
+                          ShouldForceAggressiveBlocking(ctx->initiator_url);
+  return base::StrCat(
+      {canonical_url.spec(), " ", ctx->initiator_url.host(), " ",
+       base::NumberToString(static_cast<int>(ctx->resource_type)), " ",
+       aggressive ? "1" : "0", previous_result.did_match_rule ? "1" : "0",
+       previous_result.did_match_exception ? "1" : "0",
+       previous_result.did_match_important ? "1" : "0", " ",
+       ctx->adblock_replacement_url});
+}
+
+void ApplyEngineResult(std::shared_ptr<BraveRequestInfo> ctx,
+                       EngineFlags previous_result) {
   if (previous_result.did_match_important ||
       (previous_result.did_match_rule &&
        !previous_result.did_match_exception)) {
@@ -234,8 +362,6 @@ EngineFlags ShouldBlockRequestOnTaskRunner(
       ctx->blocked_by = kNotBlocked;
     }
   }
-
-  return previous_result;
 }
 
 void OnShouldBlockRequestResult(
@@ -249,6 +375,13 @@ void OnShouldBlockRequestResult(
     brave_shields::BraveShieldsWebContentsObserver::DispatchBlockedEvent(
         ctx->request_url, ctx->frame_tree_node_id, brave_shields::kAds);
   } else if (then_check_uncloaked) {
+    absl::optional<std::string> cname =
+        AdBlockUncloakingCache::FromBrowserContext(ctx->browser_context)
+            ->GetCanonicalName(ctx->request_url.host());
+    if (cname) {
+      UseCnameResult(task_runner, next_callback, ctx, result, cname);
+      return;
+    }
     // This will be deleted by `AdblockCnameResolveHostClient::OnComplete`.
     new AdblockCnameResolveHostClient(std::move(next_callback), task_runner,
                                       ctx, result);
@@ -257,6 +390,21 @@ void OnShouldBlockRequestResult(
   next_callback.Run();
 }
 
+void OnUncloakedShouldBlockRequestResult(
+    base::WeakPtr<AdBlockUncloakingCache> cache,
+    const std::string& decision_key,
+    uint64_t engine_generation,
+    scoped_refptr<base::SequencedTaskRunner> task_runner,
+    const ResponseCallback& next_callback,
+    std::shared_ptr<BraveRequestInfo> ctx,
+    EngineFlags result) {
+  if (cache) {
+    cache->PutDecision(decision_key, engine_generation,
+                       {result, ctx->adblock_replacement_url});
+  }
+  OnShouldBlockRequestResult(false, task_runner, next_callback, ctx, result);
+}
+
 void UseCnameResult(scoped_refptr<base::SequencedTaskRunner> task_runner,
                     const ResponseCallback& next_callback,
                     std::shared_ptr<BraveRequestInfo> ctx,
@@ -271,12 +419,28 @@ void UseCnameResult(scoped_refptr<base::SequencedTaskRunner> task_runner,
                          url::Component(0, static_cast<int>(cname->length())));
     const GURL canonical_url = ctx->request_url.ReplaceComponents(replacements);
 
+    // Repeated requests to the same cloaked URL skip the second engine pass.
+    const std::string decision_key =
+        GetUncloakedDecisionKey(ctx, previous_result, canonical_url);
+    auto* cache =
+        AdBlockUncloakingCache::FromBrowserContext(ctx->browser_context);
+    if (const auto* decision = cache->GetDecision(decision_key)) {
+      const EngineFlags result = decision->result;
+      ctx->adblock_replacement_url = decision->adblock_replacement_url;
+      ApplyEngineResult(ctx, result);
+      OnShouldBlockRequestResult(false, task_runner, next_callback, ctx,
+                                 result);
+      return;
+    }
+
     task_runner->PostTaskAndReplyWithResult(
         FROM_HERE,
         base::BindOnce(&ShouldBlockRequestOnTaskRunner, ctx, previous_result,
                        absl::make_optional<GURL>(canonical_url)),
-        base::BindOnce(&OnShouldBlockRequestResult, false, task_runner,
-                       next_callback, ctx));
+        base::BindOnce(&OnUncloakedShouldBlockRequestResult,
+                       cache->AsWeakPtr(), decision_key,
+                       brave_shields::AdBlockBaseService::GetEngineGeneration(),
+                       task_runner, next_callback, ctx));
   } else {
     next_callback.Run();
   }
@@ -364,39 +528,47 @@ void OnBeforeURLRequestAdBlockTP(const ResponseCallback& next_callback,
                      task_runner, next_callback, ctx));
 }
 
-int OnBeforeURLRequest_AdBlockTPPreWork(const ResponseCallback& next_callback,
-                                        std::shared_ptr<BraveRequestInfo> ctx) {
+bool ShouldRunOnBeforeURLRequest_AdBlockTPPreWork(
+    const BraveRequestInfo& ctx) {
   // If the following info isn't available, then proper content settings can't
   // be looked up, so do nothing.
-  if (ctx->request_url.is_empty() ||
-      ctx->initiator_url.is_empty() || !ctx->initiator_url.has_host() ||
-      !ctx->allow_brave_shields || ctx->allow_ads ||
-      ctx->resource_type == BraveRequestInfo::kInvalidResourceType) {
-    return net::OK;
+  if (ctx.request_url.is_empty() || ctx.initiator_url.is_empty() ||
+      !ctx.initiator_url.has_host() || !ctx.allow_brave_shields ||
+      ctx.allow_ads ||
+      ctx.resource_type == BraveRequestInfo::kInvalidResourceType) {
+    return false;
   }
 
   // Filter out unnecessary request schemes, to avoid passing large `data:`
   // URLs to the blocking engine.
-  if (!ctx->request_url.SchemeIsHTTPOrHTTPS() &&
-      !ctx->request_url.SchemeIsWSOrWSS()) {
-    return net::OK;
+  if (!ctx.request_url.SchemeIsHTTPOrHTTPS() &&
+      !ctx.request_url.SchemeIsWSOrWSS()) {
+    return false;
   }
 
   // Also, until a better solution is available, we explicitly allow any
   // request from an extension.
-  if (ctx->initiator_url.SchemeIs(kChromeExtensionScheme) &&
+  if (ctx.initiator_url.SchemeIs(kChromeExtensionScheme) &&
       !base::FeatureList::IsEnabled(
           ::brave_shields::features::kBraveExtensionNetworkBlocking)) {
-    return net::OK;
+    return false;
   }
 
   // Requests for main frames are handled by DomainBlockNavigationThrottle,
   // which can display a custom interstitial with an option to proceed if a
   // block is made. We don't need to check these twice.
-  if (ctx->resource_type == blink::mojom::ResourceType::kMainFrame) {
-    return net::OK;
+  if (ctx.resource_type == blink::mojom::ResourceType::kMainFrame) {
+    return false;
   }
 
+  return true;
+}
+
+int OnBeforeURLRequest_AdBlockTPPreWork(const ResponseCallback& next_callback,
+                                        std::shared_ptr<BraveRequestInfo> ctx) {
+  if (!ShouldRunOnBeforeURLRequest_AdBlockTPPreWork(*ctx))
+    return net::OK;
+
   OnBeforeURLRequestAdBlockTP(next_callback, ctx);
 
   return net::ERR_IO_PENDING;
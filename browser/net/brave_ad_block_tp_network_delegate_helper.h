@@ -9,7 +9,16 @@
 #include <memory>
 #include <string>
 
+#include "base/containers/mru_cache.h"
+#include "base/memory/weak_ptr.h"
+#include "base/supports_user_data.h"
+#include "base/time/time.h"
 #include "brave/browser/net/url_context.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace content {
+class BrowserContext;
+}  // namespace content
 
 namespace network {
 class HostResolver;
@@ -17,6 +26,68 @@ class HostResolver;
 
 namespace brave {
 
+// Used to keep track of state between a primary adblock engine query and one
+// after CNAME uncloaking the request.
+struct EngineFlags {
+  bool did_match_rule = false;
+  bool did_match_exception = false;
+  bool did_match_important = false;
+};
+
+// Resolved canonical names and engine results for CNAME-uncloaked requests.
+// Kept per BrowserContext so nothing learned in one profile is reused by
+// another, e.g. a private or Tor window. Must be used on the UI thread.
+class AdBlockUncloakingCache : public base::SupportsUserData::Data {
+ public:
+  struct Decision {
+    EngineFlags result;
+    std::string adblock_replacement_url;
+  };
+
+  static AdBlockUncloakingCache* FromBrowserContext(
+      content::BrowserContext* browser_context);
+
+  AdBlockUncloakingCache();
+  ~AdBlockUncloakingCache() override;
+
+  AdBlockUncloakingCache(const AdBlockUncloakingCache&) = delete;
+  AdBlockUncloakingCache& operator=(const AdBlockUncloakingCache&) = delete;
+
+  // Returns the canonical name of |host| if it was resolved recently.
+  absl::optional<std::string> GetCanonicalName(const std::string& host);
+  void PutCanonicalName(const std::string& host, const std::string& cname);
+
+  // Returns the decision stored under |key| for the current engine.
+  const Decision* GetDecision(const std::string& key);
+  // Drops |decision| if the engine changed since |engine_generation|.
+  void PutDecision(const std::string& key,
+                   uint64_t engine_generation,
+                   const Decision& decision);
+
+  base::WeakPtr<AdBlockUncloakingCache> AsWeakPtr() {
+    return weak_factory_.GetWeakPtr();
+  }
+
+ private:
+  struct CanonicalNameEntry {
+    std::string cname;
+    base::TimeTicks expiry;
+  };
+
+  // Clears entries computed by another resolver or engine.
+  void MaybeInvalidate();
+
+  base::HashingMRUCache<std::string, CanonicalNameEntry> canonical_names_;
+  uint64_t resolver_generation_;
+  base::HashingMRUCache<std::string, Decision> decisions_;
+  uint64_t engine_generation_;
+  base::WeakPtrFactory<AdBlockUncloakingCache> weak_factory_{this};
+};
+
+// Returns false if OnBeforeURLRequest_AdBlockTPPreWork() won't query the
+// ad-block engines for |ctx|.
+bool ShouldRunOnBeforeURLRequest_AdBlockTPPreWork(const BraveRequestInfo& ctx);
+
 int OnBeforeURLRequest_AdBlockTPPreWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx);
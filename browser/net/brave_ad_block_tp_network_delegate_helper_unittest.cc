@@ -14,11 +14,13 @@
 #include "brave/browser/brave_browser_process.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
+#include "brave/components/brave_shields/browser/ad_block_base_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_download_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service_manager.h"
 #include "brave/test/base/testing_brave_browser_process.h"
 #include "chrome/common/chrome_paths.h"
+#include "chrome/test/base/testing_profile.h"
 #include "content/public/test/browser_task_environment.h"
 #include "net/base/net_errors.h"
 #include "net/dns/mock_host_resolver.h"
@@ -89,7 +91,8 @@ class BraveAdBlockTPNetworkDelegateHelperTest : public testing::Test {
         std::make_unique<brave_shields::AdBlockSubscriptionServiceManager>(
             brave_component_updater_delegate_.get(),
             base::BindOnce(&FakeAdBlockSubscriptionDownloadManagerGetter),
-            user_data_dir));
+            user_data_dir),
+        user_data_dir);
 
     TestingBraveBrowserProcess::GetGlobal()->SetAdBlockService(
         std::move(adblock_service));
@@ -320,3 +323,69 @@ TEST_F(BraveAdBlockTPNetworkDelegateHelperTest, RedirectUrlNoHttps) {
   EXPECT_TRUE(request_info->new_url_spec.empty());
   EXPECT_EQ(request_info->blocked_by, brave::kNotBlocked);
 }
+
+class AdBlockUncloakingCacheTest : public testing::Test {
+ protected:
+  content::BrowserTaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  TestingProfile profile_;
+};
+
+TEST_F(AdBlockUncloakingCacheTest, CanonicalNameHitMissAndExpiry) {
+  auto* cache = brave::AdBlockUncloakingCache::FromBrowserContext(&profile_);
+  EXPECT_EQ(cache,
+            brave::AdBlockUncloakingCache::FromBrowserContext(&profile_));
+
+  EXPECT_FALSE(cache->GetCanonicalName("cloaked.brave.com"));
+  cache->PutCanonicalName("cloaked.brave.com", "tracker.example");
+  EXPECT_EQ("tracker.example",
+            cache->GetCanonicalName("cloaked.brave.com").value_or(""));
+  EXPECT_FALSE(cache->GetCanonicalName("other.brave.com"));
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(59));
+  EXPECT_TRUE(cache->GetCanonicalName("cloaked.brave.com"));
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_FALSE(cache->GetCanonicalName("cloaked.brave.com"));
+}
+
+TEST_F(AdBlockUncloakingCacheTest, NotSharedAcrossProfiles) {
+  brave::AdBlockUncloakingCache::FromBrowserContext(&profile_)
+      ->PutCanonicalName("cloaked.brave.com", "tracker.example");
+  brave::AdBlockUncloakingCache::FromBrowserContext(&profile_)->PutDecision(
+      "key", brave_shields::AdBlockBaseService::GetEngineGeneration(), {});
+
+  auto* otr_cache = brave::AdBlockUncloakingCache::FromBrowserContext(
+      profile_.GetPrimaryOTRProfile(/*create_if_needed=*/true));
+  EXPECT_FALSE(otr_cache->GetCanonicalName("cloaked.brave.com"));
+  EXPECT_FALSE(otr_cache->GetDecision("key"));
+}
+
+TEST_F(AdBlockUncloakingCacheTest, DecisionsDroppedWhenEngineChanges) {
+  auto* cache = brave::AdBlockUncloakingCache::FromBrowserContext(&profile_);
+  brave::AdBlockUncloakingCache::Decision decision;
+  decision.result.did_match_rule = true;
+  decision.adblock_replacement_url = "data:text/plain,";
+
+  const uint64_t generation =
+      brave_shields::AdBlockBaseService::GetEngineGeneration();
+  EXPECT_FALSE(cache->GetDecision("key"));
+  cache->PutDecision("key", generation, decision);
+  const auto* cached = cache->GetDecision("key");
+  ASSERT_TRUE(cached);
+  EXPECT_TRUE(cached->result.did_match_rule);
+  EXPECT_EQ("data:text/plain,", cached->adblock_replacement_url);
+
+  brave_shields::AdBlockBaseService::OnEngineChanged();
+  EXPECT_FALSE(cache->GetDecision("key"));
+
+  // A query that started against the previous engine isn't cached.
+  cache->PutDecision("key", generation, decision);
+  EXPECT_FALSE(cache->GetDecision("key"));
+}
+
+TEST_F(AdBlockUncloakingCacheTest, CanonicalNamesDroppedWithResolver) {
+  auto* cache = brave::AdBlockUncloakingCache::FromBrowserContext(&profile_);
+  cache->PutCanonicalName("cloaked.brave.com", "tracker.example");
+  brave::SetAdblockCnameHostResolverForTesting(nullptr);
+  EXPECT_FALSE(cache->GetCanonicalName("cloaked.brave.com"));
+}
@@ -44,6 +44,14 @@ bool RewriteBugReportingURL(const GURL& request_url, GURL* new_url) {
 
 }  // namespace
 
+bool ShouldRunOnBeforeURLRequest_CommonStaticRedirectWork(
+    const BraveRequestInfo& ctx) {
+  GURL new_url;
+  OnBeforeURLRequest_CommonStaticRedirectWorkForGURL(ctx.request_url,
+                                                     &new_url);
+  return !new_url.is_empty();
+}
+
 int OnBeforeURLRequest_CommonStaticRedirectWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
@@ -14,6 +14,11 @@ class GURL;
 
 namespace brave {
 
+// Returns false if OnBeforeURLRequest_CommonStaticRedirectWork() won't
+// redirect |ctx|.
+bool ShouldRunOnBeforeURLRequest_CommonStaticRedirectWork(
+    const BraveRequestInfo& ctx);
+
 int OnBeforeURLRequest_CommonStaticRedirectWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx);
@@ -46,18 +46,23 @@ void OnBeforeURLRequest_HttpsePostFileWork(
   next_callback.Run();
 }
 
+bool ShouldRunOnBeforeURLRequest_HttpsePreFileWork(
+    const BraveRequestInfo& ctx) {
+  // Don't try to overwrite an already set URL by another delegate (adblock/tp)
+  if (!ctx.new_url_spec.empty()) {
+    return false;
+  }
+
+  return !ctx.tab_origin.is_empty() && !ctx.allow_http_upgradable_resource &&
+         ctx.allow_brave_shields;
+}
+
 int OnBeforeURLRequest_HttpsePreFileWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
 
-  // Don't try to overwrite an already set URL by another delegate (adblock/tp)
-  if (!ctx->new_url_spec.empty()) {
-    return net::OK;
-  }
-
-  if (ctx->tab_origin.is_empty() || ctx->allow_http_upgradable_resource ||
-      !ctx->allow_brave_shields) {
+  if (!ShouldRunOnBeforeURLRequest_HttpsePreFileWork(*ctx)) {
     return net::OK;
   }
 
@@ -9,6 +9,10 @@
 
 namespace brave {
 
+// Returns false if OnBeforeURLRequest_HttpsePreFileWork() won't look for an
+// HTTPS upgrade of |ctx|.
+bool ShouldRunOnBeforeURLRequest_HttpsePreFileWork(const BraveRequestInfo& ctx);
+
 int OnBeforeURLRequest_HttpsePreFileWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx);
@@ -11,6 +11,7 @@
 #include "base/containers/contains.h"
 #include "base/feature_list.h"
 #include "base/task/post_task.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/net/brave_ad_block_csp_network_delegate_helper.h"
 #include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
 #include "brave/browser/net/brave_common_static_redirect_network_delegate_helper.h"
@@ -65,69 +66,92 @@ BraveRequestHandler::BraveRequestHandler() {
 BraveRequestHandler::~BraveRequestHandler() = default;
 
 void BraveRequestHandler::SetupCallbacks() {
-  brave::OnBeforeURLRequestCallback callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_SiteHacksWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback = base::BindRepeating(brave::OnBeforeURLRequest_AdBlockTPPreWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback = base::BindRepeating(brave::OnBeforeURLRequest_HttpsePreFileWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_CommonStaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  before_url_request_callbacks_.push_back(
+      {"SiteHacks",
+       base::BindRepeating(brave::OnBeforeURLRequest_SiteHacksWork),
+       brave::ShouldRunOnBeforeURLRequest_SiteHacksWork});
+
+  before_url_request_callbacks_.push_back(
+      {"AdBlockTP",
+       base::BindRepeating(brave::OnBeforeURLRequest_AdBlockTPPreWork),
+       brave::ShouldRunOnBeforeURLRequest_AdBlockTPPreWork});
+
+  before_url_request_callbacks_.push_back(
+      {"HTTPSE",
+       base::BindRepeating(brave::OnBeforeURLRequest_HttpsePreFileWork),
+       brave::ShouldRunOnBeforeURLRequest_HttpsePreFileWork});
+
+  before_url_request_callbacks_.push_back(
+      {"CommonStaticRedirect",
+       base::BindRepeating(brave::OnBeforeURLRequest_CommonStaticRedirectWork),
+       brave::ShouldRunOnBeforeURLRequest_CommonStaticRedirectWork});
 
 #if BUILDFLAG(DECENTRALIZED_DNS_ENABLED)
-  callback = base::BindRepeating(
-      decentralized_dns::OnBeforeURLRequest_DecentralizedDnsPreRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  before_url_request_callbacks_.push_back(
+      {"DecentralizedDns",
+       base::BindRepeating(
+           decentralized_dns::
+               OnBeforeURLRequest_DecentralizedDnsPreRedirectWork),
+       decentralized_dns::
+           ShouldRunOnBeforeURLRequest_DecentralizedDnsPreRedirectWork});
 #endif
 
-  callback = base::BindRepeating(brave_rewards::OnBeforeURLRequest);
-  before_url_request_callbacks_.push_back(callback);
+  before_url_request_callbacks_.push_back(
+      {"Rewards", base::BindRepeating(brave_rewards::OnBeforeURLRequest),
+       brave_rewards::ShouldRunOnBeforeURLRequest});
 
 #if BUILDFLAG(ENABLE_IPFS)
   if (base::FeatureList::IsEnabled(ipfs::features::kIpfsFeature)) {
-    callback = base::BindRepeating(ipfs::OnBeforeURLRequest_IPFSRedirectWork);
-    before_url_request_callbacks_.push_back(callback);
-    brave::OnHeadersReceivedCallback ipfs_headers_received_callback =
-        base::BindRepeating(ipfs::OnHeadersReceived_IPFSRedirectWork);
-    headers_received_callbacks_.push_back(ipfs_headers_received_callback);
+    before_url_request_callbacks_.push_back(
+        {"IPFS",
+         base::BindRepeating(ipfs::OnBeforeURLRequest_IPFSRedirectWork),
+         ipfs::ShouldRunOnBeforeURLRequest_IPFSRedirectWork});
+    headers_received_callbacks_.push_back(
+        {"IPFS",
+         base::BindRepeating(ipfs::OnHeadersReceived_IPFSRedirectWork)});
   }
 #endif
 
-  brave::OnBeforeStartTransactionCallback start_transaction_callback =
-      base::BindRepeating(brave::OnBeforeStartTransaction_SiteHacksWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+  before_start_transaction_callbacks_.push_back(
+      {"SiteHacks",
+       base::BindRepeating(brave::OnBeforeStartTransaction_SiteHacksWork)});
 
-  start_transaction_callback = base::BindRepeating(
-      brave::OnBeforeStartTransaction_GlobalPrivacyControlWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+  before_start_transaction_callbacks_.push_back(
+      {"GlobalPrivacyControl",
+       base::BindRepeating(
+           brave::OnBeforeStartTransaction_GlobalPrivacyControlWork)});
 
-  start_transaction_callback =
-      base::BindRepeating(brave::OnBeforeStartTransaction_BraveServiceKey);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+  before_start_transaction_callbacks_.push_back(
+      {"ServiceKey",
+       base::BindRepeating(brave::OnBeforeStartTransaction_BraveServiceKey)});
 
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
-  start_transaction_callback =
-      base::BindRepeating(brave::OnBeforeStartTransaction_ReferralsWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+  before_start_transaction_callbacks_.push_back(
+      {"Referrals",
+       base::BindRepeating(brave::OnBeforeStartTransaction_ReferralsWork)});
 #endif
 
 #if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
-  brave::OnHeadersReceivedCallback headers_received_callback =
-      base::BindRepeating(webtorrent::OnHeadersReceived_TorrentRedirectWork);
-  headers_received_callbacks_.push_back(headers_received_callback);
+  headers_received_callbacks_.push_back(
+      {"Torrent",
+       base::BindRepeating(webtorrent::OnHeadersReceived_TorrentRedirectWork)});
 #endif
 
   if (base::FeatureList::IsEnabled(
           ::brave_shields::features::kBraveAdblockCspRules)) {
-    brave::OnHeadersReceivedCallback headers_received_callback2 =
-        base::BindRepeating(brave::OnHeadersReceived_AdBlockCspWork);
-    headers_received_callbacks_.push_back(headers_received_callback2);
+    headers_received_callbacks_.push_back(
+        {"AdBlockCsp",
+         base::BindRepeating(brave::OnHeadersReceived_AdBlockCspWork)});
+  }
+}
+
+bool BraveRequestHandler::IsNoopBeforeURLRequest(
+    const brave::BraveRequestInfo& ctx) const {
+  for (const auto& helper : before_url_request_callbacks_) {
+    if (helper.should_run(ctx))
+      return false;
   }
+  return true;
 }
 
 bool BraveRequestHandler::IsRequestIdentifierValid(
@@ -139,14 +163,13 @@ int BraveRequestHandler::OnBeforeURLRequest(
     std::shared_ptr<brave::BraveRequestInfo> ctx,
     net::CompletionOnceCallback callback,
     GURL* new_url) {
-  if (before_url_request_callbacks_.empty() || IsInternalScheme(ctx)) {
+  if (before_url_request_callbacks_.empty() || IsInternalScheme(ctx) ||
+      IsNoopBeforeURLRequest(*ctx)) {
     return net::OK;
   }
   ctx->new_url = new_url;
   ctx->event_type = brave::kOnBeforeRequest;
-  callbacks_[ctx->request_identifier] = std::move(callback);
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartCallbackChain(ctx, std::move(callback));
 }
 
 int BraveRequestHandler::OnBeforeStartTransaction(
@@ -158,9 +181,7 @@ int BraveRequestHandler::OnBeforeStartTransaction(
   }
   ctx->event_type = brave::kOnBeforeStartTransaction;
   ctx->headers = headers;
-  callbacks_[ctx->request_identifier] = std::move(callback);
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartCallbackChain(ctx, std::move(callback));
 }
 
 int BraveRequestHandler::OnHeadersReceived(
@@ -181,14 +202,12 @@ int BraveRequestHandler::OnHeadersReceived(
     return net::OK;
   }
 
-  callbacks_[ctx->request_identifier] = std::move(callback);
   ctx->event_type = brave::kOnHeadersReceived;
   ctx->original_response_headers = original_response_headers;
   ctx->override_response_headers = override_response_headers;
   ctx->allowed_unsafe_redirect_url = allowed_unsafe_redirect_url;
 
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartCallbackChain(ctx, std::move(callback));
 }
 
 void BraveRequestHandler::OnURLRequestDestroyed(
@@ -209,30 +228,51 @@ void BraveRequestHandler::RunCallbackForRequestIdentifier(
                  base::BindOnce(std::move(it->second), rv));
 }
 
+int BraveRequestHandler::StartCallbackChain(
+    std::shared_ptr<brave::BraveRequestInfo> ctx,
+    net::CompletionOnceCallback callback) {
+  TRACE_EVENT1("net", "BraveRequestHandler::StartCallbackChain", "event_type",
+               static_cast<int>(ctx->event_type));
+  callbacks_[ctx->request_identifier] = std::move(callback);
+
+  int rv = RunCallbackChain(ctx);
+  if (rv == net::OK || rv == net::ERR_BLOCKED_BY_CLIENT) {
+    // Every helper completed synchronously. Callers handle both results
+    // inline, so skip the round trip through the UI task queue.
+    callbacks_.erase(ctx->request_identifier);
+    return rv;
+  }
+
+  if (rv != net::ERR_IO_PENDING) {
+    RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
+  }
+  return net::ERR_IO_PENDING;
+}
+
 // TODO(iefremov): Merge all callback containers into one and run only one loop
 // instead of many (issues/5574).
-void BraveRequestHandler::RunNextCallback(
+int BraveRequestHandler::RunCallbackChain(
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
-  if (!base::Contains(callbacks_, ctx->request_identifier)) {
-    return;
-  }
-
   // Continue processing callbacks until we hit one that returns PENDING
   int rv = net::OK;
 
   if (ctx->event_type == brave::kOnBeforeRequest) {
     while (before_url_request_callbacks_.size() !=
            ctx->next_url_request_index) {
-      brave::OnBeforeURLRequestCallback callback =
+      const auto& helper =
           before_url_request_callbacks_[ctx->next_url_request_index++];
       brave::ResponseCallback next_callback =
           base::BindRepeating(&BraveRequestHandler::RunNextCallback,
                               weak_factory_.GetWeakPtr(), ctx);
-      rv = callback.Run(next_callback, ctx);
+      {
+        TRACE_EVENT1("net", "BraveRequestHandler::OnBeforeURLRequest",
+                     "helper", helper.name);
+        rv = helper.callback.Run(next_callback, ctx);
+      }
       if (rv == net::ERR_IO_PENDING) {
-        return;
+        return rv;
       }
       if (rv != net::OK) {
         break;
@@ -241,14 +281,18 @@ void BraveRequestHandler::RunNextCallback(
   } else if (ctx->event_type == brave::kOnBeforeStartTransaction) {
     while (before_start_transaction_callbacks_.size() !=
            ctx->next_url_request_index) {
-      brave::OnBeforeStartTransactionCallback callback =
+      const auto& helper =
           before_start_transaction_callbacks_[ctx->next_url_request_index++];
       brave::ResponseCallback next_callback =
           base::BindRepeating(&BraveRequestHandler::RunNextCallback,
                               weak_factory_.GetWeakPtr(), ctx);
-      rv = callback.Run(ctx->headers, next_callback, ctx);
+      {
+        TRACE_EVENT1("net", "BraveRequestHandler::OnBeforeStartTransaction",
+                     "helper", helper.name);
+        rv = helper.callback.Run(ctx->headers, next_callback, ctx);
+      }
       if (rv == net::ERR_IO_PENDING) {
-        return;
+        return rv;
       }
       if (rv != net::OK) {
         break;
@@ -256,16 +300,21 @@ void BraveRequestHandler::RunNextCallback(
     }
   } else if (ctx->event_type == brave::kOnHeadersReceived) {
     while (headers_received_callbacks_.size() != ctx->next_url_request_index) {
-      brave::OnHeadersReceivedCallback callback =
+      const auto& helper =
           headers_received_callbacks_[ctx->next_url_request_index++];
       brave::ResponseCallback next_callback =
           base::BindRepeating(&BraveRequestHandler::RunNextCallback,
                               weak_factory_.GetWeakPtr(), ctx);
-      rv = callback.Run(ctx->original_response_headers,
-                        ctx->override_response_headers,
-                        ctx->allowed_unsafe_redirect_url, next_callback, ctx);
+      {
+        TRACE_EVENT1("net", "BraveRequestHandler::OnHeadersReceived", "helper",
+                     helper.name);
+        rv = helper.callback.Run(ctx->original_response_headers,
+                                 ctx->override_response_headers,
+                                 ctx->allowed_unsafe_redirect_url,
+                                 next_callback, ctx);
+      }
       if (rv == net::ERR_IO_PENDING) {
-        return;
+        return rv;
       }
       if (rv != net::OK) {
         break;
@@ -274,8 +323,7 @@ void BraveRequestHandler::RunNextCallback(
   }
 
   if (rv != net::OK) {
-    RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
-    return;
+    return rv;
   }
 
   if (ctx->event_type == brave::kOnBeforeRequest) {
@@ -286,10 +334,23 @@ void BraveRequestHandler::RunNextCallback(
     }
 
     if (ctx->ShouldBlockRequest()) {
-      RunCallbackForRequestIdentifier(ctx->request_identifier,
-                                      net::ERR_BLOCKED_BY_CLIENT);
-      return;
+      return net::ERR_BLOCKED_BY_CLIENT;
     }
   }
+  return rv;
+}
+
+void BraveRequestHandler::RunNextCallback(
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  if (!base::Contains(callbacks_, ctx->request_identifier)) {
+    return;
+  }
+
+  int rv = RunCallbackChain(ctx);
+  if (rv == net::ERR_IO_PENDING) {
+    return;
+  }
   RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
 }
@@ -24,6 +24,10 @@ class BraveRequestHandler {
   BraveRequestHandler();
   ~BraveRequestHandler();
 
+  // Returns true if none of the registered OnBeforeURLRequest helpers would
+  // act on |ctx|, as reported by their ShouldRun predicates.
+  bool IsNoopBeforeURLRequest(const brave::BraveRequestInfo& ctx) const;
+
   bool IsRequestIdentifierValid(uint64_t request_identifier);
 
   int OnBeforeURLRequest(std::shared_ptr<brave::BraveRequestInfo> ctx,
@@ -44,13 +48,37 @@ class BraveRequestHandler {
   void RunCallbackForRequestIdentifier(uint64_t request_identifier, int rv);
 
  private:
+  // A network delegate helper along with the name it is traced under.
+  template <typename Callback>
+  struct Helper {
+    const char* name;
+    Callback callback;
+  };
+
+  // An OnBeforeURLRequest helper, which also reports up front whether it has
+  // anything to do for a request.
+  struct BeforeURLRequestHelper {
+    const char* name;
+    brave::OnBeforeURLRequestCallback callback;
+    bool (*should_run)(const brave::BraveRequestInfo& ctx);
+  };
+
   void SetupCallbacks();
+  // Stores |callback| for |ctx| and runs the helper chain. Returns the result
+  // directly when every helper completes synchronously, otherwise returns
+  // net::ERR_IO_PENDING and reports the result through |callback| later.
+  int StartCallbackChain(std::shared_ptr<brave::BraveRequestInfo> ctx,
+                         net::CompletionOnceCallback callback);
+  // Runs the remaining helpers for |ctx->event_type|. Returns
+  // net::ERR_IO_PENDING if a helper went asynchronous.
+  int RunCallbackChain(std::shared_ptr<brave::BraveRequestInfo> ctx);
   void RunNextCallback(std::shared_ptr<brave::BraveRequestInfo> ctx);
 
-  std::vector<brave::OnBeforeURLRequestCallback> before_url_request_callbacks_;
-  std::vector<brave::OnBeforeStartTransactionCallback>
+  std::vector<BeforeURLRequestHelper> before_url_request_callbacks_;
+  std::vector<Helper<brave::OnBeforeStartTransactionCallback>>
       before_start_transaction_callbacks_;
-  std::vector<brave::OnHeadersReceivedCallback> headers_received_callbacks_;
+  std::vector<Helper<brave::OnHeadersReceivedCallback>>
+      headers_received_callbacks_;
 
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
 
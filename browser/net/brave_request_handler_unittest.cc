@@ -0,0 +1,140 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/brave_request_handler.h"
+
+#include <memory>
+
+#include "base/bind.h"
+#include "base/run_loop.h"
+#include "brave/browser/net/url_context.h"
+#include "brave/common/network_constants.h"
+#include "brave/components/decentralized_dns/buildflags/buildflags.h"
+#include "content/public/test/browser_task_environment.h"
+#include "net/base/net_errors.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
+#include "url/gurl.h"
+
+namespace {
+
+// A subresource of https://brave.com/ with Shields up and everything that
+// only affects blocked, upgraded or cross-origin requests turned off.
+std::shared_ptr<brave::BraveRequestInfo> MakeQuietCTX(
+    const GURL& url,
+    blink::mojom::ResourceType type = blink::mojom::ResourceType::kImage) {
+  auto ctx = std::make_shared<brave::BraveRequestInfo>(url);
+  ctx->resource_type = type;
+  ctx->tab_origin = GURL("https://brave.com/");
+  ctx->initiator_url = GURL("https://brave.com/");
+  ctx->allow_ads = true;
+  ctx->allow_http_upgradable_resource = true;
+  return ctx;
+}
+
+}  // namespace
+
+class BraveRequestHandlerTest : public testing::Test {
+ protected:
+  content::BrowserTaskEnvironment task_environment_;
+  BraveRequestHandler handler_;
+};
+
+TEST_F(BraveRequestHandlerTest, NoopWithShieldsDown) {
+  auto ctx = MakeQuietCTX(GURL("http://tracker.example/pixel?id=1"));
+  ctx->allow_ads = false;
+  ctx->allow_http_upgradable_resource = false;
+  ctx->referrer = GURL("https://brave.com/page");
+  ctx->allow_brave_shields = false;
+  EXPECT_TRUE(handler_.IsNoopBeforeURLRequest(*ctx));
+}
+
+TEST_F(BraveRequestHandlerTest, AdBlockRunsOnSubresources) {
+  auto ctx = MakeQuietCTX(GURL("https://cdn.brave.com/script.js"),
+                          blink::mojom::ResourceType::kScript);
+  EXPECT_TRUE(handler_.IsNoopBeforeURLRequest(*ctx));
+  ctx->allow_ads = false;
+  EXPECT_FALSE(handler_.IsNoopBeforeURLRequest(*ctx));
+
+  // Main frames are left to DomainBlockNavigationThrottle.
+  auto main_frame = MakeQuietCTX(GURL("https://brave.com/"),
+                                 blink::mojom::ResourceType::kMainFrame);
+  main_frame->allow_ads = false;
+  EXPECT_TRUE(handler_.IsNoopBeforeURLRequest(*main_frame));
+}
+
+TEST_F(BraveRequestHandlerTest, HttpsEverywhereRuns) {
+  auto ctx = MakeQuietCTX(GURL("http://brave.com/image.png"));
+  ctx->allow_http_upgradable_resource = false;
+  EXPECT_FALSE(handler_.IsNoopBeforeURLRequest(*ctx));
+}
+
+TEST_F(BraveRequestHandlerTest, CrossOriginReferrer) {
+  auto ctx = MakeQuietCTX(GURL("https://cdn.example/image.png"));
+  ctx->referrer = GURL("https://brave.com/page");
+  EXPECT_FALSE(handler_.IsNoopBeforeURLRequest(*ctx));
+  ctx->allow_referrers = true;
+  EXPECT_TRUE(handler_.IsNoopBeforeURLRequest(*ctx));
+}
+
+TEST_F(BraveRequestHandlerTest, CrossSiteQuery) {
+  EXPECT_FALSE(handler_.IsNoopBeforeURLRequest(
+      *MakeQuietCTX(GURL("https://tracker.example/?fbclid=1"),
+                    blink::mojom::ResourceType::kXhr)));
+  EXPECT_TRUE(handler_.IsNoopBeforeURLRequest(
+      *MakeQuietCTX(GURL("https://search.brave.com/?q=1"),
+                    blink::mojom::ResourceType::kXhr)));
+
+  // A cross-site redirect has its query filtered whatever the initiator.
+  auto redirect = MakeQuietCTX(GURL("https://search.brave.com/?q=1"),
+                               blink::mojom::ResourceType::kXhr);
+  redirect->redirect_source = GURL("https://tracker.example/");
+  EXPECT_FALSE(handler_.IsNoopBeforeURLRequest(*redirect));
+}
+
+TEST_F(BraveRequestHandlerTest, StaticRedirect) {
+  auto ctx = MakeQuietCTX(GURL("https://clients4.google.com/chrome-sync/dev"),
+                          blink::mojom::ResourceType::kXhr);
+  ctx->allow_brave_shields = false;
+  EXPECT_FALSE(handler_.IsNoopBeforeURLRequest(*ctx));
+}
+
+#if BUILDFLAG(DECENTRALIZED_DNS_ENABLED)
+TEST_F(BraveRequestHandlerTest, DecentralizedDnsTLD) {
+  EXPECT_FALSE(handler_.IsNoopBeforeURLRequest(
+      *MakeQuietCTX(GURL("https://brave.crypto/"),
+                    blink::mojom::ResourceType::kMainFrame)));
+  EXPECT_FALSE(handler_.IsNoopBeforeURLRequest(
+      *MakeQuietCTX(GURL("https://brave.eth/"),
+                    blink::mojom::ResourceType::kMainFrame)));
+}
+#endif
+
+TEST_F(BraveRequestHandlerTest, CompletesSynchronouslyWithoutCallback) {
+  auto ctx =
+      std::make_shared<brave::BraveRequestInfo>(GURL("https://brave.com/"));
+  ctx->allow_brave_shields = false;
+  bool callback_run = false;
+  GURL new_url;
+  EXPECT_EQ(net::OK,
+            handler_.OnBeforeURLRequest(
+                ctx,
+                base::BindOnce([](bool* run, int) { *run = true; },
+                               &callback_run),
+                &new_url));
+  EXPECT_TRUE(new_url.is_empty());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(callback_run);
+}
+
+TEST_F(BraveRequestHandlerTest, RedirectsSynchronously) {
+  auto ctx = std::make_shared<brave::BraveRequestInfo>(
+      GURL("https://clients4.google.com/chrome-sync/dev"));
+  ctx->allow_brave_shields = false;
+  GURL new_url;
+  EXPECT_EQ(net::OK, handler_.OnBeforeURLRequest(
+                         ctx, net::CompletionOnceCallback(), &new_url));
+  EXPECT_EQ(kBraveClients4Proxy, new_url.host());
+}
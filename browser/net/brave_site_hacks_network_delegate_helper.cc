@@ -91,34 +91,43 @@ DECLARE_LAZY_MATCHER(tracker_appended_matcher,
 
 #undef DECLARE_LAZY_MATCHER
 
-void ApplyPotentialQueryStringFilter(std::shared_ptr<BraveRequestInfo> ctx) {
-  SCOPED_UMA_HISTOGRAM_TIMER("Brave.SiteHacks.QueryFilter");
+bool ShouldFilterQueryString(const BraveRequestInfo& ctx) {
+  if (!ctx.request_url.has_query())
+    return false;
 
-  if (!ctx->allow_brave_shields) {
+  if (!ctx.allow_brave_shields) {
     // Don't apply the filter if the destination URL has shields down.
-    return;
+    return false;
   }
 
-  if (ctx->redirect_source.is_valid()) {
-    if (ctx->internal_redirect) {
+  if (ctx.redirect_source.is_valid()) {
+    if (ctx.internal_redirect) {
       // Ignore internal redirects since we trigger them.
-      return;
+      return false;
     }
 
     if (net::registry_controlled_domains::SameDomainOrHost(
-            ctx->redirect_source, ctx->request_url,
+            ctx.redirect_source, ctx.request_url,
             net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES)) {
       // Same-site redirects are exempted.
-      return;
+      return false;
     }
-  } else if (ctx->initiator_url.is_valid() &&
+  } else if (ctx.initiator_url.is_valid() &&
              net::registry_controlled_domains::SameDomainOrHost(
-                 ctx->initiator_url, ctx->request_url,
+                 ctx.initiator_url, ctx.request_url,
                  net::registry_controlled_domains::
                      INCLUDE_PRIVATE_REGISTRIES)) {
     // Same-site requests are exempted.
-    return;
+    return false;
   }
+  return true;
+}
+
+void ApplyPotentialQueryStringFilter(std::shared_ptr<BraveRequestInfo> ctx) {
+  SCOPED_UMA_HISTOGRAM_TIMER("Brave.SiteHacks.QueryFilter");
+
+  if (!ShouldFilterQueryString(*ctx))
+    return;
 
   // Regular expressions are dirty and error-prone, but unfortunately
   // there is no right way to parse a query string, other than one
@@ -145,17 +154,27 @@ void ApplyPotentialQueryStringFilter(std::shared_ptr<BraveRequestInfo> ctx) {
   }
 }
 
-bool ApplyPotentialReferrerBlock(std::shared_ptr<BraveRequestInfo> ctx) {
-  if (ctx->tab_origin.SchemeIs(kChromeExtensionScheme)) {
+bool ShouldCapReferrer(const BraveRequestInfo& ctx) {
+  if (ctx.tab_origin.SchemeIs(kChromeExtensionScheme)) {
     return false;
   }
 
-  if (ctx->resource_type == blink::mojom::ResourceType::kMainFrame ||
-      ctx->resource_type == blink::mojom::ResourceType::kSubFrame) {
+  if (ctx.resource_type == blink::mojom::ResourceType::kMainFrame ||
+      ctx.resource_type == blink::mojom::ResourceType::kSubFrame) {
     // Frame navigations are handled in content::NavigationRequest.
     return false;
   }
 
+  // Mirrors the early returns in brave_shields::MaybeChangeReferrer().
+  return !ctx.allow_referrers && ctx.allow_brave_shields &&
+         !ctx.referrer.is_empty() &&
+         !brave_shields::IsSameOriginNavigation(ctx.referrer, ctx.request_url);
+}
+
+bool ApplyPotentialReferrerBlock(std::shared_ptr<BraveRequestInfo> ctx) {
+  if (!ShouldCapReferrer(*ctx))
+    return false;
+
   content::Referrer new_referrer;
   if (brave_shields::MaybeChangeReferrer(
           ctx->allow_referrers, ctx->allow_brave_shields, GURL(ctx->referrer),
@@ -168,6 +187,10 @@ bool ApplyPotentialReferrerBlock(std::shared_ptr<BraveRequestInfo> ctx) {
 
 }  // namespace
 
+bool ShouldRunOnBeforeURLRequest_SiteHacksWork(const BraveRequestInfo& ctx) {
+  return ShouldCapReferrer(ctx) || ShouldFilterQueryString(ctx);
+}
+
 int OnBeforeURLRequest_SiteHacksWork(const ResponseCallback& next_callback,
                                      std::shared_ptr<BraveRequestInfo> ctx) {
   ApplyPotentialReferrerBlock(ctx);
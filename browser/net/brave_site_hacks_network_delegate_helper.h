@@ -16,6 +16,11 @@ class URLRequest;
 
 namespace brave {
 
+// Returns false if OnBeforeURLRequest_SiteHacksWork() would leave |ctx|
+// unchanged, i.e. there is neither a referrer to cap nor a query string to
+// filter.
+bool ShouldRunOnBeforeURLRequest_SiteHacksWork(const BraveRequestInfo& ctx);
+
 int OnBeforeURLRequest_SiteHacksWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx);
@@ -9,9 +9,11 @@
 #include <vector>
 
 #include "brave/browser/brave_wallet/rpc_controller_factory.h"
+#include "brave/browser/decentralized_dns/decentralized_dns_service_factory.h"
 #include "brave/components/brave_wallet/browser/eth_json_rpc_controller.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "brave/components/decentralized_dns/constants.h"
+#include "brave/components/decentralized_dns/decentralized_dns_service.h"
 #include "brave/components/decentralized_dns/utils.h"
 #include "brave/components/ipfs/ipfs_utils.h"
 #include "chrome/browser/browser_process.h"
@@ -28,10 +30,17 @@ std::string GetValue(const std::vector<std::string>& arr, RecordKeys key) {
 
 }  // namespace
 
+bool ShouldRunOnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
+    const brave::BraveRequestInfo& ctx) {
+  return IsUnstoppableDomainsTLD(ctx.request_url) ||
+         IsENSTLD(ctx.request_url);
+}
+
 int OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
     const brave::ResponseCallback& next_callback,
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
-  if (!ctx->browser_context || !IsDecentralizedDnsEnabled() ||
+  if (!ShouldRunOnBeforeURLRequest_DecentralizedDnsPreRedirectWork(*ctx) ||
+      !ctx->browser_context || !IsDecentralizedDnsEnabled() ||
       ctx->browser_context->IsOffTheRecord() || !g_browser_process) {
     return net::OK;
   }
@@ -39,28 +48,53 @@ int OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
   auto* rpc_controller =
       brave_wallet::RpcControllerFactory::GetControllerForContext(
           ctx->browser_context);
-  if (!rpc_controller)
+  auto* service =
+      DecentralizedDnsServiceFactory::GetForContext(ctx->browser_context);
+  if (!rpc_controller || !service)
     return net::OK;
 
+  const std::string& name = ctx->request_url.host();
+
   if (IsUnstoppableDomainsTLD(ctx->request_url) &&
       IsUnstoppableDomainsResolveMethodEthereum(
           g_browser_process->local_state())) {
-    auto keys = std::vector<std::string>(std::begin(kRecordKeys),
-                                         std::end(kRecordKeys));
-    rpc_controller->UnstoppableDomainsProxyReaderGetMany(
-        brave_wallet::mojom::kMainnetChainId, ctx->request_url.host(), keys,
-        base::BindOnce(&OnBeforeURLRequest_UnstoppableDomainsRedirectWork,
-                       next_callback, ctx));
+    auto* cache = service->unstoppable_domains_cache();
+    if (const auto* entry = cache->Get(name)) {
+      OnBeforeURLRequest_UnstoppableDomainsRedirectWork(
+          brave::ResponseCallback(), ctx, entry->success, entry->result);
+      return net::OK;
+    }
+
+    if (cache->AddPendingRequest(
+            name,
+            base::BindOnce(&OnBeforeURLRequest_UnstoppableDomainsRedirectWork,
+                           next_callback, ctx))) {
+      auto keys = std::vector<std::string>(std::begin(kRecordKeys),
+                                           std::end(kRecordKeys));
+      rpc_controller->UnstoppableDomainsProxyReaderGetMany(
+          brave_wallet::mojom::kMainnetChainId, name, keys,
+          cache->GetResolvedCallback(name));
+    }
 
     return net::ERR_IO_PENDING;
   }
 
   if (IsENSTLD(ctx->request_url) &&
       IsENSResolveMethodEthereum(g_browser_process->local_state())) {
-    rpc_controller->EnsResolverGetContentHash(
-        brave_wallet::mojom::kMainnetChainId, ctx->request_url.host(),
-        base::BindOnce(&OnBeforeURLRequest_EnsRedirectWork, next_callback,
-                       ctx));
+    auto* cache = service->ens_cache();
+    if (const auto* entry = cache->Get(name)) {
+      OnBeforeURLRequest_EnsRedirectWork(brave::ResponseCallback(), ctx,
+                                         entry->success, entry->result);
+      return net::OK;
+    }
+
+    if (cache->AddPendingRequest(
+            name, base::BindOnce(&OnBeforeURLRequest_EnsRedirectWork,
+                                 next_callback, ctx))) {
+      rpc_controller->EnsResolverGetContentHash(
+          brave_wallet::mojom::kMainnetChainId, name,
+          cache->GetResolvedCallback(name));
+    }
 
     return net::ERR_IO_PENDING;
   }
@@ -15,6 +15,11 @@
 
 namespace decentralized_dns {
 
+// Returns false if |ctx| isn't for an Unstoppable Domains or ENS name, so
+// OnBeforeURLRequest_DecentralizedDnsPreRedirectWork() has nothing to resolve.
+bool ShouldRunOnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
+    const brave::BraveRequestInfo& ctx);
+
 // Issue eth_call requests via Ethereum provider such as Infura to query
 // decentralized DNS records, and redirect URL requests based on them.
 int OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
@@ -6,11 +6,16 @@
 #include "brave/browser/net/decentralized_dns_network_delegate_helper.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "base/callback_helpers.h"
 #include "base/test/scoped_feature_list.h"
+#include "brave/browser/decentralized_dns/decentralized_dns_service_factory.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/decentralized_dns/constants.h"
+#include "brave/components/decentralized_dns/decentralized_dns_service.h"
 #include "brave/components/decentralized_dns/features.h"
 #include "brave/components/decentralized_dns/pref_names.h"
 #include "brave/components/decentralized_dns/utils.h"
@@ -111,6 +116,49 @@ TEST_F(DecentralizedDnsNetworkDelegateHelperTest,
   EXPECT_TRUE(brave_request_info->new_url_spec.empty());
 }
 
+TEST_F(DecentralizedDnsNetworkDelegateHelperTest,
+       CachedResolutionRedirectsSynchronously) {
+  local_state()->SetInteger(kUnstoppableDomainsResolveMethod,
+                            static_cast<int>(ResolveMethodTypes::ETHEREUM));
+  auto* service = DecentralizedDnsServiceFactory::GetForContext(profile());
+  ASSERT_TRUE(service);
+
+  std::vector<std::string> records(
+      static_cast<size_t>(RecordKeys::MAX_RECORD_KEY) + 1);
+  records[static_cast<size_t>(RecordKeys::DWEB_IPFS_HASH)] =
+      "QmWrdNJWMbvRxxzLhojVKaBDswS4KNVM7LvjsN7QbDrvka";
+  auto* cache = service->unstoppable_domains_cache();
+  ASSERT_TRUE(cache->AddPendingRequest("brave.crypto", base::DoNothing()));
+  cache->GetResolvedCallback("brave.crypto").Run(true, records);
+
+  auto brave_request_info =
+      std::make_shared<brave::BraveRequestInfo>(GURL("http://brave.crypto"));
+  brave_request_info->browser_context = profile();
+  int rc = OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
+      ResponseCallback(), brave_request_info);
+  EXPECT_EQ(rc, net::OK);
+  EXPECT_EQ("ipfs://QmWrdNJWMbvRxxzLhojVKaBDswS4KNVM7LvjsN7QbDrvka",
+            brave_request_info->new_url_spec);
+
+  // A cached failure answers synchronously without a redirect.
+  ASSERT_TRUE(cache->AddPendingRequest("other.crypto", base::DoNothing()));
+  cache->GetResolvedCallback("other.crypto").Run(false, {});
+  brave_request_info =
+      std::make_shared<brave::BraveRequestInfo>(GURL("http://other.crypto"));
+  brave_request_info->browser_context = profile();
+  rc = OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(ResponseCallback(),
+                                                          brave_request_info);
+  EXPECT_EQ(rc, net::OK);
+  EXPECT_TRUE(brave_request_info->new_url_spec.empty());
+
+  // Changing the resolve method drops the cached answers.
+  local_state()->SetInteger(kUnstoppableDomainsResolveMethod,
+                            static_cast<int>(ResolveMethodTypes::ASK));
+  local_state()->SetInteger(kUnstoppableDomainsResolveMethod,
+                            static_cast<int>(ResolveMethodTypes::ETHEREUM));
+  EXPECT_FALSE(cache->Get("brave.crypto"));
+}
+
 TEST_F(DecentralizedDnsNetworkDelegateHelperTest,
        UnstoppableDomainsRedirectWork) {
   GURL url("http://brave.crypto");
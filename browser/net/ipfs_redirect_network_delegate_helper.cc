@@ -7,7 +7,12 @@
 
 #include <string>
 
+#include "base/bind.h"
+#include "base/feature_list.h"
+#include "brave/browser/ipfs/ipfs_service_factory.h"
 #include "brave/browser/profiles/profile_util.h"
+#include "brave/components/ipfs/features.h"
+#include "brave/components/ipfs/ipfs_service.h"
 #include "brave/components/ipfs/ipfs_utils.h"
 #include "chrome/common/channel_info.h"
 #include "components/prefs/pref_service.h"
@@ -17,6 +22,30 @@
 
 namespace ipfs {
 
+namespace {
+
+void OnGatewayRaceComplete(const brave::ResponseCallback& next_callback,
+                           std::shared_ptr<brave::BraveRequestInfo> ctx,
+                           const GURL& gateway) {
+  GURL gateway_url = gateway;
+  if (gateway_url.is_empty()) {
+    // No gateway won, so leave it to the local node as usual.
+    gateway_url = ctx->ipfs_gateway_url;
+  }
+  GURL new_url;
+  if (TranslateIPFSURI(ctx->request_url, &new_url, gateway_url, false)) {
+    ctx->new_url_spec = new_url.spec();
+  }
+  next_callback.Run();
+}
+
+}  // namespace
+
+bool ShouldRunOnBeforeURLRequest_IPFSRedirectWork(
+    const brave::BraveRequestInfo& ctx) {
+  return IsIPFSScheme(ctx.request_url);
+}
+
 int OnBeforeURLRequest_IPFSRedirectWork(
     const brave::ResponseCallback& next_callback,
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
@@ -27,9 +56,30 @@ int OnBeforeURLRequest_IPFSRedirectWork(
     return net::OK;
   }
 
+  // Only race once the node is running, the navigation throttle takes care of
+  // starting it otherwise.
+  auto* ipfs_service = IpfsServiceFactory::GetForContext(ctx->browser_context);
+  if (base::FeatureList::IsEnabled(features::kIpfsGatewayRacingFeature) &&
+      ctx->resource_type == blink::mojom::ResourceType::kMainFrame &&
+      IsIPFSScheme(ctx->request_url) && IsLocalGatewayConfigured(prefs) &&
+      ipfs_service && ipfs_service->IsDaemonLaunched()) {
+    ipfs_service->RaceGateways(
+        ctx->request_url,
+        base::BindOnce(&OnGatewayRaceComplete, next_callback, ctx));
+    return net::ERR_IO_PENDING;
+  }
+
+  // A page that the public gateway won the race for loads its ipfs://
+  // resources from there too.
+  GURL gateway_url = ctx->ipfs_gateway_url;
+  if (base::FeatureList::IsEnabled(features::kIpfsGatewayRacingFeature) &&
+      ctx->resource_type != blink::mojom::ResourceType::kMainFrame &&
+      IsDefaultGatewayURL(ctx->initiator_url, prefs)) {
+    gateway_url = GetDefaultIPFSGateway(prefs);
+  }
+
   GURL new_url;
-  if (ipfs::TranslateIPFSURI(ctx->request_url, &new_url, ctx->ipfs_gateway_url,
-                             false)) {
+  if (ipfs::TranslateIPFSURI(ctx->request_url, &new_url, gateway_url, false)) {
     // We only allow translating ipfs:// and ipns:// URIs if the initiator_url
     // is from the same Brave ipfs/ipns gateway.
     // For the local case, we don't want a normal site to be able to populate
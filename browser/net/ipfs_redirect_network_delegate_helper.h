@@ -14,6 +14,11 @@
 
 namespace ipfs {
 
+// Returns false if |ctx| isn't for an ipfs:// or ipns:// URL, which are the
+// only ones OnBeforeURLRequest_IPFSRedirectWork() translates.
+bool ShouldRunOnBeforeURLRequest_IPFSRedirectWork(
+    const brave::BraveRequestInfo& ctx);
+
 int OnBeforeURLRequest_IPFSRedirectWork(
     const brave::ResponseCallback& next_callback,
     std::shared_ptr<brave::BraveRequestInfo> ctx);
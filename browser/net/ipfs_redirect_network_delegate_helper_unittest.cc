@@ -203,6 +203,64 @@ TEST_F(IPFSRedirectNetworkDelegateHelperTest, HeadersIPFSWorkNoRedirect) {
   EXPECT_TRUE(allowed_unsafe_redirect_url.is_empty());
 }
 
+TEST_F(IPFSRedirectNetworkDelegateHelperTest,
+       SubresourceFollowsRacedPublicGateway) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(features::kIpfsGatewayRacingFeature);
+  GURL url("ipfs://QmfM2r8seH2GiRaC4esTjeraXEachRt8ZsSeGaWTPLyMoG");
+  auto brave_request_info = std::make_shared<brave::BraveRequestInfo>(url);
+  brave_request_info->browser_context = profile();
+  brave_request_info->resource_type = blink::mojom::ResourceType::kImage;
+  // The local node is configured, but the page came from the public gateway.
+  brave_request_info->ipfs_gateway_url = GetLocalGateway();
+  brave_request_info->initiator_url = ipfs::GetIPFSGatewayURL(
+      initiator_cid, "", ipfs::GetDefaultIPFSGateway(profile()->GetPrefs()));
+  int rc = ipfs::OnBeforeURLRequest_IPFSRedirectWork(brave::ResponseCallback(),
+                                                     brave_request_info);
+  EXPECT_EQ(rc, net::OK);
+  EXPECT_EQ(
+      brave_request_info->new_url_spec,
+      "https://dweb.link/ipfs/QmfM2r8seH2GiRaC4esTjeraXEachRt8ZsSeGaWTPLyMoG");
+}
+
+TEST_F(IPFSRedirectNetworkDelegateHelperTest,
+       SubresourceKeepsLocalGatewayForLocalPage) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(features::kIpfsGatewayRacingFeature);
+  GURL url("ipfs://QmfM2r8seH2GiRaC4esTjeraXEachRt8ZsSeGaWTPLyMoG");
+  auto brave_request_info = std::make_shared<brave::BraveRequestInfo>(url);
+  brave_request_info->browser_context = profile();
+  brave_request_info->resource_type = blink::mojom::ResourceType::kImage;
+  brave_request_info->ipfs_gateway_url = GetLocalGateway();
+  brave_request_info->initiator_url = ipfs::GetIPFSGatewayURL(
+      initiator_cid, "",
+      ipfs::GetDefaultIPFSLocalGateway(chrome::GetChannel()));
+  int rc = ipfs::OnBeforeURLRequest_IPFSRedirectWork(brave::ResponseCallback(),
+                                                     brave_request_info);
+  EXPECT_EQ(rc, net::OK);
+  EXPECT_EQ(brave_request_info->new_url_spec,
+            "http://localhost:48080/ipfs/"
+            "QmfM2r8seH2GiRaC4esTjeraXEachRt8ZsSeGaWTPLyMoG");
+}
+
+TEST_F(IPFSRedirectNetworkDelegateHelperTest,
+       SubresourceBlockedWithoutGatewayRacing) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndDisableFeature(features::kIpfsGatewayRacingFeature);
+  GURL url("ipfs://QmfM2r8seH2GiRaC4esTjeraXEachRt8ZsSeGaWTPLyMoG");
+  auto brave_request_info = std::make_shared<brave::BraveRequestInfo>(url);
+  brave_request_info->browser_context = profile();
+  brave_request_info->resource_type = blink::mojom::ResourceType::kImage;
+  brave_request_info->ipfs_gateway_url = GetLocalGateway();
+  brave_request_info->initiator_url = ipfs::GetIPFSGatewayURL(
+      initiator_cid, "", ipfs::GetDefaultIPFSGateway(profile()->GetPrefs()));
+  int rc = ipfs::OnBeforeURLRequest_IPFSRedirectWork(brave::ResponseCallback(),
+                                                     brave_request_info);
+  EXPECT_EQ(rc, net::OK);
+  EXPECT_TRUE(brave_request_info->new_url_spec.empty());
+  EXPECT_EQ(brave_request_info->blocked_by, brave::kOtherBlocked);
+}
+
 TEST_F(IPFSRedirectNetworkDelegateHelperTest, PrivateProfile) {
   GURL url("ipfs://QmfM2r8seH2GiRaC4esTjeraXEachRt8ZsSeGaWTPLyMoG");
   auto brave_request_info = std::make_shared<brave::BraveRequestInfo>(url);
@@ -7,13 +7,17 @@
 
 #include <algorithm>
 
+#include "base/bind.h"
+#include "base/feature_list.h"
 #include "brave/browser/tor/tor_profile_service_factory.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_webtorrent/browser/buildflags/buildflags.h"
+#include "brave/components/tor/features.h"
 #include "brave/components/tor/tor_constants.h"
 #include "brave/components/tor/tor_profile_service.h"
 #include "brave/components/translate/core/common/buildflags.h"
 #include "chrome/browser/profiles/profile.h"
+#include "chrome/browser/profiles/profile_destroyer.h"
 #include "chrome/browser/profiles/profile_window.h"
 #include "chrome/browser/ui/browser_list.h"
 #include "chrome/common/pref_names.h"
@@ -93,6 +97,44 @@ Profile* TorProfileManager::GetTorProfile(Profile* profile) {
   return tor_profile;
 }
 
+void TorProfileManager::PrelaunchTor(Profile* profile) {
+  if (!base::FeatureList::IsEnabled(
+          tor::features::kTorSpeculativeLaunchFeature) ||
+      TorProfileServiceFactory::IsTorDisabled() || profile->IsOffTheRecord() ||
+      profile->IsGuestSession() || GetTorBrowserCount()) {
+    return;
+  }
+
+  // Launches tor the same way opening the first Tor window does. Hovering the
+  // menu item again while waiting restarts the timeout.
+  Profile* tor_profile = GetTorProfile(profile);
+  prelaunch_timer_.Start(
+      FROM_HERE, kTorPrelaunchTimeout,
+      base::BindOnce(&TorProfileManager::OnPrelaunchTimeout,
+                     base::Unretained(this), tor_profile->UniqueId()));
+}
+
+void TorProfileManager::OnPrelaunchTimeout(const std::string& context_id) {
+  auto it = tor_profiles_.find(context_id);
+  if (it == tor_profiles_.end() || GetTorBrowserCount())
+    return;
+
+  Profile* tor_profile = it->second;
+  tor::TorProfileService* service =
+      TorProfileServiceFactory::GetForContext(tor_profile);
+  service->KillTor();
+  // Without a window nothing else would destroy the profile, and
+  // GetTorProfile() only starts tor for a newly created one.
+  ProfileDestroyer::DestroyProfileWhenAppropriate(tor_profile);
+}
+
+bool TorProfileManager::FirePrelaunchTimeoutForTesting() {
+  if (!prelaunch_timer_.IsRunning())
+    return false;
+  prelaunch_timer_.FireNow();
+  return true;
+}
+
 void TorProfileManager::CloseAllTorWindows() {
   for (const auto& it : tor_profiles_)
     CloseTorProfileWindows(it.second);
@@ -10,10 +10,17 @@
 
 #include "base/containers/flat_map.h"
 #include "base/no_destructor.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "chrome/browser/profiles/profile_manager.h"
 #include "chrome/browser/profiles/profile_observer.h"
 #include "chrome/browser/ui/browser_list_observer.h"
 
+// A prelaunched tor is stopped again if no Tor window has been opened after
+// this long.
+constexpr base::TimeDelta kTorPrelaunchTimeout =
+    base::TimeDelta::FromMinutes(3);
+
 class TorProfileManager : public BrowserListObserver, public ProfileObserver {
  public:
   static TorProfileManager& GetInstance();
@@ -21,6 +28,12 @@ class TorProfileManager : public BrowserListObserver, public ProfileObserver {
                                  ProfileManager::CreateCallback callback);
   static void CloseTorProfileWindows(Profile* tor_profile);
   Profile* GetTorProfile(Profile* original_profile);
+  // Starts tor for |original_profile| ahead of a Tor window being opened, when
+  // speculative launch is enabled, tor isn't disabled by policy and no Tor
+  // window is open. Private, Tor and guest profiles are ignored.
+  void PrelaunchTor(Profile* original_profile);
+  // Returns false if no prelaunch timeout is pending.
+  bool FirePrelaunchTimeoutForTesting();
 
   // Close all Tor windows for all tor profiles
   void CloseAllTorWindows();
@@ -37,10 +50,13 @@ class TorProfileManager : public BrowserListObserver, public ProfileObserver {
   void OnProfileWillBeDestroyed(Profile* profile) override;
 
   void InitTorProfileUserPrefs(Profile* profile);
+  void OnPrelaunchTimeout(const std::string& context_id);
 
   // One regular profile can only have one tor profile
   base::flat_map<std::string, Profile*> tor_profiles_;
 
+  base::OneShotTimer prelaunch_timer_;
+
   TorProfileManager(const TorProfileManager&) = delete;
   TorProfileManager& operator=(const TorProfileManager&) = delete;
 };
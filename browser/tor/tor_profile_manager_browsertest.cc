@@ -6,6 +6,7 @@
 #include "base/path_service.h"
 #include "base/process/launch.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/threading/thread_restrictions.h"
 #include "brave/browser/brave_ads/ads_service_factory.h"
 #include "brave/browser/brave_rewards/rewards_service_factory.h"
@@ -14,6 +15,7 @@
 #include "brave/common/brave_paths.h"
 #include "brave/common/brave_switches.h"
 #include "brave/components/ipfs/buildflags/buildflags.h"
+#include "brave/components/tor/features.h"
 #include "brave/components/tor/mock_tor_launcher_factory.h"
 #include "brave/components/tor/tor_constants.h"
 #include "brave/components/tor/tor_profile_service.h"
@@ -79,6 +81,10 @@ Profile* SwitchToTorProfile(Profile* parent_profile,
   return browser_list->get(current_profile_num)->profile();
 }
 
+bool FirePrelaunchTimeout() {
+  return TorProfileManager::GetInstance().FirePrelaunchTimeoutForTesting();
+}
+
 }  // namespace
 
 class TorProfileManagerTest : public InProcessBrowserTest {
@@ -336,6 +342,89 @@ IN_PROC_BROWSER_TEST_F(TorProfileManagerTest, CloseAllTorWindows) {
       [](Browser* browser) { EXPECT_FALSE(browser->profile()->IsTor()); });
 }
 
+IN_PROC_BROWSER_TEST_F(TorProfileManagerTest, PrelaunchTorNeedsFeature) {
+  Profile* parent_profile = ProfileManager::GetActiveUserProfile();
+  TorProfileManager::GetInstance().PrelaunchTor(parent_profile);
+  EXPECT_FALSE(parent_profile->HasOffTheRecordProfile(
+      Profile::OTRProfileID(tor::kTorProfileID)));
+  EXPECT_FALSE(FirePrelaunchTimeout());
+}
+
+class TorProfileManagerPrelaunchTest : public TorProfileManagerTest {
+ public:
+  TorProfileManagerPrelaunchTest() {
+    feature_list_.InitAndEnableFeature(
+        tor::features::kTorSpeculativeLaunchFeature);
+  }
+
+  // Prelaunches tor for |parent_profile| and returns the Tor profile, if any.
+  Profile* PrelaunchTor(Profile* parent_profile) {
+    TorProfileManager::GetInstance().PrelaunchTor(parent_profile);
+    const Profile::OTRProfileID tor_id(tor::kTorProfileID);
+    if (!parent_profile->GetOriginalProfile()->HasOffTheRecordProfile(tor_id))
+      return nullptr;
+    Profile* tor_profile =
+        parent_profile->GetOriginalProfile()->GetOffTheRecordProfile(
+            tor_id, /*create_if_needed=*/false);
+    TorProfileServiceFactory::GetForContext(tor_profile)
+        ->SetTorLauncherFactoryForTest(GetTorLauncherFactory());
+    return tor_profile;
+  }
+
+ private:
+  base::test::ScopedFeatureList feature_list_;
+};
+
+IN_PROC_BROWSER_TEST_F(TorProfileManagerPrelaunchTest, StopsAfterTimeout) {
+  Profile* parent_profile = ProfileManager::GetActiveUserProfile();
+  Profile* tor_profile = PrelaunchTor(parent_profile);
+  ASSERT_TRUE(tor_profile);
+  EXPECT_TRUE(tor_profile->IsTor());
+  // No window is opened for a prelaunched tor.
+  EXPECT_EQ(BrowserList::GetInstance()->size(), 1u);
+
+  testing::Mock::AllowLeak(GetTorLauncherFactory());
+  EXPECT_CALL(*GetTorLauncherFactory(), KillTorProcess).Times(1);
+  EXPECT_TRUE(FirePrelaunchTimeout());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(parent_profile->HasOffTheRecordProfile(
+      Profile::OTRProfileID(tor::kTorProfileID)));
+  testing::Mock::VerifyAndClearExpectations(GetTorLauncherFactory());
+}
+
+IN_PROC_BROWSER_TEST_F(TorProfileManagerPrelaunchTest,
+                       KeepsTorForOpenedWindow) {
+  Profile* parent_profile = ProfileManager::GetActiveUserProfile();
+  Profile* tor_profile = PrelaunchTor(parent_profile);
+  ASSERT_TRUE(tor_profile);
+  EXPECT_EQ(SwitchToTorProfile(parent_profile, GetTorLauncherFactory()),
+            tor_profile);
+
+  testing::Mock::AllowLeak(GetTorLauncherFactory());
+  EXPECT_CALL(*GetTorLauncherFactory(), KillTorProcess).Times(0);
+  EXPECT_TRUE(FirePrelaunchTimeout());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(parent_profile->HasOffTheRecordProfile(
+      Profile::OTRProfileID(tor::kTorProfileID)));
+  testing::Mock::VerifyAndClearExpectations(GetTorLauncherFactory());
+}
+
+IN_PROC_BROWSER_TEST_F(TorProfileManagerPrelaunchTest,
+                       SkipsPrivateProfiles) {
+  Profile* parent_profile = ProfileManager::GetActiveUserProfile();
+  Browser* incognito = CreateIncognitoBrowser(parent_profile);
+  ASSERT_TRUE(incognito);
+  EXPECT_FALSE(PrelaunchTor(incognito->profile()));
+  EXPECT_FALSE(FirePrelaunchTimeout());
+}
+
+IN_PROC_BROWSER_TEST_F(TorProfileManagerPrelaunchTest, SkipsWhenTorDisabled) {
+  TorProfileServiceFactory::SetTorDisabled(true);
+  EXPECT_FALSE(PrelaunchTor(ProfileManager::GetActiveUserProfile()));
+  EXPECT_FALSE(FirePrelaunchTimeout());
+  TorProfileServiceFactory::SetTorDisabled(false);
+}
+
 #if BUILDFLAG(ENABLE_EXTENSIONS)
 class TorProfileManagerExtensionTest : public extensions::ExtensionBrowserTest {
  public:
@@ -9,6 +9,8 @@
 
 #include "brave/app/brave_command_ids.h"
 #include "brave/components/brave_vpn/buildflags/buildflags.h"
+#include "brave/components/tor/buildflags/buildflags.h"
+#include "chrome/browser/ui/browser.h"
 #include "ui/base/models/menu_model.h"
 #include "ui/views/controls/menu/menu_item_view.h"
 
@@ -17,6 +19,10 @@
 #include "brave/browser/ui/views/toolbar/brave_vpn_toggle_button.h"
 #endif
 
+#if BUILDFLAG(ENABLE_TOR)
+#include "brave/browser/tor/tor_profile_manager.h"
+#endif
+
 using views::MenuItemView;
 
 BraveAppMenu::~BraveAppMenu() = default;
@@ -38,3 +44,14 @@ MenuItemView* BraveAppMenu::AddMenuItem(views::MenuItemView* parent,
 
   return menu_item;
 }
+
+void BraveAppMenu::SelectionChanged(views::MenuItemView* menu) {
+  AppMenu::SelectionChanged(menu);
+
+#if BUILDFLAG(ENABLE_TOR)
+  // Hovering the item is the earliest sign that a Tor window is about to be
+  // opened.
+  if (menu && menu->GetCommand() == IDC_NEW_OFFTHERECORD_WINDOW_TOR)
+    TorProfileManager::GetInstance().PrelaunchTor(browser_->profile());
+#endif
+}
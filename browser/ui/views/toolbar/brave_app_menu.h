@@ -23,6 +23,7 @@ class BraveAppMenu : public AppMenu {
                                    ui::MenuModel* model,
                                    int model_index,
                                    ui::MenuModel::ItemType menu_type) override;
+  void SelectionChanged(views::MenuItemView* menu) override;
 };
 
 #endif  // BRAVE_BROWSER_UI_VIEWS_TOOLBAR_BRAVE_APP_MENU_H_
@@ -5,8 +5,11 @@
 
 #include "third_party/blink/renderer/core/execution_context/execution_context.h"
 
+#include <algorithm>
+
 #include "base/command_line.h"
 #include "base/strings/string_number_conversions.h"
+#include "build/build_config.h"
 #include "crypto/hmac.h"
 #include "third_party/blink/public/platform/web_content_settings_client.h"
 #include "third_party/blink/renderer/core/dom/document.h"
@@ -22,6 +25,12 @@
 #include "third_party/blink/renderer/platform/supplementable.h"
 #include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
 
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#elif defined(ARCH_CPU_ARM64)
+#include <arm_neon.h>
+#endif
+
 namespace {
 
 const uint64_t zero = 0;
@@ -30,26 +39,57 @@ inline uint64_t lfsr_next(uint64_t v) {
   return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
 }
 
-float Identity(float value, size_t index) {
-  return value;
-}
+const double maxUInt64AsDouble = UINT64_MAX;
+
+// Number of LFSR states generated before converting them to samples.
+const size_t kPseudoRandomBlockSize = 64;
 
-float ConstantMultiplier(double fudge_factor, float value, size_t index) {
-  return value * fudge_factor;
+// Multiplies every sample by |fudge_factor|. The product is computed in double
+// precision and rounded back to float, exactly like the scalar expression, so
+// farbled values do not depend on which path ran.
+void MultiplySamples(float* dst, size_t count, double fudge_factor) {
+  size_t i = 0;
+#if defined(ARCH_CPU_X86_FAMILY)
+  const __m128d factor = _mm_set1_pd(fudge_factor);
+  for (; i + 4 <= count; i += 4) {
+    const __m128 samples = _mm_loadu_ps(dst + i);
+    const __m128d low = _mm_mul_pd(_mm_cvtps_pd(samples), factor);
+    const __m128d high =
+        _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(samples, samples)), factor);
+    _mm_storeu_ps(dst + i,
+                  _mm_movelh_ps(_mm_cvtpd_ps(low), _mm_cvtpd_ps(high)));
+  }
+#elif defined(ARCH_CPU_ARM64)
+  const float64x2_t factor = vdupq_n_f64(fudge_factor);
+  for (; i + 4 <= count; i += 4) {
+    const float32x4_t samples = vld1q_f32(dst + i);
+    const float64x2_t low =
+        vmulq_f64(vcvt_f64_f32(vget_low_f32(samples)), factor);
+    const float64x2_t high = vmulq_f64(vcvt_high_f64_f32(samples), factor);
+    vst1q_f32(dst + i, vcvt_high_f32_f64(vcvt_f32_f64(low), high));
+  }
+#endif
+  for (; i < count; ++i)
+    dst[i] = dst[i] * fudge_factor;
 }
 
-float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
-  static uint64_t v;
-  const double maxUInt64AsDouble = UINT64_MAX;
-  if (index == 0) {
-    // start of loop, reset to initial seed which was passed in and is based on
-    // the domain key
-    v = seed;
+// Overwrites every sample with the pseudo-random sequence derived from |seed|.
+// The LFSR is inherently serial, so each block of states is generated first
+// and then converted to floats in a separate loop that can be vectorized.
+void FillPseudoRandomSamples(float* dst, size_t count, uint64_t seed) {
+  uint64_t states[kPseudoRandomBlockSize];
+  uint64_t v = seed;
+  for (size_t offset = 0; offset < count; offset += kPseudoRandomBlockSize) {
+    const size_t block_size =
+        std::min(kPseudoRandomBlockSize, count - offset);
+    for (size_t i = 0; i < block_size; ++i) {
+      v = lfsr_next(v);
+      states[i] = v;
+    }
+    // pseudo-random float between 0 and 0.1
+    for (size_t i = 0; i < block_size; ++i)
+      dst[offset + i] = (states[i] / maxUInt64AsDouble) / 10;
   }
-  // get next value in PRNG sequence
-  v = lfsr_next(v);
-  // return pseudo-random float between 0 and 0.1
-  return (v / maxUInt64AsDouble) / 10;
 }
 
 }  // namespace
@@ -84,6 +124,34 @@ blink::WebContentSettingsClient* GetContentSettingsClientFor(
   return settings;
 }
 
+AudioFarblingHelper::AudioFarblingHelper(double fudge_factor,
+                                         uint64_t seed,
+                                         bool max)
+    : fudge_factor_(fudge_factor), seed_(seed), max_(max), lfsr_state_(seed) {}
+
+AudioFarblingHelper::~AudioFarblingHelper() = default;
+
+void AudioFarblingHelper::FarbleAudioChannel(float* dst, size_t count) const {
+  if (!dst || count == 0)
+    return;
+  if (max_)
+    FillPseudoRandomSamples(dst, count, seed_);
+  else
+    MultiplySamples(dst, count, fudge_factor_);
+}
+
+float AudioFarblingHelper::FarbleAudioSample(float value, size_t index) {
+  if (!max_)
+    return value * fudge_factor_;
+  if (index == 0) {
+    // start of loop, reset to initial seed which is based on the domain key
+    lfsr_state_ = seed_;
+  }
+  lfsr_state_ = lfsr_next(lfsr_state_);
+  // return pseudo-random float between 0 and 0.1
+  return (lfsr_state_ / maxUInt64AsDouble) / 10;
+}
+
 BraveFarblingLevel GetBraveFarblingLevelFor(ExecutionContext* context,
                                             BraveFarblingLevel default_value) {
   BraveFarblingLevel value = default_value;
@@ -140,7 +208,7 @@ BraveSessionCache& BraveSessionCache::From(ExecutionContext& context) {
   return *cache;
 }
 
-AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
+absl::optional<AudioFarblingHelper> BraveSessionCache::GetAudioFarblingHelper(
     blink::WebContentSettingsClient* settings) {
   if (farbling_enabled_ && settings) {
     switch (settings->GetBraveFarblingLevel()) {
@@ -149,19 +217,18 @@ AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
       }
       case BraveFarblingLevel::BALANCED: {
         const uint64_t* fudge = reinterpret_cast<const uint64_t*>(domain_key_);
-        const double maxUInt64AsDouble = UINT64_MAX;
         double fudge_factor = 0.99 + ((*fudge / maxUInt64AsDouble) / 100);
         VLOG(1) << "audio fudge factor (based on session token) = "
                 << fudge_factor;
-        return base::BindRepeating(&ConstantMultiplier, fudge_factor);
+        return AudioFarblingHelper(fudge_factor, 0, false);
       }
       case BraveFarblingLevel::MAXIMUM: {
         uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
-        return base::BindRepeating(&PseudoRandomSequence, seed);
+        return AudioFarblingHelper(1.0, seed, true);
       }
     }
   }
-  return base::BindRepeating(&Identity);
+  return absl::nullopt;
 }
 
 void BraveSessionCache::PerturbPixels(blink::WebContentSettingsClient* settings,
@@ -10,8 +10,8 @@
 
 #include <random>
 
-#include "base/callback.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace blink {
 class WebContentSettingsClient;
@@ -24,7 +24,28 @@ using blink::Supplement;
 
 namespace brave {
 
-typedef base::RepeatingCallback<float(float, size_t)> AudioFarblingCallback;
+// Farbles Web Audio sample data. Whole channels are transformed with a single
+// call so the per-sample cost is a multiply (BALANCED) or one LFSR step
+// (MAXIMUM) rather than an indirect callback invocation.
+class CORE_EXPORT AudioFarblingHelper {
+ public:
+  AudioFarblingHelper(double fudge_factor, uint64_t seed, bool max);
+  ~AudioFarblingHelper();
+
+  // Farbles |count| samples in place. |dst| must be the start of the
+  // channel, since the MAXIMUM sequence restarts at the first sample.
+  void FarbleAudioChannel(float* dst, size_t count) const;
+  // Farbles a single value at position |index|, for callers that have to
+  // farble while converting samples to another type. Values must be passed
+  // in index order starting at 0.
+  float FarbleAudioSample(float value, size_t index);
+
+ private:
+  double fudge_factor_;
+  uint64_t seed_;
+  bool max_;
+  uint64_t lfsr_state_;
+};
 
 CORE_EXPORT blink::WebContentSettingsClient* GetContentSettingsClientFor(
     ExecutionContext* context);
@@ -43,7 +64,7 @@ class CORE_EXPORT BraveSessionCache final
 
   static BraveSessionCache& From(ExecutionContext&);
 
-  AudioFarblingCallback GetAudioFarblingCallback(
+  absl::optional<AudioFarblingHelper> GetAudioFarblingHelper(
       blink::WebContentSettingsClient* settings);
   void PerturbPixels(blink::WebContentSettingsClient* settings,
                      const unsigned char* data,
@@ -3,24 +3,26 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
-#define BRAVE_REALTIMEANALYSER_CONVERTFLOATTODB                       \
-  if (audio_farbling_callback_) {                                     \
-    destination[i] = audio_farbling_callback_.Run(destination[i], i); \
+// The float paths expand at the end of the copy loop's body, and farble the
+// whole destination once the last value has been written.
+#define BRAVE_REALTIMEANALYSER_CONVERTFLOATTODB                   \
+  if (audio_farbling_helper_ && i + 1 == len) {                   \
+    audio_farbling_helper_->FarbleAudioChannel(destination, len); \
   }
 
-#define BRAVE_REALTIMEANALYSER_CONVERTTOBYTEDATA                  \
-  if (audio_farbling_callback_) {                                 \
-    scaled_value = audio_farbling_callback_.Run(scaled_value, i); \
+#define BRAVE_REALTIMEANALYSER_CONVERTTOBYTEDATA                               \
+  if (audio_farbling_helper_) {                                                \
+    scaled_value = audio_farbling_helper_->FarbleAudioSample(scaled_value, i); \
   }
 
-#define BRAVE_REALTIMEANALYSER_GETFLOATTIMEDOMAINDATA        \
-  if (audio_farbling_callback_) {                            \
-    destination[i] = audio_farbling_callback_.Run(value, i); \
+#define BRAVE_REALTIMEANALYSER_GETFLOATTIMEDOMAINDATA             \
+  if (audio_farbling_helper_ && i + 1 == len) {                   \
+    audio_farbling_helper_->FarbleAudioChannel(destination, len); \
   }
 
-#define BRAVE_REALTIMEANALYSER_GETBYTETIMEDOMAINDATA \
-  if (audio_farbling_callback_) {                    \
-    value = audio_farbling_callback_.Run(value, i);  \
+#define BRAVE_REALTIMEANALYSER_GETBYTETIMEDOMAINDATA             \
+  if (audio_farbling_helper_) {                                  \
+    value = audio_farbling_helper_->FarbleAudioSample(value, i); \
   }
 
 #include "../../../../../../../third_party/blink/renderer/modules/webaudio/realtime_analyser.cc"
@@ -0,0 +1,161 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Compares checking a page's worth of requests one at a time through
+// Engine::matches() against a single Engine::matchesBatch() call.
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "wrapper.h"
+
+namespace {
+
+constexpr size_t kIterations = 2000;
+
+// A small list in the shape of EasyList: domain anchors, path fragments,
+// third-party options, exceptions and a redirect.
+const char kRules[] =
+    "||doubleclick.net^\n"
+    "||googlesyndication.com^$third-party\n"
+    "||google-analytics.com/analytics.js$script\n"
+    "||scorecardresearch.com^\n"
+    "||adnxs.com^$third-party\n"
+    "||taboola.com^$third-party\n"
+    "||outbrain.com/utils/$script\n"
+    "/ads/banner/*\n"
+    "-advertisement-\n"
+    "/pixel.gif?\n"
+    "&ad_type=\n"
+    "@@||cdn.example.com/ads/banner/logo.png\n"
+    "||tracker.example.net/t.js$script,redirect=noop.js\n";
+
+// Hosts and paths of a typical news article load: first-party assets,
+// CDNs, fonts, analytics and ad networks.
+const char* const kHosts[] = {
+    "www.example.com",
+    "cdn.example.com",
+    "static.example.com",
+    "fonts.gstatic.com",
+    "ajax.googleapis.com",
+    "www.google-analytics.com",
+    "securepubads.g.doubleclick.net",
+    "pagead2.googlesyndication.com",
+    "sb.scorecardresearch.com",
+    "ib.adnxs.com",
+    "cdn.taboola.com",
+    "widgets.outbrain.com",
+    "tracker.example.net",
+    "images.example-media.com",
+};
+
+const char* const kPaths[] = {
+    "/",
+    "/index.html",
+    "/assets/app.js",
+    "/assets/vendor.js",
+    "/css/site.css",
+    "/analytics.js",
+    "/ads/banner/728x90.png",
+    "/ads/banner/logo.png",
+    "/img/hero-advertisement-large.jpg",
+    "/pixel.gif?id=1234&ad_type=display",
+    "/utils/work.js",
+    "/t.js",
+    "/s/a/b/c/d/photo.webp",
+    "/gampad/ads?iu=/1234/news&sz=300x250",
+};
+
+const char* const kResourceTypes[] = {"script", "image", "stylesheet",
+                                      "xmlhttprequest", "sub_frame"};
+
+const char kTabHost[] = "www.example.com";
+
+std::vector<adblock::MatchRequest> BuildCorpus() {
+  std::vector<adblock::MatchRequest> requests;
+  size_t i = 0;
+  for (const char* host : kHosts) {
+    for (const char* path : kPaths) {
+      adblock::MatchRequest request;
+      request.url = std::string("https://") + host + path;
+      request.host = host;
+      request.resource_type =
+          kResourceTypes[i++ % (sizeof(kResourceTypes) / sizeof(char*))];
+      request.is_third_party = !strstr(host, "example.com");
+      requests.push_back(request);
+    }
+  }
+  return requests;
+}
+
+void domainResolverImpl(const char* host, uint32_t* start, uint32_t* end) {
+  // Treats the last two labels as the registrable domain, which holds for
+  // every host in the corpus.
+  const size_t length = strlen(host);
+  size_t dots = 0;
+  *start = 0;
+  for (size_t i = length; i > 0; i--) {
+    if (host[i - 1] == '.' && ++dots == 2) {
+      *start = i;
+      break;
+    }
+  }
+  *end = length;
+}
+
+}  // namespace
+
+int main() {
+  adblock::SetDomainResolver(domainResolverImpl);
+  adblock::Engine engine(kRules);
+  engine.addResource("noop.js", "application/javascript",
+                     "KGZ1bmN0aW9uKCl7fSkoKQ==");
+
+  const std::vector<adblock::MatchRequest> requests = BuildCorpus();
+  size_t single_blocked = 0;
+  size_t batch_blocked = 0;
+
+  const auto single_start = std::chrono::steady_clock::now();
+  for (size_t iteration = 0; iteration < kIterations; iteration++) {
+    for (const auto& request : requests) {
+      adblock::MatchResult result;
+      engine.matches(request.url, request.host, kTabHost,
+                     request.is_third_party, request.resource_type,
+                     &result.did_match_rule, &result.did_match_exception,
+                     &result.did_match_important, &result.redirect);
+      single_blocked += result.did_match_rule && !result.did_match_exception;
+    }
+  }
+  const auto single_time = std::chrono::steady_clock::now() - single_start;
+
+  const auto batch_start = std::chrono::steady_clock::now();
+  for (size_t iteration = 0; iteration < kIterations; iteration++) {
+    std::vector<adblock::MatchResult> results;
+    engine.matchesBatch(kTabHost, requests, &results);
+    for (const auto& result : results)
+      batch_blocked += result.did_match_rule && !result.did_match_exception;
+  }
+  const auto batch_time = std::chrono::steady_clock::now() - batch_start;
+
+  const auto to_ns = [](std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+        .count();
+  };
+  const double checks = static_cast<double>(kIterations * requests.size());
+  std::cout << requests.size() << " requests x " << kIterations
+            << " iterations" << std::endl;
+  std::cout << "matches():      " << to_ns(single_time) / checks
+            << " ns/request" << std::endl;
+  std::cout << "matchesBatch(): " << to_ns(batch_time) / checks
+            << " ns/request" << std::endl;
+
+  if (single_blocked != batch_blocked) {
+    std::cout << "Failed! Batch and single matching disagree" << std::endl;
+    return 1;
+  }
+  return 0;
+}
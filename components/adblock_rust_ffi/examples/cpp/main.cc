@@ -159,6 +159,25 @@ void TestDeserialization() {
         "image");
 }
 
+void TestSerialization() {
+  adblock::Engine engine(
+      "-advertisement-icon.\n"
+      "@@good-advertisement\n");
+  const std::string serialized = engine.serialize();
+  Assert(!serialized.empty(), "Serialized engine should not be empty");
+
+  adblock::Engine engine2;
+  Assert(engine2.deserialize(serialized.data(), serialized.size()),
+         "Serialized engine should deserialize");
+  Check(true, false, false, "", "Basic match after serialization round trip",
+        &engine2, "http://example.com/-advertisement-icon.", "example.com",
+        "example.com", false, "image");
+  Check(false, true, false, "",
+        "Exception match after serialization round trip", &engine2,
+        "http://example.com/good-advertisement-icon.", "example.com",
+        "example.com", false, "image");
+}
+
 void TestTags() {
   adblock::Engine engine(
       "-advertisement-icon.$tag=abc\n"
@@ -200,6 +219,30 @@ void TestRedirects() {
         false, "image");
 }
 
+void TestResourceStore() {
+  adblock::ResourceStore store(
+      "[{\"name\": \"1x1-transparent.gif\","
+      "\"aliases\": [],"
+      "\"kind\": {\"mime\": \"image/gif\"},"
+      "\"content\":\"R0lGODlhAQABAAAAACH5BAEKAAEALAAAAAABAAEAAAICTAEAOw==\"}]");
+  adblock::Engine engine("-advertisement-$redirect=1x1-transparent.gif\n");
+  adblock::Engine other_engine("-banner-$redirect=1x1-transparent.gif\n");
+  engine.useResources(store);
+  other_engine.useResources(store);
+  Check(true, false, false,
+        "data:image/"
+        "gif;base64,R0lGODlhAQABAAAAACH5BAEKAAEALAAAAAABAAEAAAICTAEAOw==",
+        "Testing redirects from a shared resource store", &engine,
+        "http://example.com/-advertisement-icon.", "example.com", "example.com",
+        false, "image");
+  Check(true, false, false,
+        "data:image/"
+        "gif;base64,R0lGODlhAQABAAAAACH5BAEKAAEALAAAAAABAAEAAAICTAEAOw==",
+        "Testing redirects from a shared resource store", &other_engine,
+        "http://example.com/-banner-icon.", "example.com", "example.com",
+        false, "image");
+}
+
 void TestRedirect() {
   adblock::Engine engine("-advertisement-$redirect=test\n");
   engine.addResource("test", "application/javascript", "YWxlcnQoMSk=");
@@ -243,6 +286,52 @@ void TestException() {
         "image");
 }
 
+void TestMatchesBatch() {
+  adblock::Engine engine(
+      "-advertisement-icon$third-party\n"
+      "-advertisement-$redirect=test\n"
+      "@@good-advertisement\n");
+  engine.addResource("test", "application/javascript", "YWxlcnQoMSk=");
+
+  std::vector<adblock::MatchRequest> requests(3);
+  requests[0].url = "http://example.com/-advertisement-icon";
+  requests[1].url = "http://example.com/good-advertisement-icon.";
+  requests[2].url = "https://brianbondy.com";
+  for (auto& request : requests) {
+    request.host = request.url == "https://brianbondy.com" ? "brianbondy.com"
+                                                             : "example.com";
+    request.resource_type = "image";
+    request.is_third_party = request.host != "brianbondy.com";
+  }
+  std::vector<adblock::MatchResult> results;
+  engine.matchesBatch("brianbondy.com", requests, &results);
+
+  // Every entry must agree with the single request API.
+  std::cout << "Batch matches agree with single matches... ";
+  bool agree = results.size() == requests.size();
+  for (size_t i = 0; agree && i < requests.size(); i++) {
+    adblock::MatchResult expected;
+    engine.matches(requests[i].url, requests[i].host, "brianbondy.com",
+                   requests[i].is_third_party, requests[i].resource_type,
+                   &expected.did_match_rule, &expected.did_match_exception,
+                   &expected.did_match_important, &expected.redirect);
+    agree = expected.did_match_rule == results[i].did_match_rule &&
+            expected.did_match_exception == results[i].did_match_exception &&
+            expected.did_match_important == results[i].did_match_important &&
+            expected.redirect == results[i].redirect;
+  }
+  if (agree) {
+    std::cout << "Passed!" << std::endl;
+    num_passed++;
+  } else {
+    std::cout << "Failed!" << std::endl;
+    num_failed++;
+  }
+  Assert(agree, "Batch and single match results differ");
+  Assert(results[0].did_match_rule && !results[2].did_match_rule,
+         "Unexpected batch match results");
+}
+
 void TestClassId() {
   adblock::Engine engine(
       "###element\n"
@@ -427,12 +516,15 @@ int main() {
 
   TestBasics();
   TestDeserialization();
+  TestSerialization();
   TestTags();
   TestRedirects();
+  TestResourceStore();
   TestRedirect();
   TestThirdParty();
   TestImportant();
   TestException();
+  TestMatchesBatch();
   TestClassId();
   TestUrlCosmetics();
   TestSubdomainUrlCosmetics();
@@ -16,6 +16,12 @@
  */
 typedef struct C_Engine C_Engine;
 
+/**
+ * A list of `Resource`s parsed once so that it can be handed to several
+ * engines.
+ */
+typedef struct C_ResourceStore C_ResourceStore;
+
 /**
  * An external callback that receives a hostname and two out-parameters for
  * start and end position. The callback should fill the start and end positions
@@ -61,6 +67,39 @@ void engine_match(struct C_Engine* engine,
                   bool* did_match_important,
                   char** redirect);
 
+/**
+ * A single request checked by `engine_match_batch`.
+ */
+typedef struct C_MatchRequest {
+  const char* url;
+  const char* host;
+  const char* resource_type;
+  bool third_party;
+} C_MatchRequest;
+
+/**
+ * The outcome of checking one `MatchRequest`. The flags are inputs and
+ * outputs, as with `engine_match`. A non-null `redirect` must be freed with
+ * `c_char_buffer_destroy`.
+ */
+typedef struct C_MatchResult {
+  bool did_match_rule;
+  bool did_match_exception;
+  bool did_match_important;
+  char* redirect;
+} C_MatchResult;
+
+/**
+ * Checks `size` requests made from the same `tab_host` in one call, writing
+ * the outcome of `requests[i]` to `results[i]`. Equivalent to calling
+ * `engine_match` once per request.
+ */
+void engine_match_batch(struct C_Engine* engine,
+                        const char* tab_host,
+                        const struct C_MatchRequest* requests,
+                        struct C_MatchResult* results,
+                        size_t size);
+
 /**
  * Returns any CSP directives that should be added to a subdocument or document
  * request's response headers.
@@ -95,6 +134,33 @@ bool engine_add_resource(struct C_Engine* engine,
  */
 void engine_add_resources(struct C_Engine* engine, const char* resources);
 
+/**
+ * Parses a list of `Resource`s from JSON format into a `ResourceStore`.
+ */
+struct C_ResourceStore* resource_store_create(const char* resources);
+
+/**
+ * Returns the number of resources in the store.
+ */
+size_t resource_store_size(const struct C_ResourceStore* store);
+
+/**
+ * Returns the number of bytes taken by the names, aliases and contents of the
+ * resources in the store.
+ */
+size_t resource_store_memory_usage(const struct C_ResourceStore* store);
+
+/**
+ * Replaces the resources of the engine with those in the store.
+ */
+void engine_use_resource_store(struct C_Engine* engine,
+                               const struct C_ResourceStore* store);
+
+/**
+ * Destroy a `ResourceStore` once you are done with it.
+ */
+void resource_store_destroy(struct C_ResourceStore* store);
+
 /**
  * Removes a tag to the engine for consideration
  */
@@ -107,6 +173,20 @@ bool engine_deserialize(struct C_Engine* engine,
                         const char* data,
                         size_t data_size);
 
+/**
+ * Serializes the engine into a buffer that can later be passed to
+ * `engine_deserialize`.
+ *
+ * Returns null on failure. A non-null result must be released with
+ * `engine_serialized_buffer_destroy`.
+ */
+char* engine_serialize(struct C_Engine* engine, size_t* data_size);
+
+/**
+ * Destroy a buffer returned by `engine_serialize` once you are done with it.
+ */
+void engine_serialized_buffer_destroy(char* data, size_t data_size);
+
 /**
  * Destroy a `Engine` once you are done with it.
  */
@@ -101,6 +101,84 @@ pub unsafe extern "C" fn engine_match(
     let resource_type = CStr::from_ptr(resource_type).to_str().unwrap();
     assert!(!engine.is_null());
     let engine = Box::leak(Box::from_raw(engine));
+    *redirect = check_request(
+        engine,
+        url,
+        host,
+        tab_host,
+        resource_type,
+        third_party,
+        &mut *did_match_rule,
+        &mut *did_match_exception,
+        &mut *did_match_important,
+    );
+}
+
+/// A single request checked by `engine_match_batch`.
+#[repr(C)]
+pub struct MatchRequest {
+    pub url: *const c_char,
+    pub host: *const c_char,
+    pub resource_type: *const c_char,
+    pub third_party: bool,
+}
+
+/// The outcome of checking one `MatchRequest`. The flags are inputs and outputs, as with
+/// `engine_match`. A non-null `redirect` must be freed with `c_char_buffer_destroy`.
+#[repr(C)]
+pub struct MatchResult {
+    pub did_match_rule: bool,
+    pub did_match_exception: bool,
+    pub did_match_important: bool,
+    pub redirect: *mut c_char,
+}
+
+/// Checks `size` requests made from the same `tab_host` in one call, writing the outcome of
+/// `requests[i]` to `results[i]`. Equivalent to calling `engine_match` once per request.
+#[no_mangle]
+pub unsafe extern "C" fn engine_match_batch(
+    engine: *mut Engine,
+    tab_host: *const c_char,
+    requests: *const MatchRequest,
+    results: *mut MatchResult,
+    size: size_t,
+) {
+    assert!(!engine.is_null());
+    if size == 0 {
+        return;
+    }
+    let tab_host = CStr::from_ptr(tab_host).to_str().unwrap();
+    let engine = Box::leak(Box::from_raw(engine));
+    let requests = std::slice::from_raw_parts(requests, size);
+    let results = std::slice::from_raw_parts_mut(results, size);
+    for (request, result) in requests.iter().zip(results.iter_mut()) {
+        result.redirect = check_request(
+            engine,
+            CStr::from_ptr(request.url).to_str().unwrap(),
+            CStr::from_ptr(request.host).to_str().unwrap(),
+            tab_host,
+            CStr::from_ptr(request.resource_type).to_str().unwrap(),
+            request.third_party,
+            &mut result.did_match_rule,
+            &mut result.did_match_exception,
+            &mut result.did_match_important,
+        );
+    }
+}
+
+/// Shared implementation of `engine_match` and `engine_match_batch`. Returns the redirect, if
+/// any, as a string to be freed with `c_char_buffer_destroy`.
+fn check_request(
+    engine: &Engine,
+    url: &str,
+    host: &str,
+    tab_host: &str,
+    resource_type: &str,
+    third_party: bool,
+    did_match_rule: &mut bool,
+    did_match_exception: &mut bool,
+    did_match_important: &mut bool,
+) -> *mut c_char {
     let blocker_result = engine.check_network_urls_with_hostnames_subset(
         url,
         host,
@@ -115,7 +193,7 @@ pub unsafe extern "C" fn engine_match(
     *did_match_rule |= blocker_result.matched;
     *did_match_exception |= blocker_result.exception.is_some();
     *did_match_important |= blocker_result.important;
-    *redirect = match blocker_result.redirect {
+    match blocker_result.redirect {
         Some(Redirection::Resource(x)) => match CString::new(x) {
             Ok(y) => y.into_raw(),
             _ => ptr::null_mut(),
@@ -126,7 +204,7 @@ pub unsafe extern "C" fn engine_match(
             _ => ptr::null_mut(),
         },
         None => ptr::null_mut(),
-    };
+    }
 }
 
 /// Returns any CSP directives that should be added to a subdocument or document request's response
@@ -201,19 +279,70 @@ pub unsafe extern "C" fn engine_add_resource(
     engine.add_resource(resource).is_ok()
 }
 
+fn parse_resources(resources: *const c_char) -> Vec<Resource> {
+    let resources = unsafe { CStr::from_ptr(resources) }.to_str().unwrap();
+    serde_json::from_str(resources).unwrap_or_else(|e| {
+        eprintln!("Failed to parse JSON adblock resources: {}", e);
+        vec![]
+    })
+}
+
 /// Adds a list of `Resource`s from JSON format
 #[no_mangle]
 pub unsafe extern "C" fn engine_add_resources(engine: *mut Engine, resources: *const c_char) {
-    let resources = CStr::from_ptr(resources).to_str().unwrap();
-    let resources: Vec<Resource> = serde_json::from_str(resources).unwrap_or_else(|e| {
-        eprintln!("Failed to parse JSON adblock resources: {}", e);
-        vec![]
-    });
+    let resources = parse_resources(resources);
     assert!(!engine.is_null());
     let engine = Box::leak(Box::from_raw(engine));
     engine.use_resources(&resources);
 }
 
+/// A list of `Resource`s parsed once so that it can be handed to several engines.
+pub struct ResourceStore {
+    resources: Vec<Resource>,
+}
+
+/// Parses a list of `Resource`s from JSON format into a `ResourceStore`.
+#[no_mangle]
+pub unsafe extern "C" fn resource_store_create(resources: *const c_char) -> *mut ResourceStore {
+    Box::into_raw(Box::new(ResourceStore { resources: parse_resources(resources) }))
+}
+
+/// Returns the number of resources in the store.
+#[no_mangle]
+pub unsafe extern "C" fn resource_store_size(store: *const ResourceStore) -> size_t {
+    assert!(!store.is_null());
+    (*store).resources.len()
+}
+
+/// Returns the number of bytes taken by the names, aliases and contents of
+/// the resources in the store.
+#[no_mangle]
+pub unsafe extern "C" fn resource_store_memory_usage(store: *const ResourceStore) -> size_t {
+    assert!(!store.is_null());
+    (*store).resources.iter().map(|resource| {
+        resource.name.len()
+            + resource.aliases.iter().map(|alias| alias.len()).sum::<usize>()
+            + resource.content.len()
+    }).sum()
+}
+
+/// Replaces the resources of the engine with those in the store.
+#[no_mangle]
+pub unsafe extern "C" fn engine_use_resource_store(engine: *mut Engine, store: *const ResourceStore) {
+    assert!(!engine.is_null());
+    assert!(!store.is_null());
+    let engine = Box::leak(Box::from_raw(engine));
+    engine.use_resources(&(*store).resources);
+}
+
+/// Destroy a `ResourceStore` once you are done with it.
+#[no_mangle]
+pub unsafe extern "C" fn resource_store_destroy(store: *mut ResourceStore) {
+    if !store.is_null() {
+        drop(Box::from_raw(store));
+    }
+}
+
 /// Removes a tag to the engine for consideration
 #[no_mangle]
 pub unsafe extern "C" fn engine_remove_tag(engine: *mut Engine, tag: *const c_char) {
@@ -240,6 +369,40 @@ pub unsafe extern "C" fn engine_deserialize(
     ok
 }
 
+/// Serializes the engine into a buffer that can later be passed to `engine_deserialize`.
+///
+/// Returns null on failure. A non-null result must be released with
+/// `engine_serialized_buffer_destroy`.
+#[no_mangle]
+pub unsafe extern "C" fn engine_serialize(
+    engine: *mut Engine,
+    data_size: *mut size_t,
+) -> *mut c_char {
+    assert!(!engine.is_null());
+    assert!(!data_size.is_null());
+    let engine = Box::leak(Box::from_raw(engine));
+    match engine.serialize_raw() {
+        Ok(data) => {
+            let data = data.into_boxed_slice();
+            *data_size = data.len();
+            Box::into_raw(data) as *mut c_char
+        }
+        Err(_) => {
+            eprintln!("Error serializing adblock engine");
+            *data_size = 0;
+            ptr::null_mut()
+        }
+    }
+}
+
+/// Destroy a buffer returned by `engine_serialize` once you are done with it.
+#[no_mangle]
+pub unsafe extern "C" fn engine_serialized_buffer_destroy(data: *mut c_char, data_size: size_t) {
+    if !data.is_null() {
+        drop(Box::from_raw(std::ptr::slice_from_raw_parts_mut(data as *mut u8, data_size)));
+    }
+}
+
 /// Destroy a `Engine` once you are done with it.
 #[no_mangle]
 pub unsafe extern "C" fn engine_destroy(engine: *mut Engine) {
@@ -72,6 +72,39 @@ void Engine::matches(const std::string& url,
   }
 }
 
+void Engine::matchesBatch(const std::string& tab_host,
+                          const std::vector<MatchRequest>& requests,
+                          std::vector<MatchResult>* results) {
+  results->resize(requests.size());
+
+  std::vector<C_MatchRequest> raw_requests;
+  std::vector<C_MatchResult> raw_results;
+  raw_requests.reserve(requests.size());
+  raw_results.reserve(requests.size());
+  for (size_t i = 0; i < requests.size(); i++) {
+    raw_requests.push_back({requests[i].url.c_str(), requests[i].host.c_str(),
+                            requests[i].resource_type.c_str(),
+                            requests[i].is_third_party});
+    const MatchResult& result = (*results)[i];
+    raw_results.push_back({result.did_match_rule, result.did_match_exception,
+                           result.did_match_important, nullptr});
+  }
+
+  engine_match_batch(raw, tab_host.c_str(), raw_requests.data(),
+                     raw_results.data(), raw_requests.size());
+
+  for (size_t i = 0; i < raw_results.size(); i++) {
+    MatchResult& result = (*results)[i];
+    result.did_match_rule = raw_results[i].did_match_rule;
+    result.did_match_exception = raw_results[i].did_match_exception;
+    result.did_match_important = raw_results[i].did_match_important;
+    if (raw_results[i].redirect) {
+      result.redirect = raw_results[i].redirect;
+      c_char_buffer_destroy(raw_results[i].redirect);
+    }
+  }
+}
+
 std::string Engine::getCspDirectives(const std::string& url,
                                      const std::string& host,
                                      const std::string& tab_host,
@@ -90,6 +123,16 @@ bool Engine::deserialize(const char* data, size_t data_size) {
   return engine_deserialize(raw, data, data_size);
 }
 
+std::string Engine::serialize() {
+  size_t data_size = 0;
+  char* data = engine_serialize(raw, &data_size);
+  if (!data)
+    return std::string();
+  std::string result(data, data_size);
+  engine_serialized_buffer_destroy(data, data_size);
+  return result;
+}
+
 void Engine::addTag(const std::string& tag) {
   engine_add_tag(raw, tag.c_str());
 }
@@ -112,6 +155,10 @@ void Engine::addResources(const std::string& resources) {
   engine_add_resources(raw, resources.c_str());
 }
 
+void Engine::useResources(const ResourceStore& store) {
+  engine_use_resource_store(raw, store.raw);
+}
+
 const std::string Engine::urlCosmeticResources(const std::string& url) {
   char* resources_raw = engine_url_cosmetic_resources(raw, url.c_str());
   const std::string resources_json = std::string(resources_raw);
@@ -155,4 +202,19 @@ Engine::~Engine() {
   engine_destroy(raw);
 }
 
+ResourceStore::ResourceStore(const std::string& resources)
+    : raw(resource_store_create(resources.c_str())) {}
+
+size_t ResourceStore::size() const {
+  return resource_store_size(raw);
+}
+
+size_t ResourceStore::memoryUsage() const {
+  return resource_store_memory_usage(raw);
+}
+
+ResourceStore::~ResourceStore() {
+  resource_store_destroy(raw);
+}
+
 }  // namespace adblock
@@ -64,6 +64,41 @@ class ADBLOCK_EXPORT FilterList {
   static std::vector<FilterList> regional_list;
 };
 
+// A request checked by Engine::matchesBatch().
+struct ADBLOCK_EXPORT MatchRequest {
+  std::string url;
+  std::string host;
+  std::string resource_type;
+  bool is_third_party = false;
+};
+
+// The outcome of checking a MatchRequest. Like the out-params of
+// Engine::matches(), the flags are also inputs.
+struct ADBLOCK_EXPORT MatchResult {
+  bool did_match_rule = false;
+  bool did_match_exception = false;
+  bool did_match_important = false;
+  std::string redirect;
+};
+
+// A list of redirect and scriptlet resources, parsed once from JSON so that
+// it can be handed to several engines.
+class ADBLOCK_EXPORT ResourceStore {
+ public:
+  explicit ResourceStore(const std::string& resources);
+  ~ResourceStore();
+  // Number of resources in the store.
+  size_t size() const;
+  // Bytes taken by the names, aliases and contents of the resources.
+  size_t memoryUsage() const;
+
+ private:
+  friend class Engine;
+  ResourceStore(const ResourceStore&) = delete;
+  void operator=(const ResourceStore&) = delete;
+  C_ResourceStore* raw;
+};
+
 class ADBLOCK_EXPORT Engine {
  public:
   Engine();
@@ -79,17 +114,29 @@ class ADBLOCK_EXPORT Engine {
                bool* did_match_exception,
                bool* did_match_important,
                std::string* redirect);
+  // Checks all of |requests|, made from |tab_host|, with a single call into
+  // the engine. |results| is resized to one entry per request; entries already
+  // present are updated like the out-params of matches().
+  void matchesBatch(const std::string& tab_host,
+                    const std::vector<MatchRequest>& requests,
+                    std::vector<MatchResult>* results);
   std::string getCspDirectives(const std::string& url,
                                const std::string& host,
                                const std::string& tab_host,
                                bool is_third_party,
                                const std::string& resource_type);
   bool deserialize(const char* data, size_t data_size);
+  // Returns a buffer which can be passed to deserialize() to restore the
+  // engine's filter rules, or an empty string on failure.
+  std::string serialize();
   void addTag(const std::string& tag);
   void addResource(const std::string& key,
                    const std::string& content_type,
                    const std::string& data);
   void addResources(const std::string& resources);
+  // Replaces the resources of the engine with those in |store|, without
+  // parsing them again.
+  void useResources(const ResourceStore& store);
   void removeTag(const std::string& tag);
   bool tagExists(const std::string& tag);
   const std::string urlCosmeticResources(const std::string& url);
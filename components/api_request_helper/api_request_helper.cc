@@ -7,16 +7,110 @@
 
 #include <utility>
 
+#include "base/metrics/histogram_functions.h"
+#include "base/strings/string_util.h"
 #include "net/base/load_flags.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "services/network/public/cpp/simple_url_loader.h"
+#include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
 
 namespace api_request_helper {
 
 const unsigned int kRetriesCountOnNetworkChange = 1;
 
+// Reads the body of one request into a string, enforcing the size limit as
+// the body arrives rather than once it has all been buffered.
+class APIRequestHelper::PendingRequest
+    : public network::SimpleURLLoaderStreamConsumer {
+ public:
+  PendingRequest(APIRequestHelper* helper,
+                 std::unique_ptr<network::SimpleURLLoader> loader,
+                 const APIRequestOptions& options,
+                 ResultCallback callback)
+      : helper_(helper),
+        loader_(std::move(loader)),
+        max_body_size_(options.max_body_size),
+        timing_histogram_name_(options.timing_histogram_name),
+        callback_(std::move(callback)) {}
+  PendingRequest(const PendingRequest&) = delete;
+  PendingRequest& operator=(const PendingRequest&) = delete;
+  ~PendingRequest() override = default;
+
+  void Start(std::list<std::unique_ptr<PendingRequest>>::iterator iter) {
+    iter_ = iter;
+    start_time_ = base::TimeTicks::Now();
+    loader_->DownloadAsStream(helper_->url_loader_factory_.get(), this);
+  }
+
+  // network::SimpleURLLoaderStreamConsumer
+  void OnDataReceived(base::StringPiece string_piece,
+                      base::OnceClosure resume) override {
+    received_bytes_ += string_piece.size();
+    if (max_body_size_ && received_bytes_ > max_body_size_) {
+      VLOG(1) << "Response from " << loader_->GetFinalURL().spec()
+              << " is over the limit of " << max_body_size_ << " bytes";
+      Finish(-1);
+      return;
+    }
+    body_.append(string_piece.data(), string_piece.size());
+    std::move(resume).Run();
+  }
+
+  void OnComplete(bool success) override {
+    auto response_code = -1;
+    if (success && loader_->ResponseInfo() &&
+        loader_->ResponseInfo()->headers) {
+      response_code = loader_->ResponseInfo()->headers->response_code();
+    }
+    Finish(response_code);
+  }
+
+  void OnRetry(base::OnceClosure start_retry) override {
+    body_.clear();
+    received_bytes_ = 0;
+    std::move(start_retry).Run();
+  }
+
+ private:
+  // Deletes |this|.
+  void Finish(int response_code) {
+    if (!timing_histogram_name_.empty()) {
+      base::UmaHistogramTimes(timing_histogram_name_,
+                              base::TimeTicks::Now() - start_time_);
+    }
+    base::flat_map<std::string, std::string> headers;
+    if (loader_->ResponseInfo()) {
+      auto headers_list = loader_->ResponseInfo()->headers;
+      if (headers_list) {
+        size_t iter = 0;
+        std::string key;
+        std::string value;
+        while (headers_list->EnumerateHeaderLines(&iter, &key, &value)) {
+          key = base::ToLowerASCII(key);
+          headers[key] = value;
+        }
+      }
+    }
+    // Failed requests hand back no partial body.
+    std::string body = response_code == -1 ? std::string() : std::move(body_);
+    auto callback = std::move(callback_);
+    helper_->requests_.erase(iter_);
+    std::move(callback).Run(response_code, body, headers);
+  }
+
+  APIRequestHelper* helper_;
+  std::unique_ptr<network::SimpleURLLoader> loader_;
+  std::list<std::unique_ptr<PendingRequest>>::iterator iter_;
+  const size_t max_body_size_;
+  const std::string timing_histogram_name_;
+  base::TimeTicks start_time_;
+  size_t received_bytes_ = 0;
+  std::string body_;
+  ResultCallback callback_;
+};
+
 APIRequestHelper::APIRequestHelper(
     net::NetworkTrafficAnnotationTag annotation_tag,
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
@@ -33,6 +127,20 @@ void APIRequestHelper::Request(
     bool auto_retry_on_network_change,
     ResultCallback callback,
     const base::flat_map<std::string, std::string>& headers) {
+  APIRequestOptions options;
+  options.auto_retry_on_network_change = auto_retry_on_network_change;
+  Request(method, url, payload, payload_content_type, options,
+          std::move(callback), headers);
+}
+
+void APIRequestHelper::Request(
+    const std::string& method,
+    const GURL& url,
+    const std::string& payload,
+    const std::string& payload_content_type,
+    const APIRequestOptions& options,
+    ResultCallback callback,
+    const base::flat_map<std::string, std::string>& headers) {
   auto request = std::make_unique<network::ResourceRequest>();
   request->url = url;
   request->load_flags = net::LOAD_BYPASS_CACHE | net::LOAD_DISABLE_CACHE |
@@ -52,40 +160,19 @@ void APIRequestHelper::Request(
   }
   url_loader->SetRetryOptions(
       kRetriesCountOnNetworkChange,
-      auto_retry_on_network_change
+      options.auto_retry_on_network_change
           ? network::SimpleURLLoader::RetryMode::RETRY_ON_NETWORK_CHANGE
           : network::SimpleURLLoader::RetryMode::RETRY_NEVER);
+  if (!options.timeout.is_zero())
+    url_loader->SetTimeoutDuration(options.timeout);
   url_loader->SetAllowHttpErrorResults(true);
-  auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
-  iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
-      url_loader_factory_.get(),
-      base::BindOnce(&APIRequestHelper::OnResponse, base::Unretained(this),
-                     iter, std::move(callback)));
+  Start(std::make_unique<PendingRequest>(this, std::move(url_loader), options,
+                                         std::move(callback)));
 }
 
-void APIRequestHelper::OnResponse(
-    SimpleURLLoaderList::iterator iter,
-    ResultCallback callback,
-    const std::unique_ptr<std::string> response_body) {
-  auto* loader = iter->get();
-  auto response_code = -1;
-  base::flat_map<std::string, std::string> headers;
-  if (loader->ResponseInfo()) {
-    auto headers_list = loader->ResponseInfo()->headers;
-    if (headers_list) {
-      response_code = headers_list->response_code();
-      size_t iter = 0;
-      std::string key;
-      std::string value;
-      while (headers_list->EnumerateHeaderLines(&iter, &key, &value)) {
-        key = base::ToLowerASCII(key);
-        headers[key] = value;
-      }
-    }
-  }
-  url_loaders_.erase(iter);
-  std::move(callback).Run(response_code, response_body ? *response_body : "",
-                          headers);
+void APIRequestHelper::Start(std::unique_ptr<PendingRequest> request) {
+  auto iter = requests_.insert(requests_.begin(), std::move(request));
+  iter->get()->Start(iter);
 }
 
 }  // namespace api_request_helper
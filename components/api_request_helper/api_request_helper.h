@@ -12,6 +12,7 @@
 
 #include "base/callback.h"
 #include "base/containers/flat_map.h"
+#include "base/time/time.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
 #include "url/gurl.h"
 
@@ -22,6 +23,18 @@ class SimpleURLLoader;
 
 namespace api_request_helper {
 
+struct APIRequestOptions {
+  bool auto_retry_on_network_change = false;
+  // A response whose body grows past this many bytes is dropped and reported
+  // with a status of -1. Zero means no limit.
+  size_t max_body_size = 0;
+  // A request that hasn't completed after this long is reported with a status
+  // of -1. Zero means no timeout.
+  base::TimeDelta timeout;
+  // If set, how long the request took is recorded to this histogram.
+  std::string timing_histogram_name;
+};
+
 // Anyone is welcome to use APIRequestHelper to reduce boilerplate
 class APIRequestHelper {
  public:
@@ -41,18 +54,23 @@ class APIRequestHelper {
                bool auto_retry_on_network_change,
                ResultCallback callback,
                const base::flat_map<std::string, std::string>& headers = {});
+  void Request(const std::string& method,
+               const GURL& url,
+               const std::string& payload,
+               const std::string& payload_content_type,
+               const APIRequestOptions& options,
+               ResultCallback callback,
+               const base::flat_map<std::string, std::string>& headers = {});
 
  private:
+  class PendingRequest;
+
   APIRequestHelper(const APIRequestHelper&) = delete;
   APIRequestHelper& operator=(const APIRequestHelper&) = delete;
-  using SimpleURLLoaderList =
-      std::list<std::unique_ptr<network::SimpleURLLoader>>;
-  void OnResponse(SimpleURLLoaderList::iterator iter,
-                  ResultCallback callback,
-                  const std::unique_ptr<std::string> response_body);
+  void Start(std::unique_ptr<PendingRequest> request);
 
   net::NetworkTrafficAnnotationTag annotation_tag_;
-  SimpleURLLoaderList url_loaders_;
+  std::list<std::unique_ptr<PendingRequest>> requests_;
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
 };
 
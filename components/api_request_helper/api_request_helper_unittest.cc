@@ -0,0 +1,123 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/api_request_helper/api_request_helper.h"
+
+#include <string>
+#include <utility>
+
+#include "base/test/bind.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/task_environment.h"
+#include "net/http/http_status_code.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "services/network/test/test_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace api_request_helper {
+
+namespace {
+
+const char kUrl[] = "https://example.com/data.json";
+
+}  // namespace
+
+class APIRequestHelperUnitTest : public testing::Test {
+ public:
+  APIRequestHelperUnitTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME),
+        api_request_helper_(
+            TRAFFIC_ANNOTATION_FOR_TESTS,
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)) {}
+
+ protected:
+  // Makes a buffered request and returns its status and body.
+  std::pair<int, std::string> Request(const APIRequestOptions& options) {
+    std::pair<int, std::string> result = {0, "unset"};
+    api_request_helper_.Request(
+        "GET", GURL(kUrl), "", "", options,
+        base::BindLambdaForTesting(
+            [&result](const int status, const std::string& body,
+                      const base::flat_map<std::string, std::string>&) {
+              result = {status, body};
+            }));
+    task_environment_.RunUntilIdle();
+    return result;
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  APIRequestHelper api_request_helper_;
+};
+
+TEST_F(APIRequestHelperUnitTest, ReturnsBodyAndLowerCaseHeaders) {
+  auto head = network::CreateURLResponseHead(net::HTTP_OK);
+  head->headers->AddHeader("ETag", "\"1\"");
+  url_loader_factory_.AddResponse(GURL(kUrl), std::move(head), "body",
+                                  network::URLLoaderCompletionStatus());
+  base::flat_map<std::string, std::string> headers;
+  api_request_helper_.Request(
+      "GET", GURL(kUrl), "", "", true,
+      base::BindLambdaForTesting(
+          [&headers](const int status, const std::string& body,
+                     const base::flat_map<std::string, std::string>& h) {
+            EXPECT_EQ(net::HTTP_OK, status);
+            EXPECT_EQ("body", body);
+            headers = h;
+          }));
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ("\"1\"", headers["etag"]);
+}
+
+TEST_F(APIRequestHelperUnitTest, PassesHttpErrorBody) {
+  url_loader_factory_.AddResponse(kUrl, "error", net::HTTP_NOT_FOUND);
+  EXPECT_EQ(std::make_pair(static_cast<int>(net::HTTP_NOT_FOUND),
+                           std::string("error")),
+            Request(APIRequestOptions()));
+}
+
+TEST_F(APIRequestHelperUnitTest, DropsBodyOverLimit) {
+  url_loader_factory_.AddResponse(kUrl, std::string(11, 'a'));
+  APIRequestOptions options;
+  options.max_body_size = 10;
+  EXPECT_EQ(std::make_pair(-1, std::string()), Request(options));
+
+  options.max_body_size = 11;
+  EXPECT_EQ(std::make_pair(static_cast<int>(net::HTTP_OK),
+                           std::string(11, 'a')),
+            Request(options));
+}
+
+TEST_F(APIRequestHelperUnitTest, TimesOut) {
+  std::pair<int, std::string> result = {0, "unset"};
+  APIRequestOptions options;
+  options.timeout = base::TimeDelta::FromSeconds(5);
+  api_request_helper_.Request(
+      "GET", GURL(kUrl), "", "", options,
+      base::BindLambdaForTesting(
+          [&result](const int status, const std::string& body,
+                    const base::flat_map<std::string, std::string>&) {
+            result = {status, body};
+          }));
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(4));
+  EXPECT_EQ(0, result.first);
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_EQ(std::make_pair(-1, std::string()), result);
+}
+
+TEST_F(APIRequestHelperUnitTest, RecordsTiming) {
+  base::HistogramTester histogram_tester;
+  url_loader_factory_.AddResponse(kUrl, "body");
+  APIRequestOptions options;
+  options.timing_histogram_name = "Brave.Test.RequestTime";
+  Request(options);
+  histogram_tester.ExpectTotalCount("Brave.Test.RequestTime", 1);
+}
+
+}  // namespace api_request_helper
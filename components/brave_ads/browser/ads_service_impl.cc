@@ -249,6 +249,8 @@ AdsServiceImpl::AdsServiceImpl(
   DCHECK(history_service_);
   DCHECK(brave::IsRegularProfile(profile_));
 
+  history_service_observation_.Observe(history_service_);
+
   MigratePrefs();
 
   MaybeInitialize();
@@ -389,6 +391,34 @@ void AdsServiceImpl::OnTabClosed(const SessionID& tab_id) {
   bat_ads_->OnTabClosed(tab_id.id());
 }
 
+void AdsServiceImpl::OnURLsDeleted(history::HistoryService* history_service,
+                                   const history::DeletionInfo& deletion_info) {
+  if (!connected()) {
+    return;
+  }
+
+  // Expired history is older than the ads browsing history window
+  if (deletion_info.is_from_expiration()) {
+    return;
+  }
+
+  if (deletion_info.IsAllHistory()) {
+    bat_ads_->OnBrowsingHistoryDeleted();
+    return;
+  }
+
+  std::vector<std::string> urls;
+  for (const auto& row : deletion_info.deleted_rows()) {
+    urls.push_back(row.url().spec());
+  }
+
+  if (urls.empty()) {
+    return;
+  }
+
+  bat_ads_->OnBrowsingHistoryUrlsDeleted(urls);
+}
+
 void AdsServiceImpl::OnWalletUpdated() {
   if (!connected()) {
     return;
@@ -583,6 +613,8 @@ void AdsServiceImpl::Shutdown() {
 
   g_brave_browser_process->resource_component()->RemoveObserver(this);
 
+  history_service_observation_.Reset();
+
   url_loaders_.clear();
 
   idle_poll_timer_.Stop();
@@ -7,6 +7,7 @@ import * as React from 'react'
 import * as Card from '../cardSizes'
 import getBraveNewsController, * as BraveNews from '../../../../api/brave_news'
 import { getDataUrl } from '../../../../../common/privateCDN'
+import { mojoBigBufferToArrayBuffer } from '../../../../../common/mojomUtils'
 
 type Props = {
   imageUrl: string
@@ -42,10 +43,11 @@ function useGetUnpaddedImage (paddedUrl: string, isUnpadded: boolean, onLoaded?:
 
     getBraveNewsController().getImageData({ url: paddedUrl })
     .then(async (result) => {
-      if (!result.imageData) {
+      const resultBuffer = result.imageData &&
+        mojoBigBufferToArrayBuffer(result.imageData)
+      if (!resultBuffer) {
         return
       }
-      const resultBuffer = new Uint8Array(result.imageData).buffer
       const dataUrl = await getDataUrl(resultBuffer)
       onReceiveUnpaddedUrl(dataUrl)
     })
@@ -4,7 +4,8 @@
 // you can obtain one at http://mozilla.org/MPL/2.0/.
 
 import * as React from 'react'
-import { Feed } from '../../../api/brave_news'
+import { Url } from 'gen/url/mojom/url.mojom.m.js'
+import getBraveNewsController, { Feed } from '../../../api/brave_news'
 import CardLoading from './cards/cardLoading'
 import CardError from './cards/cardError'
 import CardLarge from './cards/_articles/cardArticleLarge'
@@ -125,6 +126,21 @@ export default function BraveTodayContent (props: Props) {
     intersectionObserver.current.observe(trigger)
   }, [intersectionObserver.current])
 
+  // Fetch the images of the next page ahead of it being shown
+  React.useEffect(() => {
+    const nextPage = feed && feed.pages[props.displayedPageCount]
+    if (!nextPage) {
+      return
+    }
+    const paddedImageUrls = nextPage.items
+      .flatMap(pageItem => pageItem.items)
+      .map(item => (item.article || item.promotedArticle || item.deal)?.data.image.paddedImageUrl)
+      .filter((url): url is Url => !!url)
+    if (paddedImageUrls.length) {
+      getBraveNewsController().prefetchImageData(paddedImageUrls)
+    }
+  }, [feed, props.displayedPageCount])
+
   const hasContent = feed && publishers
   // Loading state
   if (props.isFetching && !hasContent) {
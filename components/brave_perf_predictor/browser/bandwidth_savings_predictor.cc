@@ -8,6 +8,7 @@
 #include <iostream>
 
 #include "base/logging.h"
+#include "base/strings/strcat.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "components/page_load_metrics/common/page_load_metrics.mojom.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
@@ -52,7 +53,8 @@ void BandwidthSavingsPredictor::OnSubresourceBlocked(
   if (tp_registry_) {
     const auto tp_name = tp_registry_->GetThirdParty(resource_url);
     if (tp_name.has_value())
-      feature_map_["thirdParties." + tp_name.value() + ".blocked"] = 1;
+      feature_map_[base::StrCat(
+          {"thirdParties.", tp_name.value(), ".blocked"})] = 1;
   }
 }
 
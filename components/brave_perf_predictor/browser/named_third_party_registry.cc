@@ -5,40 +5,104 @@
 
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 
-#include <tuple>
+#include <algorithm>
+#include <map>
+#include <utility>
 
-#include "base/bind.h"
-#include "base/containers/flat_set.h"
 #include "base/json/json_reader.h"
+#include "base/containers/span.h"
 #include "base/logging.h"
-#include "base/metrics/histogram_macros.h"
-#include "base/strings/string_piece.h"
-#include "base/strings/string_util.h"
-#include "base/task/post_task.h"
-#include "base/task/thread_pool.h"
 #include "base/values.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
-#include "components/grit/brave_components_resources.h"
+#include "brave/components/brave_perf_predictor/browser/third_party_entities_data.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
-#include "third_party/abseil-cpp/absl/types/optional.h"
-#include "ui/base/resource/resource_bundle.h"
 #include "url/gurl.h"
 
 namespace brave_perf_predictor {
 
 namespace {
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
-  base::flat_map<std::string, std::string> entity_by_domain;
-  base::flat_map<std::string, std::string> entity_by_root_domain;
+using EntityId = NamedThirdPartyRegistry::EntityId;
+using EntityIdByDomain = NamedThirdPartyRegistry::EntityIdByDomain;
 
+// Collects domain to entity mappings and sorts them once when building the
+// lookup tables, rather than inserting into sorted containers one by one.
+class MappingsBuilder {
+ public:
+  explicit MappingsBuilder(bool discard_irrelevant)
+      : discard_irrelevant_(discard_irrelevant) {}
+
+  MappingsBuilder(const MappingsBuilder&) = delete;
+  MappingsBuilder& operator=(const MappingsBuilder&) = delete;
+
+  // Interns |entity_name|, or returns absl::nullopt if it is discarded.
+  absl::optional<EntityId> AddEntity(const base::StringPiece entity_name) {
+    if (discard_irrelevant_ && !relevant_entity_set.contains(entity_name)) {
+      VLOG(3) << "Irrelevant entity " << entity_name;
+      return absl::nullopt;
+    }
+    const auto existing = entity_ids_.find(entity_name);
+    if (existing != entity_ids_.end())
+      return existing->second;
+    const EntityId entity_id = static_cast<EntityId>(entity_names_.size());
+    entity_names_.emplace_back(entity_name);
+    entity_ids_.emplace(entity_name, entity_id);
+    return entity_id;
+  }
+
+  void AddDomain(const base::StringPiece domain, EntityId entity_id) {
+    domains_.emplace_back(domain, entity_id);
+    std::string root_domain =
+        net::registry_controlled_domains::GetDomainAndRegistry(
+            domain,
+            net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+    if (!root_domain.empty())
+      root_domains_.emplace_back(std::move(root_domain), entity_id);
+  }
+
+  void Build(std::vector<std::string>* entity_names,
+             EntityIdByDomain* entity_by_domain,
+             EntityIdByDomain* entity_by_root_domain) {
+    // Sorts once; the first mapping wins for duplicate domains.
+    *entity_by_domain = EntityIdByDomain(std::move(domains_));
+
+    // If there is a clash at root domain level, neither entity is correct.
+    std::stable_sort(
+        root_domains_.begin(), root_domains_.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+    std::vector<std::pair<std::string, EntityId>> root_domains;
+    for (auto it = root_domains_.begin(); it != root_domains_.end();) {
+      const auto group_begin = it;
+      bool clash = false;
+      for (; it != root_domains_.end() && it->first == group_begin->first;
+           ++it) {
+        clash |= it->second != group_begin->second;
+      }
+      if (!clash)
+        root_domains.push_back(std::move(*group_begin));
+    }
+    *entity_by_root_domain =
+        EntityIdByDomain(base::sorted_unique, std::move(root_domains));
+
+    entity_names_.shrink_to_fit();
+    *entity_names = std::move(entity_names_);
+  }
+
+ private:
+  const bool discard_irrelevant_;
+  std::vector<std::string> entity_names_;
+  std::map<std::string, EntityId, std::less<>> entity_ids_;
+  std::vector<std::pair<std::string, EntityId>> domains_;
+  std::vector<std::pair<std::string, EntityId>> root_domains_;
+};
+
+bool ParseMappings(const base::StringPiece entities,
+                   MappingsBuilder* builder) {
   // Parse the JSON
   absl::optional<base::Value> document = base::JSONReader::Read(entities);
   if (!document || !document->is_list()) {
     LOG(ERROR) << "Cannot parse the third-party entities list";
-    return {};
+    return false;
   }
 
   // Collect the mappings
@@ -46,56 +110,45 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
     const std::string* entity_name = entity.FindStringPath("name");
     if (!entity_name)
       continue;
-    if (discard_irrelevant && !relevant_entity_set.contains(*entity_name)) {
-      VLOG(3) << "Irrelevant entity " << *entity_name;
-      continue;
-    }
     const auto* entity_domains = entity.FindListPath("domains");
     if (!entity_domains)
       continue;
+    const absl::optional<EntityId> entity_id = builder->AddEntity(*entity_name);
+    if (!entity_id)
+      continue;
 
     for (auto& entity_domain_it : entity_domains->GetList()) {
       if (!entity_domain_it.is_string()) {
         continue;
       }
-      const base::StringPiece entity_domain(entity_domain_it.GetString());
-
-      const auto inserted =
-          entity_by_domain.emplace(entity_domain, *entity_name);
-      if (!inserted.second) {
-        VLOG(2) << "Malformed data: duplicate domain " << entity_domain;
-      }
-      auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
-          entity_domain,
-          net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
-
-      auto root_entity_entry = entity_by_root_domain.find(root_domain);
-      if (root_entity_entry != entity_by_root_domain.end() &&
-          root_entity_entry->second != *entity_name) {
-        // If there is a clash at root domain level, neither is correct
-        entity_by_root_domain.erase(root_entity_entry);
-      } else {
-        entity_by_root_domain.emplace(root_domain, *entity_name);
-      }
+      builder->AddDomain(entity_domain_it.GetString(), *entity_id);
     }
   }
+  return true;
+}
 
-  entity_by_domain.shrink_to_fit();
-  entity_by_root_domain.shrink_to_fit();
-  return std::make_tuple(entity_by_domain, entity_by_root_domain);
+// Binary searches one of the compiled tables, which are sorted by domain.
+absl::optional<base::StringPiece> FindCompiledEntity(
+    base::span<const ThirdPartyDomainEntry> table,
+    const base::StringPiece domain) {
+  const auto it = std::lower_bound(
+      table.begin(), table.end(), domain,
+      [](const ThirdPartyDomainEntry& entry, const base::StringPiece domain) {
+        return entry.domain < domain;
+      });
+  if (it == table.end() || it->domain != domain)
+    return absl::nullopt;
+  return kThirdPartyEntityNames[it->entity_id];
 }
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseFromResource(int resource_id) {
-  // TODO(AndriusA): insert trace event here
-  SCOPED_UMA_HISTOGRAM_TIMER(
-      "Brave.Savings.NamedThirdPartyRegistry.LoadTimeMS");
-  auto& resource_bundle = ui::ResourceBundle::GetSharedInstance();
-  std::string data_resource =
-      resource_bundle.LoadDataResourceString(resource_id);
-  // Parse resource, discarding irrelevant entities
-  return ParseMappings(data_resource, true);
+absl::optional<base::StringPiece> FindEntity(
+    const std::vector<std::string>& entity_names,
+    const EntityIdByDomain& entity_by_domain,
+    const base::StringPiece domain) {
+  const auto it = entity_by_domain.find(domain);
+  if (it == entity_by_domain.end())
+    return absl::nullopt;
+  return base::StringPiece(entity_names[it->second]);
 }
 
 }  // namespace
@@ -103,12 +156,16 @@ ParseFromResource(int resource_id) {
 bool NamedThirdPartyRegistry::LoadMappings(const base::StringPiece entities,
                                            bool discard_irrelevant) {
   // Reset previous mappings
+  entity_names_.clear();
   entity_by_domain_.clear();
   entity_by_root_domain_.clear();
+  use_compiled_mappings_ = false;
   initialized_ = false;
 
-  tie(entity_by_domain_, entity_by_root_domain_) =
-      ParseMappings(entities, discard_irrelevant);
+  MappingsBuilder builder(discard_irrelevant);
+  if (!ParseMappings(entities, &builder))
+    return false;
+  builder.Build(&entity_names_, &entity_by_domain_, &entity_by_root_domain_);
   if (entity_by_domain_.size() == 0 || entity_by_root_domain_.size() == 0)
     return false;
 
@@ -116,16 +173,7 @@ bool NamedThirdPartyRegistry::LoadMappings(const base::StringPiece entities,
   return true;
 }
 
-void NamedThirdPartyRegistry::UpdateMappings(
-    std::tuple<base::flat_map<std::string, std::string>,
-               base::flat_map<std::string, std::string>> entity_mappings) {
-  tie(entity_by_domain_, entity_by_root_domain_) = entity_mappings;
-  VLOG(2) << "Loaded " << entity_by_domain_.size() << " mappings by domain and "
-          << entity_by_root_domain_.size() << " by root domain; size";
-  initialized_ = true;
-}
-
-absl::optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
+absl::optional<base::StringPiece> NamedThirdPartyRegistry::GetThirdParty(
     const base::StringPiece request_url) const {
   if (!IsInitialized()) {
     VLOG(2) << "Named Third Party Registry not initialized";
@@ -137,16 +185,26 @@ absl::optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
     return absl::nullopt;
 
   if (url.has_host()) {
-    auto domain_entry = entity_by_domain_.find(url.host());
-    if (domain_entry != entity_by_domain_.end())
-      return domain_entry->second;
-
-    auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
-        url, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
-
-    auto root_domain_entry = entity_by_root_domain_.find(root_domain);
-    if (root_domain_entry != entity_by_root_domain_.end())
-      return root_domain_entry->second;
+    const base::StringPiece host = url.host_piece();
+    absl::optional<base::StringPiece> entity =
+        use_compiled_mappings_
+            ? FindCompiledEntity(kThirdPartyDomains, host)
+            : FindEntity(entity_names_, entity_by_domain_, host);
+    if (entity)
+      return entity;
+
+    if (url.HostIsIPAddress())
+      return absl::nullopt;
+
+    // Looked up as a view into |url| so no string is allocated per request.
+    const base::StringPiece root_domain =
+        net::registry_controlled_domains::GetDomainAndRegistryAsStringPiece(
+            host, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+
+    return use_compiled_mappings_
+               ? FindCompiledEntity(kThirdPartyRootDomains, root_domain)
+               : FindEntity(entity_names_, entity_by_root_domain_,
+                            root_domain);
   }
 
   return absl::nullopt;
@@ -157,11 +215,13 @@ NamedThirdPartyRegistry::NamedThirdPartyRegistry() = default;
 NamedThirdPartyRegistry::~NamedThirdPartyRegistry() = default;
 
 void NamedThirdPartyRegistry::InitializeDefault() {
-  base::ThreadPool::PostTaskAndReplyWithResult(
-      FROM_HERE, {base::MayBlock()},
-      base::BindOnce(&ParseFromResource, IDR_THIRD_PARTY_ENTITIES),
-      base::BindOnce(&NamedThirdPartyRegistry::UpdateMappings,
-                     weak_factory_.GetWeakPtr()));
+  // The compiled tables only hold entities seen in training the model, and
+  // are looked up in place.
+  entity_names_.clear();
+  entity_by_domain_.clear();
+  entity_by_root_domain_.clear();
+  use_compiled_mappings_ = true;
+  initialized_ = true;
 }
 
 }  // namespace brave_perf_predictor
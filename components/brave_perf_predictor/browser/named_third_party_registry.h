@@ -6,13 +6,14 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 
+#include <cstdint>
 #include <string>
-#include <tuple>
+#include <vector>
 
 #include "base/containers/flat_map.h"
-#include "base/memory/weak_ptr.h"
-#include "base/values.h"
+#include "base/strings/string_piece.h"
 #include "components/keyed_service/core/keyed_service.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace brave_perf_predictor {
 
@@ -21,6 +22,11 @@ namespace brave_perf_predictor {
 // (https://github.com/patrickhulce/third-party-web).
 class NamedThirdPartyRegistry : public KeyedService {
  public:
+  // Entity names are interned: the domain tables map to an index into
+  // |entity_names_| rather than holding a copy of the name per domain.
+  using EntityId = uint16_t;
+  using EntityIdByDomain = base::flat_map<std::string, EntityId>;
+
   NamedThirdPartyRegistry();
   ~NamedThirdPartyRegistry() override;
 
@@ -31,23 +37,23 @@ class NamedThirdPartyRegistry : public KeyedService {
   // entities not relevant to the bandwith prediction model (i.e. those not
   // seen in training the model).
   bool LoadMappings(const base::StringPiece entities, bool discard_irrelevant);
-  // Default initialization - asynchronously load from bundled resource
+  // Default initialization - use the tables compiled into the binary at
+  // build time, without parsing or copying anything.
   void InitializeDefault();
-  absl::optional<std::string> GetThirdParty(
-      const base::StringPiece domain) const;
+  // The returned name is owned by the registry.
+  absl::optional<base::StringPiece> GetThirdParty(
+      const base::StringPiece request_url) const;
 
  private:
   bool IsInitialized() const { return initialized_; }
   void MarkInitialized(bool initialized) { initialized_ = initialized; }
-  void UpdateMappings(
-      std::tuple<base::flat_map<std::string, std::string>,
-                 base::flat_map<std::string, std::string>> entity_mappings);
 
   bool initialized_ = false;
-  base::flat_map<std::string, std::string> entity_by_domain_;
-  base::flat_map<std::string, std::string> entity_by_root_domain_;
-
-  base::WeakPtrFactory<NamedThirdPartyRegistry> weak_factory_{this};
+  bool use_compiled_mappings_ = false;
+  // Mappings loaded from JSON by LoadMappings().
+  std::vector<std::string> entity_names_;
+  EntityIdByDomain entity_by_domain_;
+  EntityIdByDomain entity_by_root_domain_;
 };
 
 }  // namespace brave_perf_predictor
@@ -7,7 +7,9 @@
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/json/json_reader.h"
 #include "base/path_service.h"
+#include "base/values.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace brave_perf_predictor {
@@ -111,6 +113,44 @@ TEST(NamedThirdPartyRegistryTest, ExtractsThirdPartyRootDomainTest) {
   EXPECT_EQ(entity.value(), "Facebook");
 }
 
+TEST(NamedThirdPartyRegistryTest, LoadsCompiledDataset) {
+  NamedThirdPartyRegistry registry;
+  registry.InitializeDefault();
+  auto entity = registry.GetThirdParty("https://google-analytics.com/ga.js");
+  ASSERT_TRUE(entity.has_value());
+  EXPECT_EQ(entity.value(), "Google Analytics");
+  entity = registry.GetThirdParty("https://test.m.facebook.com");
+  ASSERT_TRUE(entity.has_value());
+  EXPECT_EQ(entity.value(), "Facebook");
+  EXPECT_FALSE(registry.GetThirdParty("http://example.com").has_value());
+}
+
+TEST(NamedThirdPartyRegistryTest, CompiledDatasetMatchesJSON) {
+  NamedThirdPartyRegistry compiled;
+  compiled.InitializeDefault();
+  NamedThirdPartyRegistry parsed;
+  const std::string dataset = LoadFile();
+  ASSERT_TRUE(parsed.LoadMappings(dataset, true));
+
+  absl::optional<base::Value> document = base::JSONReader::Read(dataset);
+  ASSERT_TRUE(document && document->is_list());
+  for (const auto& entity : document->GetList()) {
+    const auto* domains = entity.FindListPath("domains");
+    if (!domains)
+      continue;
+    for (const auto& domain : domains->GetList()) {
+      if (!domain.is_string())
+        continue;
+      for (const std::string& url :
+           {"https://" + domain.GetString() + "/",
+            "https://sub." + domain.GetString() + "/"}) {
+        EXPECT_EQ(parsed.GetThirdParty(url), compiled.GetThirdParty(url))
+            << url;
+      }
+    }
+  }
+}
+
 TEST(NamedThirdPartyRegistryTest, HandlesUnrecognisedThirdPartyTest) {
   NamedThirdPartyRegistry* extractor = new NamedThirdPartyRegistry();
   auto dataset = LoadFile();
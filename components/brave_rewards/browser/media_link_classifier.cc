@@ -0,0 +1,55 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/media_link_classifier.h"
+
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+#include "url/gurl.h"
+
+namespace brave_rewards {
+
+namespace {
+
+struct MediaLinkRule {
+  const char* host;
+  // Whether subdomains of |host| match as well.
+  bool include_subdomains;
+  const char* path_prefix;
+};
+
+// Keep in sync with GetLinkType() of the media modules in
+// bat/ledger/internal/legacy/media.
+constexpr MediaLinkRule kMediaLinkRules[] = {
+    // YouTube
+    {"www.youtube.com", false, "/api/stats/watchtime"},
+    {"m.youtube.com", false, "/api/stats/watchtime"},
+    // Twitch
+    {"ttvnw.net", true, "/v1/segment/"},
+    // Vimeo
+    {"fresnel.vimeocdn.com", false, "/add/player-stats"},
+    // GitHub
+    {"github.com", true, "/"},
+};
+
+}  // namespace
+
+bool MayBeMediaLink(const GURL& url) {
+  if (!url.is_valid() || !url.SchemeIsHTTPOrHTTPS())
+    return false;
+
+  const base::StringPiece host = url.host_piece();
+  const base::StringPiece path = url.path_piece();
+  for (const auto& rule : kMediaLinkRules) {
+    const bool host_matches =
+        rule.include_subdomains ? url.DomainIs(rule.host) : host == rule.host;
+    if (host_matches && base::StartsWith(path, rule.path_prefix))
+      return true;
+  }
+
+  return false;
+}
+
+}  // namespace brave_rewards
@@ -0,0 +1,21 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_MEDIA_LINK_CLASSIFIER_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_MEDIA_LINK_CLASSIFIER_H_
+
+class GURL;
+
+namespace brave_rewards {
+
+// Returns false if the ledger's media modules would ignore a load of |url|,
+// checking only its host and path so that most subresource loads are
+// rejected without copying or parsing the url. A true result still has to
+// be confirmed by the ledger, which also looks at the query and the page.
+bool MayBeMediaLink(const GURL& url);
+
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_MEDIA_LINK_CLASSIFIER_H_
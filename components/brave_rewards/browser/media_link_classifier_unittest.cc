@@ -0,0 +1,42 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/media_link_classifier.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=MediaLinkClassifierTest.*
+
+namespace brave_rewards {
+
+TEST(MediaLinkClassifierTest, MediaLinks) {
+  EXPECT_TRUE(MayBeMediaLink(GURL(
+      "https://www.youtube.com/api/stats/watchtime?docid=abc&st=0&et=10")));
+  EXPECT_TRUE(MayBeMediaLink(
+      GURL("https://m.youtube.com/api/stats/watchtime?docid=abc")));
+  EXPECT_TRUE(MayBeMediaLink(
+      GURL("https://video-edge-1.abc.ttvnw.net/v1/segment/CqYE.ts")));
+  EXPECT_TRUE(MayBeMediaLink(
+      GURL("https://fresnel.vimeocdn.com/add/player-stats?beacon=1")));
+  EXPECT_TRUE(MayBeMediaLink(GURL("https://github.com/brave/brave-core")));
+  EXPECT_TRUE(MayBeMediaLink(GURL("https://api.github.com/users/brave")));
+}
+
+TEST(MediaLinkClassifierTest, OtherLinks) {
+  EXPECT_FALSE(MayBeMediaLink(GURL()));
+  EXPECT_FALSE(MayBeMediaLink(GURL("https://www.youtube.com/watch?v=abc")));
+  EXPECT_FALSE(
+      MayBeMediaLink(GURL("https://www.youtube.com.example.com/api/stats/"
+                          "watchtime?docid=abc")));
+  EXPECT_FALSE(
+      MayBeMediaLink(GURL("https://video-edge-1.abc.ttvnw.net/v1/playlist")));
+  EXPECT_FALSE(MayBeMediaLink(GURL("https://notttvnw.net/v1/segment/a.ts")));
+  EXPECT_FALSE(MayBeMediaLink(GURL("https://vimeo.com/add/player-stats")));
+  EXPECT_FALSE(MayBeMediaLink(GURL("https://brave.com/")));
+  EXPECT_FALSE(MayBeMediaLink(GURL("chrome://github.com/")));
+}
+
+}  // namespace brave_rewards
@@ -49,16 +49,19 @@ void DispatchOnUI(
 
 }  // namespace
 
+bool ShouldRunOnBeforeURLRequest(const brave::BraveRequestInfo& ctx) {
+  return !ctx.upload_data.empty() &&
+         IsMediaLink(ctx.request_url, ctx.tab_origin, ctx.referrer);
+}
+
 int OnBeforeURLRequest(
   const brave::ResponseCallback& next_callback,
   std::shared_ptr<brave::BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
-  if (IsMediaLink(ctx->request_url, ctx->tab_origin, ctx->referrer)) {
-    if (!ctx->upload_data.empty()) {
-      DispatchOnUI(ctx->upload_data, ctx->request_url, ctx->tab_url,
-                   ctx->referrer.spec(), ctx->frame_tree_node_id);
-    }
+  if (ShouldRunOnBeforeURLRequest(*ctx)) {
+    DispatchOnUI(ctx->upload_data, ctx->request_url, ctx->tab_url,
+                 ctx->referrer.spec(), ctx->frame_tree_node_id);
   }
 
   return net::OK;
@@ -9,6 +9,9 @@
 
 namespace brave_rewards {
 
+// Returns false if |ctx| carries no upload data for a media publisher.
+bool ShouldRunOnBeforeURLRequest(const brave::BraveRequestInfo& ctx);
+
 int OnBeforeURLRequest(
     const brave::ResponseCallback& next_callback,
     std::shared_ptr<brave::BraveRequestInfo> ctx);
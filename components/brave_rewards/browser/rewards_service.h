@@ -169,6 +169,7 @@ class RewardsService : public KeyedService {
   virtual void OnHide(SessionID tab_id) = 0;
   virtual void OnForeground(SessionID tab_id) = 0;
   virtual void OnBackground(SessionID tab_id) = 0;
+  virtual void OnBrowsingHistoryDeleted() = 0;
   virtual void OnXHRLoad(SessionID tab_id,
                          const GURL& url,
                          const GURL& first_party_url,
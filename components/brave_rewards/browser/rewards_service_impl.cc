@@ -45,6 +45,7 @@
 #include "brave/components/brave_rewards/browser/android_util.h"
 #include "brave/components/brave_rewards/browser/diagnostic_log.h"
 #include "brave/components/brave_rewards/browser/logging.h"
+#include "brave/components/brave_rewards/browser/media_link_classifier.h"
 #include "brave/components/brave_rewards/browser/rewards_notification_service.h"
 #include "brave/components/brave_rewards/browser/rewards_notification_service_impl.h"
 #include "brave/components/brave_rewards/browser/rewards_p3a.h"
@@ -284,6 +285,9 @@ std::string GetPrefPath(const std::string& name) {
 bool IsMediaLink(const GURL& url,
                  const GURL& first_party_url,
                  const GURL& referrer) {
+  if (!MayBeMediaLink(url))
+    return false;
+
   return ledger::Ledger::IsMediaLink(url.spec(),
                                      first_party_url.spec(),
                                      referrer.spec());
@@ -726,6 +730,17 @@ void RewardsServiceImpl::OnBackground(SessionID tab_id) {
   bat_ledger_->OnBackground(tab_id.id(), GetCurrentTimestamp());
 }
 
+void RewardsServiceImpl::OnBrowsingHistoryDeleted() {
+  if (!Connected()) {
+    // Pending visits from the last session are journaled until the ledger
+    // starts and saves them
+    profile_->GetPrefs()->ClearPref(prefs::kPendingVisits);
+    return;
+  }
+
+  bat_ledger_->OnBrowsingHistoryDeleted();
+}
+
 void RewardsServiceImpl::OnPostData(SessionID tab_id,
                                     const GURL& url,
                                     const GURL& first_party_url,
@@ -766,6 +781,11 @@ void RewardsServiceImpl::OnXHRLoad(SessionID tab_id,
                                    const GURL& url,
                                    const GURL& first_party_url,
                                    const GURL& referrer) {
+  // Most loads are not media links, so reject them before building |parts|.
+  if (!MayBeMediaLink(url)) {
+    return;
+  }
+
   if (!Connected()) {
     return;
   }
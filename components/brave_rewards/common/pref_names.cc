@@ -46,6 +46,7 @@ const char kScoreB[] = "brave.rewards.ac.score.b";
 const char kAutoContributeEnabled[] = "brave.rewards.ac.enabled";
 const char kAutoContributeAmount[] = "brave.rewards.ac.amount";
 const char kNextReconcileStamp[] = "brave.rewards.ac.next_reconcile_stamp";
+const char kPendingVisits[] = "brave.rewards.ac.pending_visits";
 const char kCreationStamp[] = "brave.rewards.creation_stamp";
 const char kRecoverySeed[] = "brave.rewards.wallet.seed";
 const char kPaymentId[] = "brave.rewards.wallet.payment_id";
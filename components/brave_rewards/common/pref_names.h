@@ -40,6 +40,7 @@ extern const char kScoreB[];
 extern const char kAutoContributeEnabled[];
 extern const char kAutoContributeAmount[];
 extern const char kNextReconcileStamp[];
+extern const char kPendingVisits[];
 extern const char kCreationStamp[];
 extern const char kRecoverySeed[];  // DEPRECATED
 extern const char kPaymentId[];   // DEPRECATED
@@ -6,6 +6,7 @@
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 
 #include <algorithm>
+#include <atomic>
 #include <set>
 #include <string>
 #include <utility>
@@ -21,6 +22,8 @@
 #include "base/task/thread_pool.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/ad_block_engine_cache.h"
+#include "brave/components/brave_shields/browser/ad_block_resource_store.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
@@ -34,6 +37,8 @@ using namespace net::registry_controlled_domains;  // NOLINT
 
 namespace {
 
+std::atomic<uint64_t> g_engine_generation{0};
+
 std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
   std::string filter_option = "";
   switch (resource_type) {
@@ -144,6 +149,53 @@ void AdBlockBaseService::ShouldStartRequest(
   //  << ", url.spec(): " << url.spec();
 }
 
+void AdBlockBaseService::ShouldStartRequests(
+    const std::vector<std::pair<GURL, blink::mojom::ResourceType>>& requests,
+    const std::string& tab_host,
+    std::vector<RequestMatch>* results) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  DCHECK(results);
+  results->resize(requests.size());
+
+  std::vector<size_t> pending;
+  for (size_t i = 0; i < requests.size(); ++i) {
+    if (!(*results)[i].did_match_important)
+      pending.push_back(i);
+  }
+  if (pending.empty())
+    return;
+
+  const auto tab_origin =
+      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80);
+  std::vector<adblock::MatchRequest> engine_requests(pending.size());
+  std::vector<adblock::MatchResult> engine_results(pending.size());
+  for (size_t j = 0; j < pending.size(); ++j) {
+    const GURL& url = requests[pending[j]].first;
+    engine_requests[j].url = url.spec();
+    engine_requests[j].host = url.host();
+    engine_requests[j].resource_type =
+        ResourceTypeToString(requests[pending[j]].second);
+    engine_requests[j].is_third_party =
+        !SameDomainOrHost(url, tab_origin, INCLUDE_PRIVATE_REGISTRIES);
+
+    const RequestMatch& result = (*results)[pending[j]];
+    engine_results[j].did_match_rule = result.did_match_rule;
+    engine_results[j].did_match_exception = result.did_match_exception;
+    engine_results[j].did_match_important = result.did_match_important;
+  }
+
+  ad_block_client_->matchesBatch(tab_host, engine_requests, &engine_results);
+
+  for (size_t j = 0; j < pending.size(); ++j) {
+    RequestMatch& result = (*results)[pending[j]];
+    result.did_match_rule = engine_results[j].did_match_rule;
+    result.did_match_exception = engine_results[j].did_match_exception;
+    result.did_match_important = engine_results[j].did_match_important;
+    if (!engine_results[j].redirect.empty())
+      result.replacement_url = std::move(engine_results[j].redirect);
+  }
+}
+
 absl::optional<std::string> AdBlockBaseService::GetCspDirectives(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
@@ -189,18 +241,22 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
       tags_.erase(it);
     }
   }
+  OnEngineChanged();
 }
 
-void AdBlockBaseService::AddResources(const std::string& resources) {
+void AdBlockBaseService::AddResources(
+    scoped_refptr<AdBlockResourceStore> resources) {
   if (BrowserThread::CurrentlyOn(BrowserThread::UI)) {
     GetTaskRunner()->PostTask(
-        FROM_HERE, base::BindOnce(&AdBlockBaseService::AddResources,
-                                  base::Unretained(this), resources));
+        FROM_HERE,
+        base::BindOnce(&AdBlockBaseService::AddResources,
+                       base::Unretained(this), std::move(resources)));
     return;
   }
 
-  ad_block_client_->addResources(resources);
-  resources_ = resources;
+  resources_ = std::move(resources);
+  AddKnownResourcesToAdBlockInstance();
+  OnEngineChanged();
 }
 
 bool AdBlockBaseService::TagExists(const std::string& tag) {
@@ -242,6 +298,16 @@ void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path,
                      weak_factory_.GetWeakPtr(), std::move(callback)));
 }
 
+void AdBlockBaseService::GetListFileData(const base::FilePath& list_file_path,
+                                         const base::FilePath& cache_path,
+                                         base::OnceClosure callback) {
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock()},
+      base::BindOnce(&LoadRawFileDataWithCache, list_file_path, cache_path),
+      base::BindOnce(&AdBlockBaseService::OnGetDATFileData,
+                     weak_factory_.GetWeakPtr(), std::move(callback)));
+}
+
 void AdBlockBaseService::OnGetDATFileData(base::OnceClosure callback,
                                           GetDATFileDataResult result) {
   if (result.second.empty()) {
@@ -266,6 +332,7 @@ void AdBlockBaseService::UpdateAdBlockClient(
   ad_block_client_ = std::move(ad_block_client);
   AddKnownTagsToAdBlockInstance();
   AddKnownResourcesToAdBlockInstance();
+  OnEngineChanged();
 }
 
 void AdBlockBaseService::AddKnownTagsToAdBlockInstance() {
@@ -274,13 +341,24 @@ void AdBlockBaseService::AddKnownTagsToAdBlockInstance() {
 }
 
 void AdBlockBaseService::AddKnownResourcesToAdBlockInstance() {
-  ad_block_client_->addResources(resources_);
+  if (resources_)
+    ad_block_client_->useResources(resources_->store());
 }
 
 bool AdBlockBaseService::Init() {
   return true;
 }
 
+// static
+uint64_t AdBlockBaseService::GetEngineGeneration() {
+  return g_engine_generation.load(std::memory_order_acquire);
+}
+
+// static
+void AdBlockBaseService::OnEngineChanged() {
+  g_engine_generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
 void AdBlockBaseService::ResetForTest(const std::string& rules,
                                       const std::string& resources,
                                       bool include_redirect_urls) {
@@ -291,9 +369,10 @@ void AdBlockBaseService::ResetForTest(const std::string& rules,
   ad_block_client_.reset(new adblock::Engine(rules, include_redirect_urls));
   AddKnownTagsToAdBlockInstance();
   if (!resources.empty()) {
-    resources_ = resources;
+    resources_ = base::MakeRefCounted<AdBlockResourceStore>(resources);
   }
   AddKnownResourcesToAdBlockInstance();
+  OnEngineChanged();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/values.h"
@@ -33,6 +34,8 @@ class Engine;
 
 namespace brave_shields {
 
+class AdBlockResourceStore;
+
 // The base class of the brave shields service in charge of ad-block
 // checking and init.
 class AdBlockBaseService : public BaseBraveShieldsService {
@@ -40,6 +43,15 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   using GetDATFileDataResult =
       brave_component_updater::LoadDATFileDataResult<adblock::Engine>;
 
+  // The outcome of checking one request with ShouldStartRequests(). Like the
+  // out-params of ShouldStartRequest(), the flags are also inputs.
+  struct RequestMatch {
+    bool did_match_rule = false;
+    bool did_match_exception = false;
+    bool did_match_important = false;
+    std::string replacement_url;
+  };
+
   explicit AdBlockBaseService(BraveComponent::Delegate* delegate);
   ~AdBlockBaseService() override;
 
@@ -51,11 +63,21 @@ class AdBlockBaseService : public BaseBraveShieldsService {
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* replacement_url) override;
+  // Checks several requests made from |tab_host| against this engine with a
+  // single call. |results| is resized to one entry per request. Requests whose
+  // result already has |did_match_important| set are skipped, as callers of
+  // ShouldStartRequest() stop checking further engines at that point.
+  void ShouldStartRequests(
+      const std::vector<std::pair<GURL, blink::mojom::ResourceType>>& requests,
+      const std::string& tab_host,
+      std::vector<RequestMatch>* results);
   absl::optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
       const std::string& tab_host);
-  void AddResources(const std::string& resources);
+  // Uses the shared |resources| for redirects and scriptlets, replacing any
+  // set before.
+  void AddResources(scoped_refptr<AdBlockResourceStore> resources);
   void EnableTag(const std::string& tag, bool enabled);
   bool TagExists(const std::string& tag);
 
@@ -66,6 +88,14 @@ class AdBlockBaseService : public BaseBraveShieldsService {
       const std::vector<std::string>& ids,
       const std::vector<std::string>& exceptions);
 
+  // Returns a counter that changes whenever the filtering state of any
+  // ad-block engine changes (engine reloaded, tag toggled, resources or
+  // lists added/removed). Results derived from the engines can be cached
+  // against it.
+  static uint64_t GetEngineGeneration();
+  // Invalidates results cached against GetEngineGeneration().
+  static void OnEngineChanged();
+
  protected:
   friend class ::AdBlockServiceTest;
   friend class ::BraveAdBlockTPNetworkDelegateHelperTest;
@@ -76,6 +106,11 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   void GetDATFileData(const base::FilePath& dat_file_path,
                       bool deserialize = true,
                       base::OnceClosure callback = base::DoNothing());
+  // Loads the filter list text at |list_file_path|, reusing the engine
+  // compiled from it on a previous run if it's cached at |cache_path|.
+  void GetListFileData(const base::FilePath& list_file_path,
+                       const base::FilePath& cache_path,
+                       base::OnceClosure callback);
   void AddKnownTagsToAdBlockInstance();
   void AddKnownResourcesToAdBlockInstance();
   void ResetForTest(const std::string& rules,
@@ -91,7 +126,7 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   void OnPreferenceChanges(const std::string& pref_name);
 
   std::set<std::string> tags_;
-  std::string resources_;
+  scoped_refptr<AdBlockResourceStore> resources_;
   base::WeakPtrFactory<AdBlockBaseService> weak_factory_;
   DISALLOW_COPY_AND_ASSIGN(AdBlockBaseService);
 };
@@ -7,6 +7,7 @@
 
 #include "base/logging.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "brave/components/brave_shields/browser/ad_block_engine_cache.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/common/pref_names.h"
 #include "components/prefs/pref_service.h"
@@ -17,8 +18,9 @@ using brave_component_updater::BraveComponent;
 namespace brave_shields {
 
 AdBlockCustomFiltersService::AdBlockCustomFiltersService(
-    BraveComponent::Delegate* delegate)
-    : AdBlockBaseService(delegate) {}
+    BraveComponent::Delegate* delegate,
+    const base::FilePath& cache_path)
+    : AdBlockBaseService(delegate), cache_path_(cache_path) {}
 
 AdBlockCustomFiltersService::~AdBlockCustomFiltersService() {}
 
@@ -54,14 +56,18 @@ bool AdBlockCustomFiltersService::UpdateCustomFilters(
 void AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner(
     const std::string& custom_filters) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  ad_block_client_.reset(new adblock::Engine(custom_filters.c_str()));
+  ad_block_client_ = LoadEngineWithCache(custom_filters, cache_path_);
+  AddKnownTagsToAdBlockInstance();
+  AddKnownResourcesToAdBlockInstance();
+  OnEngineChanged();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 std::unique_ptr<AdBlockCustomFiltersService> AdBlockCustomFiltersServiceFactory(
-    BraveComponent::Delegate* delegate) {
-  return std::make_unique<AdBlockCustomFiltersService>(delegate);
+    BraveComponent::Delegate* delegate,
+    const base::FilePath& cache_path) {
+  return std::make_unique<AdBlockCustomFiltersService>(delegate, cache_path);
 }
 
 }  // namespace brave_shields
@@ -23,7 +23,8 @@ namespace brave_shields {
 // checking and init.
 class AdBlockCustomFiltersService : public AdBlockBaseService {
  public:
-  explicit AdBlockCustomFiltersService(BraveComponent::Delegate* delegate);
+  AdBlockCustomFiltersService(BraveComponent::Delegate* delegate,
+                              const base::FilePath& cache_path);
   ~AdBlockCustomFiltersService() override;
 
   std::string GetCustomFilters();
@@ -36,12 +37,16 @@ class AdBlockCustomFiltersService : public AdBlockBaseService {
   friend class ::AdBlockServiceTest;
   void UpdateCustomFiltersOnFileTaskRunner(const std::string& custom_filters);
 
+  // Where the engine compiled from the custom filters is serialized.
+  const base::FilePath cache_path_;
+
   DISALLOW_COPY_AND_ASSIGN(AdBlockCustomFiltersService);
 };
 
 // Creates the AdBlockCustomFiltersService
 std::unique_ptr<AdBlockCustomFiltersService>
-AdBlockCustomFiltersServiceFactory(BraveComponent::Delegate* delegate);
+AdBlockCustomFiltersServiceFactory(BraveComponent::Delegate* delegate,
+                                   const base::FilePath& cache_path);
 
 }  // namespace brave_shields
 
@@ -0,0 +1,93 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_engine_cache.h"
+
+#include <string>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/logging.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "crypto/sha256.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Serialized engines are not compatible across adblock-rust versions. Bump
+// this whenever the adblock dependency of adblock_rust_ffi is updated so
+// that existing cache files are recompiled.
+constexpr char kEngineCacheVersion[] = "1";
+
+// Every cache file starts with a header line identifying the rules and the
+// engine version it was built from.
+std::string GetCacheHeader(base::StringPiece rules) {
+  const std::string hash = crypto::SHA256HashString(rules);
+  return base::StrCat({"adblock-engine-cache:", kEngineCacheVersion, ":",
+                       base::HexEncode(hash.data(), hash.size()), "\n"});
+}
+
+}  // namespace
+
+std::unique_ptr<adblock::Engine> LoadEngineWithCache(
+    base::StringPiece rules,
+    const base::FilePath& cache_path) {
+  if (rules.empty())
+    return std::make_unique<adblock::Engine>(std::string());
+
+  const std::string header = GetCacheHeader(rules);
+
+  std::string cached;
+  if (base::ReadFileToString(cache_path, &cached) &&
+      base::StartsWith(cached, header)) {
+    auto engine = std::make_unique<adblock::Engine>();
+    if (engine->deserialize(cached.data() + header.size(),
+                            cached.size() - header.size())) {
+      return engine;
+    }
+    LOG(ERROR) << "Failed to deserialize cached ad block engine "
+               << cache_path;
+  }
+
+  auto engine = std::make_unique<adblock::Engine>(rules.data(), rules.size());
+
+  const std::string serialized = engine->serialize();
+  if (serialized.empty()) {
+    LOG(ERROR) << "Failed to serialize ad block engine";
+    return engine;
+  }
+  if (!base::CreateDirectory(cache_path.DirName()) ||
+      !base::ImportantFileWriter::WriteFileAtomically(
+          cache_path, base::StrCat({header, serialized}))) {
+    LOG(ERROR) << "Failed to write ad block engine cache " << cache_path;
+  }
+
+  return engine;
+}
+
+brave_component_updater::LoadDATFileDataResult<adblock::Engine>
+LoadRawFileDataWithCache(const base::FilePath& list_file_path,
+                         const base::FilePath& cache_path) {
+  brave_component_updater::DATFileDataBuffer buffer;
+  brave_component_updater::GetDATFileData(list_file_path, &buffer);
+  std::unique_ptr<adblock::Engine> client;
+
+  if (!buffer.empty()) {
+    client = LoadEngineWithCache(
+        base::StringPiece(reinterpret_cast<const char*>(&buffer.front()),
+                          buffer.size()),
+        cache_path);
+  }
+
+  return brave_component_updater::LoadDATFileDataResult<adblock::Engine>(
+      std::move(client), std::move(buffer));
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,39 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_CACHE_H_
+
+#include <memory>
+
+#include "base/files/file_path.h"
+#include "base/strings/string_piece.h"
+#include "brave/components/brave_component_updater/browser/dat_file_util.h"
+
+namespace adblock {
+class Engine;
+}
+
+namespace brave_shields {
+
+// Builds an ad-block engine from the filter list text |rules|.
+//
+// Compiling a large list is expensive, so the compiled engine is serialized
+// to |cache_path| together with a hash of |rules| and the engine version. As
+// long as the rules don't change, later calls deserialize that file instead
+// of recompiling. Blocking; must not be called on the UI thread.
+std::unique_ptr<adblock::Engine> LoadEngineWithCache(
+    base::StringPiece rules,
+    const base::FilePath& cache_path);
+
+// Cached counterpart of brave_component_updater::LoadRawFileData() which
+// reads the rules from |list_file_path|.
+brave_component_updater::LoadDATFileDataResult<adblock::Engine>
+LoadRawFileDataWithCache(const base::FilePath& list_file_path,
+                         const base::FilePath& cache_path);
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_CACHE_H_
@@ -0,0 +1,95 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_engine_cache.h"
+
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+namespace {
+
+constexpr char kRules[] =
+    "-advertisement-icon.\n"
+    "@@good-advertisement\n";
+constexpr char kOtherRules[] = "/banner/ad.gif\n";
+
+std::string ReadCache(const base::FilePath& path) {
+  std::string contents;
+  EXPECT_TRUE(base::ReadFileToString(path, &contents));
+  return contents;
+}
+
+}  // namespace
+
+class AdBlockEngineCacheTest : public testing::Test {
+ protected:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  base::FilePath GetPath(const char* name) const {
+    return temp_dir_.GetPath().AppendASCII(name);
+  }
+
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(AdBlockEngineCacheTest, WritesCacheOnFirstLoad) {
+  const base::FilePath path = GetPath("engine.dat");
+  EXPECT_TRUE(LoadEngineWithCache(kRules, path));
+  EXPECT_FALSE(ReadCache(path).empty());
+}
+
+TEST_F(AdBlockEngineCacheTest, ReusesCacheForSameRules) {
+  const base::FilePath path = GetPath("engine.dat");
+  const base::FilePath other_path = GetPath("other_engine.dat");
+  ASSERT_TRUE(LoadEngineWithCache(kRules, path));
+  ASSERT_TRUE(LoadEngineWithCache(kOtherRules, other_path));
+
+  // Pair the header written for |kRules| with the engine compiled from
+  // |kOtherRules|. A cache hit deserializes it as is, while a recompile would
+  // overwrite the file.
+  const std::string cache = ReadCache(path);
+  const std::string other_cache = ReadCache(other_path);
+  const std::string spliced = cache.substr(0, cache.find('\n') + 1) +
+                              other_cache.substr(other_cache.find('\n') + 1);
+  ASSERT_TRUE(base::WriteFile(path, spliced));
+
+  EXPECT_TRUE(LoadEngineWithCache(kRules, path));
+  EXPECT_EQ(spliced, ReadCache(path));
+}
+
+TEST_F(AdBlockEngineCacheTest, RecompilesWhenRulesChange) {
+  const base::FilePath path = GetPath("engine.dat");
+  ASSERT_TRUE(LoadEngineWithCache(kRules, path));
+  const std::string cache = ReadCache(path);
+
+  EXPECT_TRUE(LoadEngineWithCache(kOtherRules, path));
+  EXPECT_NE(cache, ReadCache(path));
+}
+
+TEST_F(AdBlockEngineCacheTest, RecompilesWhenCacheIsCorrupt) {
+  const base::FilePath path = GetPath("engine.dat");
+  ASSERT_TRUE(LoadEngineWithCache(kRules, path));
+  const std::string cache = ReadCache(path);
+
+  const std::string corrupt = cache.substr(0, cache.find('\n') + 1) + "junk";
+  ASSERT_TRUE(base::WriteFile(path, corrupt));
+
+  EXPECT_TRUE(LoadEngineWithCache(kRules, path));
+  EXPECT_EQ(cache, ReadCache(path));
+}
+
+TEST_F(AdBlockEngineCacheTest, EmptyRulesAreNotCached) {
+  const base::FilePath path = GetPath("engine.dat");
+  EXPECT_TRUE(LoadEngineWithCache("", path));
+  EXPECT_FALSE(base::PathExists(path));
+}
+
+}  // namespace brave_shields
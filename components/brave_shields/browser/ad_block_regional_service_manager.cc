@@ -14,6 +14,7 @@
 #include "base/values.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
+#include "brave/components/brave_shields/browser/ad_block_resource_store.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/common/pref_names.h"
@@ -74,10 +75,10 @@ void AdBlockRegionalServiceManager::StartRegionalServices() {
       auto catalog_entry = brave_shields::FindAdBlockFilterListByUUID(
           regional_catalog_, uuid);
       if (catalog_entry != regional_catalog_.end()) {
-        auto regional_service = AdBlockRegionalServiceFactory(
-            *catalog_entry, delegate_,
-            base::BindRepeating(&AdBlockRegionalServiceManager::AddResources,
-                                base::Unretained(this)));
+        auto regional_service =
+            AdBlockRegionalServiceFactory(*catalog_entry, delegate_);
+        if (resources_)
+          regional_service->AddResources(resources_);
         regional_service->Start();
         regional_services_.insert(
             std::make_pair(uuid, std::move(regional_service)));
@@ -139,6 +140,20 @@ void AdBlockRegionalServiceManager::ShouldStartRequest(
   }
 }
 
+void AdBlockRegionalServiceManager::ShouldStartRequests(
+    const std::vector<std::pair<GURL, blink::mojom::ResourceType>>& requests,
+    const std::string& tab_host,
+    std::vector<AdBlockBaseService::RequestMatch>* results) {
+  if (!IsInitialized())
+    return;
+
+  base::AutoLock lock(regional_services_lock_);
+
+  for (const auto& regional_service : regional_services_) {
+    regional_service.second->ShouldStartRequests(requests, tab_host, results);
+  }
+}
+
 absl::optional<std::string> AdBlockRegionalServiceManager::GetCspDirectives(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
@@ -163,10 +178,11 @@ void AdBlockRegionalServiceManager::EnableTag(const std::string& tag,
 }
 
 void AdBlockRegionalServiceManager::AddResources(
-    const std::string& resources) {
+    scoped_refptr<AdBlockResourceStore> resources) {
   base::AutoLock lock(regional_services_lock_);
+  resources_ = std::move(resources);
   for (const auto& regional_service : regional_services_) {
-    regional_service.second->AddResources(resources);
+    regional_service.second->AddResources(resources_);
   }
 }
 
@@ -183,10 +199,10 @@ void AdBlockRegionalServiceManager::EnableFilterList(
     auto it = regional_services_.find(uuid);
     if (enabled) {
       DCHECK(it == regional_services_.end());
-      auto regional_service = AdBlockRegionalServiceFactory(
-          *catalog_entry, delegate_,
-          base::BindRepeating(&AdBlockRegionalServiceManager::AddResources,
-                              base::Unretained(this)));
+      auto regional_service =
+          AdBlockRegionalServiceFactory(*catalog_entry, delegate_);
+      if (resources_)
+        regional_service->AddResources(resources_);
       regional_service->Start();
       regional_services_.insert(
           std::make_pair(uuid, std::move(regional_service)));
@@ -195,6 +211,7 @@ void AdBlockRegionalServiceManager::EnableFilterList(
       it->second->Unregister();
       regional_services_.erase(it);
     }
+    AdBlockBaseService::OnEngineChanged();
   }
 
   // Update preferences to reflect enabled/disabled state of specified
@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/macros.h"
@@ -17,6 +18,7 @@
 #include "base/values.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_component_updater/browser/brave_component.h"
+#include "brave/components/brave_shields/browser/ad_block_base_service.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 #include "url/gurl.h"
@@ -32,6 +34,7 @@ using brave_component_updater::BraveComponent;
 namespace brave_shields {
 
 class AdBlockRegionalService;
+class AdBlockResourceStore;
 
 // The AdBlock regional service manager, in charge of initializing and
 // managing regional AdBlock clients.
@@ -55,12 +58,19 @@ class AdBlockRegionalServiceManager {
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* adblock_replacement_url);
+  // Batched ShouldStartRequest(), see AdBlockBaseService::ShouldStartRequests.
+  void ShouldStartRequests(
+      const std::vector<std::pair<GURL, blink::mojom::ResourceType>>& requests,
+      const std::string& tab_host,
+      std::vector<AdBlockBaseService::RequestMatch>* results);
   absl::optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
       const std::string& tab_host);
   void EnableTag(const std::string& tag, bool enabled);
-  void AddResources(const std::string& resources);
+  // Shares |resources| with every regional service, including those started
+  // later.
+  void AddResources(scoped_refptr<AdBlockResourceStore> resources);
   void EnableFilterList(const std::string& uuid, bool enabled);
 
   absl::optional<base::Value> UrlCosmeticResources(const std::string& url);
@@ -79,6 +89,7 @@ class AdBlockRegionalServiceManager {
   base::Lock regional_services_lock_;
   std::map<std::string, std::unique_ptr<AdBlockRegionalService>>
       regional_services_;
+  scoped_refptr<AdBlockResourceStore> resources_;
 
   std::vector<adblock::FilterList> regional_catalog_;
 
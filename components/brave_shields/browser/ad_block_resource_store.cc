@@ -0,0 +1,26 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_resource_store.h"
+
+#include "brave/components/brave_component_updater/browser/dat_file_util.h"
+
+namespace brave_shields {
+
+AdBlockResourceStore::AdBlockResourceStore(const std::string& resources)
+    : store_(resources) {}
+
+AdBlockResourceStore::~AdBlockResourceStore() = default;
+
+scoped_refptr<AdBlockResourceStore> LoadAdBlockResourceStore(
+    const base::FilePath& resources_file_path) {
+  const std::string resources =
+      brave_component_updater::GetDATFileAsString(resources_file_path);
+  if (resources.empty())
+    return nullptr;
+  return base::MakeRefCounted<AdBlockResourceStore>(resources);
+}
+
+}  // namespace brave_shields
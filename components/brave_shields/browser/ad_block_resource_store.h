@@ -0,0 +1,49 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_RESOURCE_STORE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_RESOURCE_STORE_H_
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "brave/components/adblock_rust_ffi/src/wrapper.h"
+
+namespace brave_shields {
+
+// The redirect and scriptlet resources shipped with the ad-block component,
+// parsed once and shared by the default, regional and custom filter engines.
+// Immutable, so a component update swaps in a new store and the old one goes
+// away with the last engine that used it.
+class AdBlockResourceStore
+    : public base::RefCountedThreadSafe<AdBlockResourceStore> {
+ public:
+  // |resources| is the JSON list of resources.
+  explicit AdBlockResourceStore(const std::string& resources);
+
+  AdBlockResourceStore(const AdBlockResourceStore&) = delete;
+  AdBlockResourceStore& operator=(const AdBlockResourceStore&) = delete;
+
+  const adblock::ResourceStore& store() const { return store_; }
+  size_t size() const { return store_.size(); }
+  size_t memory_usage() const { return store_.memoryUsage(); }
+
+ private:
+  friend class base::RefCountedThreadSafe<AdBlockResourceStore>;
+  ~AdBlockResourceStore();
+
+  const adblock::ResourceStore store_;
+};
+
+// Reads and parses the resources file at |resources_file_path|. Returns
+// nullptr if the file is missing or empty. Blocking; must not be called on
+// the UI thread.
+scoped_refptr<AdBlockResourceStore> LoadAdBlockResourceStore(
+    const base::FilePath& resources_file_path);
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_RESOURCE_STORE_H_
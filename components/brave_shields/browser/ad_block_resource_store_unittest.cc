@@ -0,0 +1,92 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_resource_store.h"
+
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+namespace {
+
+constexpr char kResources[] = R"([{
+    "name": "noop.js",
+    "aliases": ["noopjs"],
+    "kind": {"mime": "application/javascript"},
+    "content": "KGZ1bmN0aW9uKCl7fSkoKQ=="
+  }, {
+    "name": "1x1.gif",
+    "aliases": [],
+    "kind": {"mime": "image/gif"},
+    "content": "R0lGODlhAQABAAAAACH5BAEKAAEALAAAAAABAAEAAAICTAEAOw=="
+  }])";
+
+}  // namespace
+
+TEST(AdBlockResourceStoreTest, ParsesResources) {
+  auto resources = base::MakeRefCounted<AdBlockResourceStore>(kResources);
+  EXPECT_EQ(2u, resources->size());
+  // Names, aliases and contents.
+  EXPECT_EQ(7u + 6u + 24u + 7u + 52u, resources->memory_usage());
+}
+
+TEST(AdBlockResourceStoreTest, InvalidJsonGivesEmptyStore) {
+  auto resources = base::MakeRefCounted<AdBlockResourceStore>("[{");
+  EXPECT_EQ(0u, resources->size());
+  EXPECT_EQ(0u, resources->memory_usage());
+}
+
+TEST(AdBlockResourceStoreTest, SharedByEngines) {
+  auto resources = base::MakeRefCounted<AdBlockResourceStore>(kResources);
+  adblock::Engine engine("-advertisement-$redirect=noop.js\n");
+  adblock::Engine other_engine("-banner-$redirect=noop.js\n");
+  engine.useResources(resources->store());
+  other_engine.useResources(resources->store());
+
+  bool did_match_rule = false;
+  bool did_match_exception = false;
+  bool did_match_important = false;
+  std::string redirect;
+  engine.matches("https://example.com/-advertisement-.js", "example.com",
+                 "example.com", false, "script", &did_match_rule,
+                 &did_match_exception, &did_match_important, &redirect);
+  EXPECT_TRUE(did_match_rule);
+  EXPECT_EQ("data:application/javascript;base64,KGZ1bmN0aW9uKCl7fSkoKQ==",
+            redirect);
+
+  did_match_rule = false;
+  redirect.clear();
+  other_engine.matches("https://example.com/-banner-.js", "example.com",
+                       "example.com", false, "script", &did_match_rule,
+                       &did_match_exception, &did_match_important, &redirect);
+  EXPECT_TRUE(did_match_rule);
+  EXPECT_EQ("data:application/javascript;base64,KGZ1bmN0aW9uKCl7fSkoKQ==",
+            redirect);
+}
+
+TEST(AdBlockResourceStoreTest, LoadsResourcesFile) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath path = temp_dir.GetPath().AppendASCII("resources.json");
+  ASSERT_TRUE(base::WriteFile(path, kResources));
+
+  auto resources = LoadAdBlockResourceStore(path);
+  ASSERT_TRUE(resources);
+  EXPECT_EQ(2u, resources->size());
+}
+
+TEST(AdBlockResourceStoreTest, MissingResourcesFile) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  EXPECT_FALSE(LoadAdBlockResourceStore(
+      temp_dir.GetPath().AppendASCII("resources.json")));
+}
+
+}  // namespace brave_shields
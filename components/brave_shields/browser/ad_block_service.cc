@@ -21,6 +21,7 @@
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
+#include "brave/components/brave_shields/browser/ad_block_resource_store.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service_manager.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
@@ -40,6 +41,11 @@ namespace brave_shields {
 
 namespace {
 
+// Number of merged cosmetic resources results kept around. Subframes and
+// reloads of the same document hit the same URL repeatedly during a page
+// load, so a small cache absorbs most of the repeated engine queries.
+constexpr size_t kCosmeticResourcesCacheSize = 32;
+
 // Extracts the start and end characters of a domain from a hostname.
 // Required for correct functionality of adblock-rust.
 void AdBlockServiceDomainResolver(const char* host,
@@ -109,6 +115,51 @@ void AdBlockService::ShouldStartRequest(
       did_match_exception, did_match_important, replacement_url);
 }
 
+void AdBlockService::ShouldStartRequests(
+    const std::vector<std::pair<GURL, blink::mojom::ResourceType>>& requests,
+    const std::string& tab_host,
+    bool aggressive_blocking,
+    std::vector<RequestMatch>* results) {
+  DCHECK(results);
+  results->resize(requests.size());
+  if (!IsInitialized())
+    return;
+
+  if (aggressive_blocking ||
+      base::FeatureList::IsEnabled(
+          brave_shields::features::kBraveAdblockDefault1pBlocking)) {
+    AdBlockBaseService::ShouldStartRequests(requests, tab_host, results);
+  } else {
+    // Only third-party requests are checked against the default engine, as
+    // in ShouldStartRequest().
+    const auto tab_origin =
+        url::Origin::CreateFromNormalizedTuple("https", tab_host, 80);
+    std::vector<size_t> indices;
+    std::vector<std::pair<GURL, blink::mojom::ResourceType>>
+        third_party_requests;
+    std::vector<RequestMatch> third_party_results;
+    for (size_t i = 0; i < requests.size(); ++i) {
+      if (SameDomainOrHost(
+              requests[i].first, tab_origin,
+              net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES)) {
+        continue;
+      }
+      indices.push_back(i);
+      third_party_requests.push_back(requests[i]);
+      third_party_results.push_back((*results)[i]);
+    }
+    AdBlockBaseService::ShouldStartRequests(third_party_requests, tab_host,
+                                            &third_party_results);
+    for (size_t j = 0; j < indices.size(); ++j)
+      (*results)[indices[j]] = std::move(third_party_results[j]);
+  }
+
+  regional_service_manager()->ShouldStartRequests(requests, tab_host, results);
+  subscription_service_manager()->ShouldStartRequests(requests, tab_host,
+                                                      results);
+  custom_filters_service()->ShouldStartRequests(requests, tab_host, results);
+}
+
 absl::optional<std::string> AdBlockService::GetCspDirectives(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
@@ -129,6 +180,24 @@ absl::optional<std::string> AdBlockService::GetCspDirectives(
 
 absl::optional<base::Value> AdBlockService::UrlCosmeticResources(
     const std::string& url) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  // Read the generation before querying the engines so that a change racing
+  // with this call leaves the cached entry stale rather than wrong.
+  const uint64_t generation = GetEngineGeneration();
+  absl::optional<base::Value> resources =
+      cosmetic_resources_cache_.Get(url, generation);
+  if (resources)
+    return resources;
+
+  resources = MergedUrlCosmeticResources(url);
+  if (resources)
+    cosmetic_resources_cache_.Put(url, generation, *resources);
+
+  return resources;
+}
+
+absl::optional<base::Value> AdBlockService::MergedUrlCosmeticResources(
+    const std::string& url) {
   absl::optional<base::Value> resources =
       AdBlockBaseService::UrlCosmeticResources(url);
 
@@ -229,7 +298,9 @@ brave_shields::AdBlockCustomFiltersService*
 AdBlockService::custom_filters_service() {
   if (!custom_filters_service_)
     custom_filters_service_ =
-        brave_shields::AdBlockCustomFiltersServiceFactory(component_delegate_);
+        brave_shields::AdBlockCustomFiltersServiceFactory(
+            component_delegate_,
+            user_data_dir_.Append(kCustomFiltersEngineCache));
   return custom_filters_service_.get();
 }
 
@@ -241,10 +312,13 @@ AdBlockService::subscription_service_manager() {
 AdBlockService::AdBlockService(
     brave_component_updater::BraveComponent::Delegate* delegate,
     std::unique_ptr<AdBlockSubscriptionServiceManager>
-        subscription_service_manager)
+        subscription_service_manager,
+    const base::FilePath& user_data_dir)
     : AdBlockBaseService(delegate),
       component_delegate_(delegate),
-      subscription_service_manager_(std::move(subscription_service_manager)) {}
+      user_data_dir_(user_data_dir),
+      subscription_service_manager_(std::move(subscription_service_manager)),
+      cosmetic_resources_cache_(kCosmeticResourcesCacheSize) {}
 
 AdBlockService::~AdBlockService() {}
 
@@ -277,9 +351,8 @@ void AdBlockService::OnComponentReady(const std::string& component_id,
       install_dir.AppendASCII(kAdBlockResourcesFilename);
   base::PostTaskAndReplyWithResult(
       GetTaskRunner().get(), FROM_HERE,
-      base::BindOnce(&brave_component_updater::GetDATFileAsString,
-                     resources_file_path),
-      base::BindOnce(&AdBlockService::OnResourcesFileDataReady,
+      base::BindOnce(&LoadAdBlockResourceStore, resources_file_path),
+      base::BindOnce(&AdBlockService::OnResourceStoreReady,
                      weak_factory_.GetWeakPtr()));
   base::PostTaskAndReplyWithResult(
       GetTaskRunner().get(), FROM_HERE,
@@ -289,9 +362,19 @@ void AdBlockService::OnComponentReady(const std::string& component_id,
                      weak_factory_.GetWeakPtr()));
 }
 
-void AdBlockService::OnResourcesFileDataReady(const std::string& resources) {
+void AdBlockService::OnResourceStoreReady(
+    scoped_refptr<AdBlockResourceStore> resources) {
+  if (!resources) {
+    LOG(ERROR) << "Could not obtain ad block resources";
+    return;
+  }
+  // Every engine replaces its resources with this one parsed copy; the
+  // previous store is released once the last engine has switched over.
+  VLOG(1) << "Ad block resources: " << resources->size() << " resources, "
+          << resources->memory_usage() << " bytes, shared by all engines";
   AddResources(resources);
   custom_filters_service()->AddResources(resources);
+  regional_service_manager()->AddResources(std::move(resources));
 }
 
 void AdBlockService::OnRegionalCatalogFileDataReady(
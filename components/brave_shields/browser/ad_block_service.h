@@ -10,10 +10,12 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/values.h"
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
+#include "brave/components/brave_shields/browser/cosmetic_resources_cache.h"
 #include "components/keyed_service/core/keyed_service.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "content/public/browser/browser_thread.h"
@@ -47,9 +49,11 @@ const char kAdBlockComponentBase64PublicKey[] =
 // The brave shields service in charge of ad-block checking and init.
 class AdBlockService : public AdBlockBaseService {
  public:
-  explicit AdBlockService(
-      BraveComponent::Delegate* delegate,
-      std::unique_ptr<AdBlockSubscriptionServiceManager> manager);
+  // |user_data_dir| is where state shared by all profiles, such as the
+  // compiled custom filters, is cached.
+  AdBlockService(BraveComponent::Delegate* delegate,
+                 std::unique_ptr<AdBlockSubscriptionServiceManager> manager,
+                 const base::FilePath& user_data_dir);
   ~AdBlockService() override;
 
   void ShouldStartRequest(const GURL& url,
@@ -60,6 +64,19 @@ class AdBlockService : public AdBlockBaseService {
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* replacement_url) override;
+  // Checks several requests made from |tab_host| against the default,
+  // regional, subscription and custom filter engines, with one engine call
+  // per list rather than per request. Each result is what ShouldStartRequest()
+  // would report for that request.
+  //
+  // Not called from the request path yet: BraveProxyingURLLoaderFactory hands
+  // requests to the ad-block helper one at a time, and there is no source of
+  // a page's upcoming requests, such as preload scanner hints, to batch.
+  void ShouldStartRequests(
+      const std::vector<std::pair<GURL, blink::mojom::ResourceType>>& requests,
+      const std::string& tab_host,
+      bool aggressive_blocking,
+      std::vector<RequestMatch>* results);
   absl::optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
@@ -80,7 +97,7 @@ class AdBlockService : public AdBlockBaseService {
   void OnComponentReady(const std::string& component_id,
                         const base::FilePath& install_dir,
                         const std::string& manifest) override;
-  void OnResourcesFileDataReady(const std::string& resources);
+  void OnResourceStoreReady(scoped_refptr<AdBlockResourceStore> resources);
   void OnRegionalCatalogFileDataReady(const std::string& catalog_json);
 
  private:
@@ -93,7 +110,12 @@ class AdBlockService : public AdBlockBaseService {
       const std::string& component_id,
       const std::string& component_base64_public_key);
 
+  // Queries and merges the default, regional, custom and subscription engines.
+  absl::optional<base::Value> MergedUrlCosmeticResources(
+      const std::string& url);
+
   BraveComponent::Delegate* component_delegate_;
+  const base::FilePath user_data_dir_;
 
   std::unique_ptr<brave_shields::AdBlockRegionalServiceManager>
       regional_service_manager_;
@@ -102,6 +124,9 @@ class AdBlockService : public AdBlockBaseService {
   std::unique_ptr<brave_shields::AdBlockSubscriptionServiceManager>
       subscription_service_manager_;
 
+  // Only touched on the ad-block task runner.
+  CosmeticResourcesCache cosmetic_resources_cache_;
+
   base::WeakPtrFactory<AdBlockService> weak_factory_{this};
   DISALLOW_COPY_AND_ASSIGN(AdBlockService);
 };
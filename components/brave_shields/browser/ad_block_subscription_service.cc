@@ -75,9 +75,10 @@ bool AdBlockSubscriptionService::Init() {
 }
 
 void AdBlockSubscriptionService::ReloadList() {
-  GetDATFileData(list_file_, false,
-                 base::BindOnce(&AdBlockSubscriptionService::OnListLoaded,
-                                weak_factory_.GetWeakPtr()));
+  GetListFileData(list_file_,
+                  list_file_.DirName().Append(kCustomSubscriptionEngineCache),
+                  base::BindOnce(&AdBlockSubscriptionService::OnListLoaded,
+                                 weak_factory_.GetWeakPtr()));
 }
 
 void AdBlockSubscriptionService::OnListLoaded() {
@@ -20,6 +20,7 @@
 #include "base/time/time.h"
 #include "base/values.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "brave/components/brave_shields/browser/ad_block_resource_store.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service_manager_observer.h"
@@ -200,6 +201,7 @@ void AdBlockSubscriptionServiceManager::EnableSubscription(const GURL& sub_url,
   DCHECK(info);
 
   info->enabled = enabled;
+  AdBlockBaseService::OnEngineChanged();
 
   UpdateSubscriptionPrefs(sub_url, *info);
 }
@@ -213,6 +215,7 @@ void AdBlockSubscriptionServiceManager::DeleteSubscription(
     DCHECK(it != subscription_services_.end());
     subscription_services_.erase(it);
   }
+  AdBlockBaseService::OnEngineChanged();
   ClearSubscriptionPrefs(sub_url);
 
   base::ThreadPool::PostTask(
@@ -385,6 +388,20 @@ void AdBlockSubscriptionServiceManager::ShouldStartRequest(
   }
 }
 
+void AdBlockSubscriptionServiceManager::ShouldStartRequests(
+    const std::vector<std::pair<GURL, blink::mojom::ResourceType>>& requests,
+    const std::string& tab_host,
+    std::vector<AdBlockBaseService::RequestMatch>* results) {
+  base::AutoLock lock(subscription_services_lock_);
+  for (const auto& subscription_service : subscription_services_) {
+    auto info = GetInfo(subscription_service.first);
+    if (info && info->enabled) {
+      subscription_service.second->ShouldStartRequests(requests, tab_host,
+                                                       results);
+    }
+  }
+}
+
 void AdBlockSubscriptionServiceManager::EnableTag(const std::string& tag,
                                                   bool enabled) {
   DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
@@ -394,7 +411,7 @@ void AdBlockSubscriptionServiceManager::EnableTag(const std::string& tag,
 }
 
 void AdBlockSubscriptionServiceManager::AddResources(
-    const std::string& resources) {
+    scoped_refptr<AdBlockResourceStore> resources) {
   DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
   for (const auto& subscription_service : subscription_services_) {
     subscription_service.second->AddResources(resources);
@@ -9,10 +9,12 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/files/file_path.h"
 #include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/one_shot_event.h"
 #include "base/synchronization/lock.h"
@@ -28,6 +30,7 @@
 class PrefService;
 
 namespace brave_shields {
+class AdBlockResourceStore;
 class AdBlockSubscriptionServiceManagerObserver;
 }
 
@@ -66,8 +69,13 @@ class AdBlockSubscriptionServiceManager {
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* adblock_replacement_url);
+  // Batched ShouldStartRequest(), see AdBlockBaseService::ShouldStartRequests.
+  void ShouldStartRequests(
+      const std::vector<std::pair<GURL, blink::mojom::ResourceType>>& requests,
+      const std::string& tab_host,
+      std::vector<AdBlockBaseService::RequestMatch>* results);
   void EnableTag(const std::string& tag, bool enabled);
-  void AddResources(const std::string& resources);
+  void AddResources(scoped_refptr<AdBlockResourceStore> resources);
 
   absl::optional<base::Value> UrlCosmeticResources(const std::string& url);
   absl::optional<base::Value> HiddenClassIdSelectors(
@@ -424,6 +424,18 @@ ControlType GetNoScriptControlType(HostContentSettingsMap* map,
                                           : ControlType::BLOCK;
 }
 
+ShieldsSettingsSnapshot GetShieldsSettingsSnapshot(HostContentSettingsMap* map,
+                                                   const GURL& url) {
+  ShieldsSettingsSnapshot snapshot;
+  snapshot.brave_shields_enabled = GetBraveShieldsEnabled(map, url);
+  snapshot.ad_control_type = GetAdControlType(map, url);
+  snapshot.cosmetic_filtering_control_type =
+      GetCosmeticFilteringControlType(map, url);
+  snapshot.https_everywhere_enabled = GetHTTPSEverywhereEnabled(map, url);
+  snapshot.allow_referrers = AllowReferrers(map, url);
+  return snapshot;
+}
+
 bool IsSameOriginNavigation(const GURL& referrer, const GURL& target_url) {
   const url::Origin original_referrer = url::Origin::Create(referrer);
   const url::Origin target_origin = url::Origin::Create(target_url);
@@ -95,6 +95,19 @@ void SetNoScriptControlType(HostContentSettingsMap* map,
 ControlType GetNoScriptControlType(HostContentSettingsMap* map,
                                    const GURL& url);
 
+// The Shields settings the network stack reads for every request, resolved
+// for one site so they cost one round of content settings lookups.
+struct ShieldsSettingsSnapshot {
+  bool brave_shields_enabled = true;
+  ControlType ad_control_type = ControlType::BLOCK;
+  ControlType cosmetic_filtering_control_type = ControlType::BLOCK_THIRD_PARTY;
+  bool https_everywhere_enabled = true;
+  bool allow_referrers = false;
+};
+
+ShieldsSettingsSnapshot GetShieldsSettingsSnapshot(HostContentSettingsMap* map,
+                                                   const GURL& url);
+
 bool IsSameOriginNavigation(const GURL& referrer, const GURL& target_url);
 
 bool MaybeChangeReferrer(bool allow_referrers,
@@ -0,0 +1,55 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/cosmetic_resources_cache.h"
+
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+CosmeticResourcesCache::CosmeticResourcesCache(size_t max_size)
+    : entries_(max_size) {}
+
+CosmeticResourcesCache::~CosmeticResourcesCache() = default;
+
+absl::optional<base::Value> CosmeticResourcesCache::Get(
+    const std::string& url,
+    uint64_t generation) {
+  SetGeneration(generation);
+  auto it = entries_.Get(GetKey(url));
+  if (it == entries_.end())
+    return absl::nullopt;
+  return it->second.Clone();
+}
+
+void CosmeticResourcesCache::Put(const std::string& url,
+                                 uint64_t generation,
+                                 const base::Value& resources) {
+  // Results computed under an older generation may miss an engine change.
+  if (generation < generation_)
+    return;
+  SetGeneration(generation);
+  entries_.Put(GetKey(url), resources.Clone());
+}
+
+// static
+std::string CosmeticResourcesCache::GetKey(const std::string& url) {
+  GURL gurl(url);
+  if (!gurl.is_valid())
+    return url;
+  GURL::Replacements replacements;
+  replacements.ClearQuery();
+  replacements.ClearRef();
+  return gurl.ReplaceComponents(replacements).spec();
+}
+
+void CosmeticResourcesCache::SetGeneration(uint64_t generation) {
+  if (generation == generation_)
+    return;
+  entries_.Clear();
+  generation_ = generation;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,45 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_COSMETIC_RESOURCES_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_COSMETIC_RESOURCES_CACHE_H_
+
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/values.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace brave_shields {
+
+// Merged UrlCosmeticResources results, keyed by URL without its query and
+// fragment, so that pages differing only in tracking parameters share an entry.
+// Entries are tagged with the AdBlockBaseService::GetEngineGeneration() they
+// were computed under and all of them are dropped once a lookup sees a newer
+// generation.
+class CosmeticResourcesCache {
+ public:
+  explicit CosmeticResourcesCache(size_t max_size);
+  ~CosmeticResourcesCache();
+
+  CosmeticResourcesCache(const CosmeticResourcesCache&) = delete;
+  CosmeticResourcesCache& operator=(const CosmeticResourcesCache&) = delete;
+
+  absl::optional<base::Value> Get(const std::string& url, uint64_t generation);
+  void Put(const std::string& url,
+           uint64_t generation,
+           const base::Value& resources);
+
+ private:
+  static std::string GetKey(const std::string& url);
+  void SetGeneration(uint64_t generation);
+
+  base::MRUCache<std::string, base::Value> entries_;
+  uint64_t generation_ = 0;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_COSMETIC_RESOURCES_CACHE_H_
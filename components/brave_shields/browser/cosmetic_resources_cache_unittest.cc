@@ -0,0 +1,79 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/cosmetic_resources_cache.h"
+
+#include <utility>
+
+#include "base/values.h"
+#include "brave/components/brave_shields/browser/ad_block_base_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+namespace {
+
+constexpr char kUrl[] = "https://example.com/";
+constexpr char kOtherUrl[] = "https://example.com/other";
+
+base::Value GetResources(const char* hide_selector) {
+  base::Value resources(base::Value::Type::DICTIONARY);
+  base::Value selectors(base::Value::Type::LIST);
+  selectors.Append(hide_selector);
+  resources.SetKey("hide_selectors", std::move(selectors));
+  return resources;
+}
+
+}  // namespace
+
+TEST(CosmeticResourcesCacheTest, Hit) {
+  CosmeticResourcesCache cache(2);
+  EXPECT_FALSE(cache.Get(kUrl, 1));
+
+  cache.Put(kUrl, 1, GetResources(".ad"));
+  EXPECT_EQ(GetResources(".ad"), cache.Get(kUrl, 1));
+  EXPECT_FALSE(cache.Get(kOtherUrl, 1));
+}
+
+TEST(CosmeticResourcesCacheTest, IgnoresQueryAndFragment) {
+  CosmeticResourcesCache cache(2);
+  cache.Put("https://example.com/?utm_source=a#top", 1, GetResources(".ad"));
+  EXPECT_EQ(GetResources(".ad"), cache.Get(kUrl, 1));
+  EXPECT_EQ(GetResources(".ad"),
+            cache.Get("https://example.com/?utm_source=b", 1));
+  EXPECT_FALSE(cache.Get(kOtherUrl, 1));
+}
+
+TEST(CosmeticResourcesCacheTest, EvictsLeastRecentlyUsed) {
+  CosmeticResourcesCache cache(1);
+  cache.Put(kUrl, 1, GetResources(".ad"));
+  cache.Put(kOtherUrl, 1, GetResources(".banner"));
+  EXPECT_FALSE(cache.Get(kUrl, 1));
+  EXPECT_EQ(GetResources(".banner"), cache.Get(kOtherUrl, 1));
+}
+
+TEST(CosmeticResourcesCacheTest, InvalidatedOnEngineReload) {
+  CosmeticResourcesCache cache(2);
+  const uint64_t generation = AdBlockBaseService::GetEngineGeneration();
+  cache.Put(kUrl, generation, GetResources(".ad"));
+  ASSERT_TRUE(cache.Get(kUrl, generation));
+
+  // Reloading or updating any engine bumps the generation.
+  AdBlockBaseService::OnEngineChanged();
+  const uint64_t new_generation = AdBlockBaseService::GetEngineGeneration();
+  EXPECT_NE(generation, new_generation);
+  EXPECT_FALSE(cache.Get(kUrl, new_generation));
+  EXPECT_FALSE(cache.Get(kUrl, generation));
+}
+
+TEST(CosmeticResourcesCacheTest, DropsResultsFromOlderGeneration) {
+  CosmeticResourcesCache cache(2);
+  EXPECT_FALSE(cache.Get(kUrl, 2));
+  // A lookup that started before the engines changed finishes afterwards.
+  cache.Put(kUrl, 1, GetResources(".ad"));
+  EXPECT_FALSE(cache.Get(kUrl, 2));
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,62 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
+
+#include "brave/components/content_settings/core/browser/brave_content_settings_utils.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace brave_shields {
+
+namespace {
+
+constexpr size_t kMaxCachedSites = 256;
+
+// Content settings patterns for web sites never look past the origin, so all
+// URLs of an HTTP(S) origin share a snapshot. Other schemes (e.g. file:) can
+// have path-specific rules and are keyed by the full URL.
+GURL GetCacheKey(const GURL& url) {
+  return url.SchemeIsHTTPOrHTTPS() ? url.GetOrigin() : url;
+}
+
+}  // namespace
+
+ShieldsSettingsCache::ShieldsSettingsCache(HostContentSettingsMap* map)
+    : map_(map), snapshots_(kMaxCachedSites) {
+  DCHECK(map_);
+  observation_.Observe(map_);
+}
+
+ShieldsSettingsCache::~ShieldsSettingsCache() = default;
+
+const ShieldsSettingsSnapshot& ShieldsSettingsCache::GetSnapshot(
+    const GURL& url) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  const GURL key = GetCacheKey(url);
+  auto it = snapshots_.Get(key);
+  if (it == snapshots_.end())
+    it = snapshots_.Put(key, GetShieldsSettingsSnapshot(map_, url));
+  return it->second;
+}
+
+void ShieldsSettingsCache::Shutdown() {
+  observation_.Reset();
+  snapshots_.Clear();
+}
+
+void ShieldsSettingsCache::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type) {
+  if (content_type != ContentSettingsType::DEFAULT &&
+      !content_settings::IsShieldsContentSettingsType(content_type)) {
+    return;
+  }
+  // Changes arrive as patterns, which can't be mapped back to cached sites
+  // cheaply, and they are rare compared to lookups.
+  snapshots_.Clear();
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,51 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_CACHE_H_
+
+#include "base/containers/mru_cache.h"
+#include "base/scoped_observation.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "components/keyed_service/core/keyed_service.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+// Per-profile cache of ShieldsSettingsSnapshot keyed by site. A page with
+// hundreds of subresources resolves its Shields settings once instead of on
+// every request. Any content settings change clears the cache. Must be used on
+// the UI thread.
+class ShieldsSettingsCache : public KeyedService,
+                             public content_settings::Observer {
+ public:
+  explicit ShieldsSettingsCache(HostContentSettingsMap* map);
+  ~ShieldsSettingsCache() override;
+
+  ShieldsSettingsCache(const ShieldsSettingsCache&) = delete;
+  ShieldsSettingsCache& operator=(const ShieldsSettingsCache&) = delete;
+
+  const ShieldsSettingsSnapshot& GetSnapshot(const GURL& url);
+
+  // KeyedService:
+  void Shutdown() override;
+
+ private:
+  // content_settings::Observer:
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type) override;
+
+  HostContentSettingsMap* map_;
+  base::MRUCache<GURL, ShieldsSettingsSnapshot> snapshots_;
+  base::ScopedObservation<HostContentSettingsMap, content_settings::Observer>
+      observation_{this};
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_CACHE_H_
@@ -0,0 +1,89 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
+
+#include <memory>
+
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/test/base/testing_profile.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/test/browser_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using brave_shields::ControlType;
+using brave_shields::ShieldsSettingsCache;
+using brave_shields::ShieldsSettingsSnapshot;
+
+class ShieldsSettingsCacheTest : public testing::Test {
+ public:
+  ShieldsSettingsCacheTest() = default;
+  ~ShieldsSettingsCacheTest() override = default;
+
+  void SetUp() override {
+    profile_ = std::make_unique<TestingProfile>();
+    cache_ = std::make_unique<ShieldsSettingsCache>(map());
+  }
+
+  void TearDown() override { cache_->Shutdown(); }
+
+  HostContentSettingsMap* map() {
+    return HostContentSettingsMapFactory::GetForProfile(profile_.get());
+  }
+
+  ShieldsSettingsCache* cache() { return cache_.get(); }
+
+ private:
+  content::BrowserTaskEnvironment task_environment_;
+  std::unique_ptr<TestingProfile> profile_;
+  std::unique_ptr<ShieldsSettingsCache> cache_;
+};
+
+TEST_F(ShieldsSettingsCacheTest, SnapshotMatchesIndividualGetters) {
+  const GURL url("https://brave.com/path");
+  brave_shields::SetAdControlType(map(), ControlType::ALLOW, url);
+  brave_shields::SetHTTPSEverywhereEnabled(map(), false, url);
+
+  const ShieldsSettingsSnapshot& snapshot = cache()->GetSnapshot(url);
+  EXPECT_EQ(brave_shields::GetBraveShieldsEnabled(map(), url),
+            snapshot.brave_shields_enabled);
+  EXPECT_EQ(ControlType::ALLOW, snapshot.ad_control_type);
+  EXPECT_EQ(brave_shields::GetCosmeticFilteringControlType(map(), url),
+            snapshot.cosmetic_filtering_control_type);
+  EXPECT_FALSE(snapshot.https_everywhere_enabled);
+  EXPECT_EQ(brave_shields::AllowReferrers(map(), url),
+            snapshot.allow_referrers);
+}
+
+TEST_F(ShieldsSettingsCacheTest, SitesAreCachedIndependently) {
+  const GURL url("https://brave.com");
+  const GURL other_url("https://example.com");
+  brave_shields::SetBraveShieldsEnabled(map(), false, url);
+
+  EXPECT_FALSE(cache()->GetSnapshot(url).brave_shields_enabled);
+  EXPECT_FALSE(cache()
+                   ->GetSnapshot(GURL("https://brave.com/other"))
+                   .brave_shields_enabled);
+  EXPECT_TRUE(cache()->GetSnapshot(other_url).brave_shields_enabled);
+}
+
+TEST_F(ShieldsSettingsCacheTest, ContentSettingChangeInvalidates) {
+  const GURL url("https://brave.com");
+  EXPECT_TRUE(cache()->GetSnapshot(url).brave_shields_enabled);
+  EXPECT_EQ(ControlType::BLOCK, cache()->GetSnapshot(url).ad_control_type);
+
+  brave_shields::SetBraveShieldsEnabled(map(), false, url);
+  EXPECT_FALSE(cache()->GetSnapshot(url).brave_shields_enabled);
+
+  brave_shields::SetAdControlType(map(), ControlType::ALLOW, GURL());
+  EXPECT_EQ(ControlType::ALLOW, cache()->GetSnapshot(url).ad_control_type);
+
+  brave_shields::SetCosmeticFilteringControlType(map(), ControlType::BLOCK,
+                                                 url);
+  EXPECT_EQ(ControlType::BLOCK,
+            cache()->GetSnapshot(url).cosmetic_filtering_control_type);
+}
@@ -38,6 +38,15 @@ const char kObsoleteFingerprinting[] = "fingerprinting";
 const base::FilePath::CharType kCustomSubscriptionListText[] =
     FPL("list_text.txt");
 
+// Filename for the serialized engine compiled from a filter list
+// subscription's cached text
+const base::FilePath::CharType kCustomSubscriptionEngineCache[] =
+    FPL("list_engine.dat");
+
+// Filename for the serialized engine compiled from the custom filters
+const base::FilePath::CharType kCustomFiltersEngineCache[] =
+    FPL("AdBlockCustomFiltersEngine.dat");
+
 }  // namespace brave_shields
 
 #endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_COMMON_BRAVE_SHIELD_CONSTANTS_H_
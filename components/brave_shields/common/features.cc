@@ -46,6 +46,6 @@ const base::Feature kBraveDarkModeBlock{"BraveDarkModeBlock",
                                         base::FEATURE_ENABLED_BY_DEFAULT};
 // load the cosmetic filter rules using sync ipc
 const base::Feature kCosmeticFilteringSyncLoad{
-    "CosmeticFilterSyncLoad", base::FEATURE_ENABLED_BY_DEFAULT};
+    "CosmeticFilterSyncLoad", base::FEATURE_DISABLED_BY_DEFAULT};
 }  // namespace features
 }  // namespace brave_shields
@@ -12,13 +12,12 @@
 #include <vector>
 
 #include "base/bind.h"
+#include "base/files/file_path.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
-#include "brave/components/brave_private_cdn/headers.h"
-#include "brave/components/brave_private_cdn/private_cdn_helper.h"
 #include "brave/components/brave_today/browser/network.h"
 #include "brave/components/brave_today/common/brave_news.mojom-forward.h"
 #include "brave/components/brave_today/common/brave_news.mojom-shared.h"
@@ -34,6 +33,15 @@
 
 namespace brave_news {
 
+namespace {
+
+// Files in the profile directory holding the last fetched data, so that the
+// NTP can show Brave News before the network responds.
+const char kPublishersCacheFile[] = "Brave News Publishers";
+const char kFeedCacheFile[] = "Brave News Feed";
+
+}  // namespace
+
 // static
 void BraveNewsController::RegisterProfilePrefs(PrefRegistrySimple* registry) {
   // Only default brave today to be shown for
@@ -60,14 +68,19 @@ BraveNewsController::BraveNewsController(
     PrefService* prefs,
     brave_ads::AdsService* ads_service,
     history::HistoryService* history_service,
-    scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
+    scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
+    const base::FilePath& profile_path)
     : prefs_(prefs),
       ads_service_(ads_service),
       api_request_helper_(GetNetworkTrafficAnnotationTag(), url_loader_factory),
-      publishers_controller_(prefs, &api_request_helper_),
+      publishers_controller_(prefs,
+                             &api_request_helper_,
+                             profile_path.AppendASCII(kPublishersCacheFile)),
       feed_controller_(&publishers_controller_,
                        history_service,
-                       &api_request_helper_),
+                       &api_request_helper_,
+                       profile_path.AppendASCII(kFeedCacheFile)),
+      image_controller_(&api_request_helper_),
       weak_ptr_factory_(this) {
   DCHECK(prefs);
   // Set up preference listeners
@@ -93,8 +106,10 @@ void BraveNewsController::Bind(
 }
 
 void BraveNewsController::ClearHistory() {
-  // TODO(petemill): Clear history once/if we actually store
-  // feed cache somewhere.
+  // The stored feed is ordered by visited publishers.
+  feed_controller_.ClearCache();
+  // Cached images reveal which cards were shown.
+  image_controller_.ClearCache();
 }
 
 void BraveNewsController::GetFeed(GetFeedCallback callback) {
@@ -107,30 +122,12 @@ void BraveNewsController::GetPublishers(GetPublishersCallback callback) {
 
 void BraveNewsController::GetImageData(const GURL& padded_image_url,
                                        GetImageDataCallback callback) {
-  // Handler url download response
-  auto onPaddedImageResponse = base::BindOnce(
-      [](GetImageDataCallback callback, const int status,
-         const std::string& body,
-         const base::flat_map<std::string, std::string>& headers) {
-        // Attempt to remove byte padding
-        base::StringPiece body_payload(body.data(), body.size());
-        if (status < 200 || status >= 300 ||
-            !brave::PrivateCdnHelper::GetInstance()->RemovePadding(
-                &body_payload)) {
-          // Byte padding removal failed
-          absl::optional<std::vector<uint8_t>> args;
-          std::move(callback).Run(std::move(args));
-        }
-        // Unpadding was successful, uint8Array will be easier to move over
-        // mojom
-        std::vector<uint8_t> image_bytes(body_payload.begin(),
-                                         body_payload.end());
-        std::move(callback).Run(image_bytes);
-      },
-      std::move(callback));
-  api_request_helper_.Request("GET", padded_image_url, "", "", true,
-                              std::move(onPaddedImageResponse),
-                              brave::private_cdn_headers);
+  image_controller_.GetImageData(padded_image_url, std::move(callback));
+}
+
+void BraveNewsController::PrefetchImageData(
+    const std::vector<GURL>& padded_image_urls) {
+  image_controller_.PrefetchImages(padded_image_urls);
 }
 
 void BraveNewsController::SetPublisherPref(const std::string& publisher_id,
@@ -372,6 +369,7 @@ void BraveNewsController::ConditionallyStartOrStopTimer() {
     VLOG(1) << "REMOVING DATA FROM MEMORY";
     feed_controller_.ClearCache();
     publishers_controller_.ClearCache();
+    image_controller_.ClearCache();
   }
 }
 
@@ -8,12 +8,15 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/callback_forward.h"
 #include "base/containers/flat_map.h"
+#include "base/files/file_path.h"
 #include "base/timer/timer.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_today/browser/feed_controller.h"
+#include "brave/components/brave_today/browser/image_controller.h"
 #include "brave/components/brave_today/browser/publishers_controller.h"
 #include "brave/components/brave_today/common/brave_news.mojom-forward.h"
 #include "brave/components/brave_today/common/brave_news.mojom.h"
@@ -38,8 +41,8 @@ class HistoryService;
 namespace brave_news {
 
 // Browser-side handler for Brave News mojom API, 1 per profile
-// Orchestrates FeedController and PublishersController for data, as well as
-// owning prefs data.
+// Orchestrates FeedController, PublishersController and ImageController for
+// data, as well as owning prefs data.
 // Controls remote feed update logic via Timer and prefs values.
 class BraveNewsController : public KeyedService,
                             public mojom::BraveNewsController {
@@ -50,7 +53,8 @@ class BraveNewsController : public KeyedService,
       PrefService* prefs,
       brave_ads::AdsService* ads_service,
       history::HistoryService* history_service,
-      scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
+      scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
+      const base::FilePath& profile_path);
   ~BraveNewsController() override;
   BraveNewsController(const BraveNewsController&) = delete;
   BraveNewsController& operator=(const BraveNewsController&) = delete;
@@ -65,6 +69,7 @@ class BraveNewsController : public KeyedService,
   void GetPublishers(GetPublishersCallback callback) override;
   void GetImageData(const GURL& padded_image_url,
                     GetImageDataCallback callback) override;
+  void PrefetchImageData(const std::vector<GURL>& padded_image_urls) override;
   void SetPublisherPref(const std::string& publisher_id,
                         mojom::UserEnabled new_status) override;
   void ClearPrefs() override;
@@ -96,6 +101,7 @@ class BraveNewsController : public KeyedService,
   api_request_helper::APIRequestHelper api_request_helper_;
   PublishersController publishers_controller_;
   FeedController feed_controller_;
+  ImageController image_controller_;
 
   PrefChangeRegistrar pref_change_registrar_;
   base::OneShotTimer timer_prefetch_;
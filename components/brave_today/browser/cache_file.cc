@@ -0,0 +1,103 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/cache_file.h"
+
+#include <utility>
+
+#include "base/big_endian.h"
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/task/post_task.h"
+#include "base/task/thread_pool.h"
+
+namespace brave_news {
+
+namespace {
+
+constexpr size_t kFormatVersionSize = sizeof(uint32_t);
+
+absl::optional<std::string> ReadCacheFile(const base::FilePath& path,
+                                          uint32_t format_version) {
+  std::string data;
+  if (!base::ReadFileToString(path, &data))
+    return absl::nullopt;
+  uint32_t data_format_version = 0;
+  if (data.size() < kFormatVersionSize)
+    return absl::nullopt;
+  base::ReadBigEndian(data.data(), &data_format_version);
+  if (data_format_version != format_version) {
+    VLOG(1) << "News: ignoring " << path.value() << " with format version "
+            << data_format_version;
+    return absl::nullopt;
+  }
+  return data.substr(kFormatVersionSize);
+}
+
+void WriteCacheFile(const base::FilePath& path,
+                    uint32_t format_version,
+                    const std::string& data) {
+  char header[kFormatVersionSize];
+  base::WriteBigEndian(header, format_version);
+  if (!base::ImportantFileWriter::WriteFileAtomically(
+          path, std::string(header, sizeof(header)) + data)) {
+    VLOG(1) << "News: could not write " << path.value();
+  }
+}
+
+void DeleteCacheFile(const base::FilePath& path) {
+  base::DeleteFile(path);
+}
+
+}  // namespace
+
+CacheFile::CacheFile(const base::FilePath& path, uint32_t format_version)
+    : path_(path),
+      format_version_(format_version),
+      task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::BLOCK_SHUTDOWN})) {}
+
+CacheFile::~CacheFile() = default;
+
+void CacheFile::Read(ReadCallback callback) {
+  if (path_.empty()) {
+    task_runner_->PostTaskAndReply(
+        FROM_HERE, base::DoNothing(),
+        base::BindOnce(std::move(callback), absl::nullopt));
+    return;
+  }
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&ReadCacheFile, path_, format_version_),
+      base::BindOnce(&CacheFile::OnRead, weak_ptr_factory_.GetWeakPtr(),
+                     generation_, std::move(callback)));
+}
+
+void CacheFile::Write(std::string data) {
+  if (path_.empty())
+    return;
+  task_runner_->PostTask(FROM_HERE,
+                         base::BindOnce(&WriteCacheFile, path_,
+                                        format_version_, std::move(data)));
+}
+
+void CacheFile::Delete() {
+  generation_++;
+  if (path_.empty())
+    return;
+  task_runner_->PostTask(FROM_HERE, base::BindOnce(&DeleteCacheFile, path_));
+}
+
+void CacheFile::OnRead(int generation,
+                       ReadCallback callback,
+                       absl::optional<std::string> data) {
+  if (generation != generation_)
+    data = absl::nullopt;
+  std::move(callback).Run(std::move(data));
+}
+
+}  // namespace brave_news
@@ -0,0 +1,56 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_CACHE_FILE_H_
+#define BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_CACHE_FILE_H_
+
+#include <cstdint>
+#include <string>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace brave_news {
+
+// A file holding data from a previous session, read and written on a
+// background sequence. An empty path makes every read come back empty.
+// The data is stored after |format_version|, and a file written with any
+// other version reads back empty, so that data in an old format is dropped
+// rather than misread.
+class CacheFile {
+ public:
+  using ReadCallback =
+      base::OnceCallback<void(absl::optional<std::string> data)>;
+
+  CacheFile(const base::FilePath& path, uint32_t format_version);
+  ~CacheFile();
+  CacheFile(const CacheFile&) = delete;
+  CacheFile& operator=(const CacheFile&) = delete;
+
+  // Reads the file. A Delete() before the read completes makes it come back
+  // empty, so cleared data isn't brought back.
+  void Read(ReadCallback callback);
+  void Write(std::string data);
+  void Delete();
+
+ private:
+  void OnRead(int generation,
+              ReadCallback callback,
+              absl::optional<std::string> data);
+
+  base::FilePath path_;
+  uint32_t format_version_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  int generation_ = 0;
+  base::WeakPtrFactory<CacheFile> weak_ptr_factory_{this};
+};
+
+}  // namespace brave_news
+
+#endif  // BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_CACHE_FILE_H_
@@ -0,0 +1,91 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/cache_file.h"
+
+#include <string>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace brave_news {
+
+class BraveNewsCacheFileTest : public testing::Test {
+ public:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+ protected:
+  absl::optional<std::string> Read(CacheFile* cache_file) {
+    absl::optional<std::string> result;
+    cache_file->Read(base::BindLambdaForTesting(
+        [&result](absl::optional<std::string> data) {
+          result = std::move(data);
+        }));
+    task_environment_.RunUntilIdle();
+    return result;
+  }
+
+  base::FilePath GetPath() const {
+    return temp_dir_.GetPath().AppendASCII("cache");
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(BraveNewsCacheFileTest, ReadsWhatWasWritten) {
+  CacheFile cache_file(GetPath(), 1);
+  EXPECT_FALSE(Read(&cache_file));
+
+  cache_file.Write("feed");
+  task_environment_.RunUntilIdle();
+  CacheFile next_session(GetPath(), 1);
+  EXPECT_EQ("feed", Read(&next_session));
+}
+
+TEST_F(BraveNewsCacheFileTest, DeleteDropsPendingRead) {
+  CacheFile cache_file(GetPath(), 1);
+  cache_file.Write("feed");
+  task_environment_.RunUntilIdle();
+
+  absl::optional<std::string> result = std::string("unset");
+  cache_file.Read(base::BindLambdaForTesting(
+      [&result](absl::optional<std::string> data) {
+        result = std::move(data);
+      }));
+  cache_file.Delete();
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(result);
+  EXPECT_FALSE(Read(&cache_file));
+}
+
+TEST_F(BraveNewsCacheFileTest, DropsOtherFormatVersion) {
+  CacheFile cache_file(GetPath(), 1);
+  cache_file.Write("feed");
+  task_environment_.RunUntilIdle();
+
+  CacheFile next_version(GetPath(), 2);
+  EXPECT_FALSE(Read(&next_version));
+}
+
+TEST_F(BraveNewsCacheFileTest, DropsFileWithoutFormatVersion) {
+  ASSERT_TRUE(base::WriteFile(GetPath(), "fe"));
+
+  CacheFile cache_file(GetPath(), 1);
+  EXPECT_FALSE(Read(&cache_file));
+}
+
+TEST_F(BraveNewsCacheFileTest, EmptyPathIsNeverRead) {
+  CacheFile cache_file(base::FilePath(), 1);
+  cache_file.Write("feed");
+  EXPECT_FALSE(Read(&cache_file));
+}
+
+}  // namespace brave_news
@@ -9,6 +9,7 @@
 #include <string>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/callback_forward.h"
@@ -16,17 +17,21 @@
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_private_cdn/headers.h"
 #include "brave/components/brave_today/browser/feed_building.h"
+#include "brave/components/brave_today/browser/network.h"
 #include "brave/components/brave_today/browser/publishers_controller.h"
 #include "brave/components/brave_today/browser/urls.h"
 #include "brave/components/brave_today/common/brave_news.mojom.h"
 #include "components/history/core/browser/history_service.h"
 #include "components/history/core/browser/history_types.h"
+#include "net/http/http_status_code.h"
 
 namespace brave_news {
 
 namespace {
 
-const char kEtagHeaderKey[] = "etag";
+// Must be incremented whenever mojom::FeedCacheRecord, or any struct it
+// holds, changes.
+constexpr uint32_t kFeedCacheFormatVersion = 1;
 
 GURL GetFeedUrl() {
   GURL feed_url("https://" + brave_today::GetHostname() + "/brave-today/feed." +
@@ -39,13 +44,17 @@ GURL GetFeedUrl() {
 FeedController::FeedController(
     PublishersController* publishers_controller,
     history::HistoryService* history_service,
-    api_request_helper::APIRequestHelper* api_request_helper)
+    api_request_helper::APIRequestHelper* api_request_helper,
+    const base::FilePath& cache_path)
     : publishers_controller_(publishers_controller),
       history_service_(history_service),
       api_request_helper_(api_request_helper),
+      cache_file_(cache_path, kFeedCacheFormatVersion),
       on_current_update_complete_(new base::OneShotEvent()),
       publishers_observation_(this) {
   publishers_observation_.Observe(publishers_controller);
+  cache_file_.Read(base::BindOnce(&FeedController::OnCacheRead,
+                                  weak_ptr_factory_.GetWeakPtr()));
 }
 
 FeedController::~FeedController() = default;
@@ -80,7 +89,11 @@ void FeedController::GetOrFetchFeed(GetFeedCallback callback) {
 }
 
 void FeedController::EnsureFeedIsUpdating() {
-  VLOG(1) << "EnsureFeedIsUpdating " << is_update_in_progress_;
+  FetchFeed(false);
+}
+
+void FeedController::FetchFeed(bool if_changed) {
+  VLOG(1) << "FetchFeed " << is_update_in_progress_;
   // Only 1 update at a time, other calls for data will wait for
   // the current operation via the `on_publishers_update_` OneShotEvent.
   if (is_update_in_progress_) {
@@ -93,13 +106,19 @@ void FeedController::EnsureFeedIsUpdating() {
   // us to do Promise.all and do call these 3 async functions
   // in parallel.
   auto onRequest = base::BindOnce(
-      [](FeedController* controller, int status, const std::string& body,
+      [](FeedController* controller, int cache_generation, int status,
+         const std::string& body,
          const base::flat_map<std::string, std::string>& headers) {
         std::string etag;
         if (headers.contains(kEtagHeaderKey)) {
           etag = headers.at(kEtagHeaderKey);
         }
         VLOG(1) << "Downloaded feed, status: " << status << " etag: " << etag;
+        // Feed is the one we already have
+        if (status == net::HTTP_NOT_MODIFIED) {
+          controller->NotifyUpdateDone();
+          return;
+        }
         // Handle bad response
         if (status < 200 || status >= 300) {
           LOG(ERROR) << "Bad response from brave news feed.json. Status: "
@@ -110,8 +129,9 @@ void FeedController::EnsureFeedIsUpdating() {
 
         // Fetch publishers via callback
         auto onPublishers = base::BindOnce(
-            [](FeedController* controller, const std::string& body,
-               const std::string& etag, Publishers publishers) {
+            [](FeedController* controller, int cache_generation,
+               const std::string& body, const std::string& etag,
+               Publishers publishers) {
               // Handle no publishers
               if (publishers.empty()) {
                 LOG(ERROR) << "Brave News Publisher list was empty";
@@ -120,9 +140,16 @@ void FeedController::EnsureFeedIsUpdating() {
               }
               // Get history hosts via callback
               auto onHistory = base::BindOnce(
-                  [](FeedController* controller, const std::string& body,
-                     const std::string& etag, Publishers publishers,
-                     history::QueryResults results) {
+                  [](FeedController* controller, int cache_generation,
+                     const std::string& body, const std::string& etag,
+                     Publishers publishers, history::QueryResults results) {
+                    // The history this feed would be ranked by, or the
+                    // feed itself, was cleared while it was being fetched.
+                    if (cache_generation != controller->cache_generation_) {
+                      VLOG(1) << "Dropping feed fetched before clearing";
+                      controller->NotifyUpdateDone();
+                      return;
+                    }
                     std::unordered_set<std::string> history_hosts;
                     for (const auto& item : results) {
                       auto host = item.url().host();
@@ -136,14 +163,15 @@ void FeedController::EnsureFeedIsUpdating() {
                       // Only mark cache time of remote request if
                       // parsing was successful
                       controller->current_feed_etag_ = etag;
+                      controller->WriteCache();
                     } else {
                       VLOG(1) << "ParseFeed reported failure.";
                     }
                     // Let any callbacks know that the data is ready or errored.
                     controller->NotifyUpdateDone();
                   },
-                  base::Unretained(controller), std::move(body),
-                  std::move(etag), std::move(publishers));
+                  base::Unretained(controller), cache_generation,
+                  std::move(body), std::move(etag), std::move(publishers));
               history::QueryOptions options;
               options.max_count = 2000;
               options.SetRecentDayRange(14);
@@ -151,16 +179,23 @@ void FeedController::EnsureFeedIsUpdating() {
                   std::u16string(), options, std::move(onHistory),
                   &controller->task_tracker_);
             },
-            base::Unretained(controller), std::move(body), std::move(etag));
+            base::Unretained(controller), cache_generation, std::move(body),
+            std::move(etag));
         controller->publishers_controller_->GetOrFetchPublishers(
             std::move(onPublishers));
       },
-      base::Unretained(this));
+      base::Unretained(this), cache_generation_);
   GURL feed_url(GetFeedUrl());
   VLOG(1) << "Making feed request to " << feed_url.spec();
-  api_request_helper_->Request("GET", feed_url, "", "", true,
-                               std::move(onRequest),
-                               brave::private_cdn_headers);
+  // Revalidate what we have so that an unchanged feed costs a 304.
+  auto headers = brave::private_cdn_headers;
+  if (if_changed && !current_feed_.hash.empty() &&
+      !current_feed_etag_.empty()) {
+    headers[kIfNoneMatchHeaderKey] = current_feed_etag_;
+  }
+  api_request_helper_->Request("GET", feed_url, "", "",
+                               GetRequestOptions(kMaxFeedBodySize),
+                               std::move(onRequest), headers);
 }
 
 void FeedController::EnsureFeedIsCached() {
@@ -171,50 +206,19 @@ void FeedController::EnsureFeedIsCached() {
 
 void FeedController::UpdateIfRemoteChanged() {
   // If already updating, nothing to do,
-  // we don't want to collide with an update
-  // which starts and completes before our HEAD
-  // request completes (which admittedly is very unlikely).
+  // we don't want to collide with an update.
   if (is_update_in_progress_) {
     return;
   }
-  // Get new Etag
-  api_request_helper_->Request(
-      "HEAD", GetFeedUrl(), "", "", true,
-      base::BindOnce(
-          [](FeedController* controller, const int status,
-             const std::string& body,
-             const base::flat_map<std::string, std::string>& headers) {
-            std::string etag;
-            if (headers.contains(kEtagHeaderKey)) {
-              etag = headers.at(kEtagHeaderKey);
-            }
-            // Empty etag means perhaps server isn't supporting
-            // the header right now, so we assume we should
-            // always fetch the body at these times.
-            if (etag.empty()) {
-              LOG(ERROR) << "Brave News did not get correct etag, "
-                            "therefore assuming etags aren't working and feed "
-                            "changed.";
-              controller->EnsureFeedIsUpdating();
-              return;
-            }
-            VLOG(1) << "Comparing feed etag - "
-                       "Original: "
-                    << controller->current_feed_etag_ << " Remote: " << etag;
-            // Compare remote etag with last feed fetch.
-            if (controller->current_feed_etag_ == etag) {
-              // Nothing to do
-              return;
-            }
-            // Needs update
-            controller->EnsureFeedIsUpdating();
-          },
-          base::Unretained(this)),
-      brave::private_cdn_headers);
+  FetchFeed(true);
 }
 
 void FeedController::ClearCache() {
   ResetFeed();
+  current_feed_etag_.clear();
+  cache_generation_++;
+  // The feed is ranked by browsing history, so it mustn't outlive it.
+  cache_file_.Delete();
 }
 
 void FeedController::OnPublishersUpdated(PublishersController* controller) {
@@ -225,6 +229,19 @@ void FeedController::OnPublishersUpdated(PublishersController* controller) {
 void FeedController::GetOrFetchFeed(base::OnceClosure callback) {
   VLOG(1) << "getorfetch feed(oc) start: "
           << on_current_update_complete_->is_signaled();
+  // Wait for the feed from the previous session first.
+  if (!on_cache_read_.is_signaled()) {
+    on_cache_read_.Post(
+        FROM_HERE,
+        base::BindOnce(
+            [](base::WeakPtr<FeedController> controller,
+               base::OnceClosure callback) {
+              if (controller)
+                controller->GetOrFetchFeed(std::move(callback));
+            },
+            weak_ptr_factory_.GetWeakPtr(), std::move(callback)));
+    return;
+  }
   // If in-memory feed is, no need to wait, otherwise wait for fetch
   // to be complete.
   if (!current_feed_.hash.empty()) {
@@ -244,6 +261,33 @@ void FeedController::ResetFeed() {
   current_feed_.pages.clear();
 }
 
+void FeedController::OnCacheRead(absl::optional<std::string> data) {
+  mojom::FeedCacheRecord record;
+  const bool has_cache =
+      data && current_feed_.hash.empty() &&
+      mojom::FeedCacheRecord::Deserialize(data->data(), data->size(),
+                                          &record) &&
+      record.feed && !record.feed->hash.empty();
+  if (has_cache) {
+    VLOG(1) << "Read feed from cache, etag: " << record.etag;
+    current_feed_ = std::move(*record.feed);
+    current_feed_etag_ = std::move(record.etag);
+  }
+  on_cache_read_.Signal();
+  // Show the cached feed straight away and check it in the background.
+  if (has_cache) {
+    UpdateIfRemoteChanged();
+  }
+}
+
+void FeedController::WriteCache() {
+  mojom::FeedCacheRecord record;
+  record.etag = current_feed_etag_;
+  record.feed = current_feed_.Clone();
+  const std::vector<uint8_t> data = mojom::FeedCacheRecord::Serialize(&record);
+  cache_file_.Write(std::string(data.begin(), data.end()));
+}
+
 void FeedController::NotifyUpdateDone() {
   // Let any callbacks know that the data is ready.
   on_current_update_complete_->Signal();
@@ -9,9 +9,12 @@
 #include <memory>
 #include <string>
 
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
 #include "base/one_shot_event.h"
 #include "base/scoped_observation.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
+#include "brave/components/brave_today/browser/cache_file.h"
 #include "brave/components/brave_today/browser/publishers_controller.h"
 #include "brave/components/brave_today/common/brave_news.mojom.h"
 #include "components/history/core/browser/history_service.h"
@@ -26,9 +29,12 @@ using GetFeedCallback = mojom::BraveNewsController::GetFeedCallback;
 
 class FeedController : public PublishersController::Observer {
  public:
+  // The built feed is saved to |cache_path| and shown from there in the next
+  // session while it is revalidated.
   FeedController(PublishersController* publishers_controller,
                  history::HistoryService* history_service,
-                 api_request_helper::APIRequestHelper* api_request_helper);
+                 api_request_helper::APIRequestHelper* api_request_helper,
+                 const base::FilePath& cache_path);
   ~FeedController() override;
   FeedController(const FeedController&) = delete;
   FeedController& operator=(const FeedController&) = delete;
@@ -46,6 +52,8 @@ class FeedController : public PublishersController::Observer {
   // occured and that we have data (if there was no problem fetching or
   // parsing).
   void EnsureFeedIsCached();
+  // Fetches the feed unless the remote one still matches the ETag of the one
+  // we have.
   void UpdateIfRemoteChanged();
   void ClearCache();
 
@@ -59,25 +67,36 @@ class FeedController : public PublishersController::Observer {
 
  private:
   void GetOrFetchFeed(base::OnceClosure callback);
+  void FetchFeed(bool if_changed);
+  void OnCacheRead(absl::optional<std::string> data);
+  void WriteCache();
   void ResetFeed();
   void NotifyUpdateDone();
 
   PublishersController* publishers_controller_;
   history::HistoryService* history_service_;
   api_request_helper::APIRequestHelper* api_request_helper_;
+  CacheFile cache_file_;
 
   // The task tracker for the HistoryService callbacks.
   base::CancelableTaskTracker task_tracker_;
   // Internal callers subscribe to this to know when the current in-progress
   // fetch and parse is complete.
   std::unique_ptr<base::OneShotEvent> on_current_update_complete_;
+  // Signaled once the feed from the previous session has been read, which
+  // data requests wait for.
+  base::OneShotEvent on_cache_read_;
   base::ScopedObservation<PublishersController, PublishersController::Observer>
       publishers_observation_;
   // Store a copy of the feed in memory so we don't fetch new data from remote
   // every time the UI opens.
   mojom::Feed current_feed_;
   std::string current_feed_etag_;
+  // Incremented by ClearCache() so that a fetch started before then neither
+  // installs nor writes its feed.
+  int cache_generation_ = 0;
   bool is_update_in_progress_ = false;
+  base::WeakPtrFactory<FeedController> weak_ptr_factory_{this};
 };
 
 }  // namespace brave_news
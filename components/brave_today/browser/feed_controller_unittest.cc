@@ -0,0 +1,238 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/feed_controller.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "brave/components/brave_today/browser/publishers_controller.h"
+#include "brave/components/brave_today/browser/urls.h"
+#include "brave/components/brave_today/common/pref_names.h"
+#include "components/history/core/browser/history_service.h"
+#include "components/history/core/test/history_service_test_util.h"
+#include "components/prefs/testing_pref_service.h"
+#include "net/http/http_status_code.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "services/network/test/test_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_news {
+
+namespace {
+
+constexpr char kPublishersJson[] = R"([
+    {
+      "publisher_id": "111",
+      "publisher_name": "Test Publisher 1",
+      "category": "Tech",
+      "enabled": true
+    }
+  ])";
+
+constexpr char kFeedJson[] = R"([
+    {
+      "category": "Technology",
+      "publish_time": "2021-09-01 07:01:28",
+      "url": "https://www.example.com/an-article/",
+      "title": "An article",
+      "description": "About something.",
+      "content_type": "article",
+      "publisher_id": "111",
+      "publisher_name": "Test Publisher 1",
+      "creative_instance_id": "",
+      "url_hash": "523b9f2091474c2a082c06ec17965f8c",
+      "padded_img": "https://pcdn.brave.com/brave-today/cache/1.jpg.pad",
+      "score": 13.93160989810695
+    }
+  ])";
+
+GURL GetSourcesUrl() {
+  return GURL("https://" + brave_today::GetHostname() + "/sources." +
+              brave_today::GetRegionUrlPart() + "json");
+}
+
+GURL GetFeedUrl() {
+  return GURL("https://" + brave_today::GetHostname() + "/brave-today/feed." +
+              brave_today::GetRegionUrlPart() + "json");
+}
+
+}  // namespace
+
+class BraveNewsFeedControllerTest : public testing::Test {
+ public:
+  BraveNewsFeedControllerTest()
+      : api_request_helper_(
+            TRAFFIC_ANNOTATION_FOR_TESTS,
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)) {
+    prefs_.registry()->RegisterDictionaryPref(prefs::kBraveTodaySources);
+  }
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    history_service_ =
+        history::CreateHistoryService(temp_dir_.GetPath(), true);
+    ASSERT_TRUE(history_service_);
+  }
+
+  void TearDown() override {
+    feed_controller_.reset();
+    publishers_controller_.reset();
+    history_service_.reset();
+    task_environment_.RunUntilIdle();
+  }
+
+ protected:
+  // Starts a session reading the caches left by the previous one.
+  void StartSession() {
+    feed_controller_.reset();
+    publishers_controller_.reset();
+    url_loader_factory_.ClearResponses();
+    publishers_controller_ = std::make_unique<PublishersController>(
+        &prefs_, &api_request_helper_,
+        temp_dir_.GetPath().AppendASCII("publishers"));
+    feed_controller_ = std::make_unique<FeedController>(
+        publishers_controller_.get(), history_service_.get(),
+        &api_request_helper_, GetFeedCachePath());
+  }
+
+  mojom::FeedPtr GetFeed() {
+    mojom::FeedPtr result;
+    feed_controller_->GetOrFetchFeed(
+        base::BindLambdaForTesting([&result](mojom::FeedPtr feed) {
+          result = std::move(feed);
+        }));
+    task_environment_.RunUntilIdle();
+    history::BlockUntilHistoryProcessesPendingRequests(history_service_.get());
+    task_environment_.RunUntilIdle();
+    return result;
+  }
+
+  void AddResponse(const GURL& url,
+                   const std::string& body,
+                   const std::string& etag) {
+    auto head = network::CreateURLResponseHead(net::HTTP_OK);
+    head->headers->AddHeader("ETag", etag);
+    url_loader_factory_.AddResponse(url, std::move(head), body,
+                                    network::URLLoaderCompletionStatus());
+  }
+
+  // Returns the If-None-Match header of the pending feed request.
+  std::string GetPendingIfNoneMatch() {
+    std::string if_none_match;
+    for (const auto& pending : *url_loader_factory_.pending_requests()) {
+      if (pending.request.url == GetFeedUrl()) {
+        pending.request.headers.GetHeader("If-None-Match", &if_none_match);
+      }
+    }
+    return if_none_match;
+  }
+
+  // Fetches the feed in a first session so that the next one starts from the
+  // cache. Returns the feed's hash.
+  std::string FillCache() {
+    StartSession();
+    AddResponse(GetSourcesUrl(), kPublishersJson, "\"p1\"");
+    AddResponse(GetFeedUrl(), kFeedJson, "\"f1\"");
+    mojom::FeedPtr feed = GetFeed();
+    EXPECT_TRUE(feed);
+    StartSession();
+    return feed ? feed->hash : "";
+  }
+
+  base::FilePath GetFeedCachePath() const {
+    return temp_dir_.GetPath().AppendASCII("feed");
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  TestingPrefServiceSimple prefs_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  api_request_helper::APIRequestHelper api_request_helper_;
+  std::unique_ptr<history::HistoryService> history_service_;
+  std::unique_ptr<PublishersController> publishers_controller_;
+  std::unique_ptr<FeedController> feed_controller_;
+};
+
+TEST_F(BraveNewsFeedControllerTest, ColdStartReadsCache) {
+  const std::string hash = FillCache();
+  ASSERT_FALSE(hash.empty());
+
+  mojom::FeedPtr feed = GetFeed();
+  ASSERT_TRUE(feed);
+  EXPECT_EQ(hash, feed->hash);
+  // The cached feed is revalidated in the background.
+  EXPECT_EQ("\"f1\"", GetPendingIfNoneMatch());
+}
+
+TEST_F(BraveNewsFeedControllerTest, NotModifiedKeepsFeed) {
+  const std::string hash = FillCache();
+  GetFeed();
+
+  url_loader_factory_.AddResponse(GetFeedUrl().spec(), "",
+                                  net::HTTP_NOT_MODIFIED);
+  task_environment_.RunUntilIdle();
+
+  mojom::FeedPtr feed = GetFeed();
+  ASSERT_TRUE(feed);
+  EXPECT_EQ(hash, feed->hash);
+}
+
+TEST_F(BraveNewsFeedControllerTest, FailedRevalidationKeepsFeed) {
+  const std::string hash = FillCache();
+  GetFeed();
+
+  url_loader_factory_.AddResponse(
+      GetFeedUrl(), network::mojom::URLResponseHead::New(), "",
+      network::URLLoaderCompletionStatus(net::ERR_INTERNET_DISCONNECTED));
+  task_environment_.RunUntilIdle();
+
+  mojom::FeedPtr feed = GetFeed();
+  ASSERT_TRUE(feed);
+  EXPECT_EQ(hash, feed->hash);
+}
+
+TEST_F(BraveNewsFeedControllerTest, ClearCacheDeletesFeedFile) {
+  FillCache();
+  ASSERT_TRUE(base::PathExists(GetFeedCachePath()));
+
+  feed_controller_->ClearCache();
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(base::PathExists(GetFeedCachePath()));
+
+  // The next session has to fetch the feed rather than revalidate one.
+  StartSession();
+  GetFeed();
+  EXPECT_TRUE(url_loader_factory_.IsPending(GetFeedUrl().spec()));
+  EXPECT_EQ("", GetPendingIfNoneMatch());
+}
+
+TEST_F(BraveNewsFeedControllerTest, ClearCacheDropsFeedFetchedBefore) {
+  StartSession();
+  AddResponse(GetSourcesUrl(), kPublishersJson, "\"p1\"");
+  feed_controller_->EnsureFeedIsUpdating();
+  task_environment_.RunUntilIdle();
+  ASSERT_TRUE(url_loader_factory_.IsPending(GetFeedUrl().spec()));
+
+  // The feed arrives after the history, and so the caches, were cleared.
+  feed_controller_->ClearCache();
+  AddResponse(GetFeedUrl(), kFeedJson, "\"f1\"");
+  task_environment_.RunUntilIdle();
+  history::BlockUntilHistoryProcessesPendingRequests(history_service_.get());
+  task_environment_.RunUntilIdle();
+
+  EXPECT_FALSE(base::PathExists(GetFeedCachePath()));
+}
+
+}  // namespace brave_news
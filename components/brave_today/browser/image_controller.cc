@@ -0,0 +1,154 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/image_controller.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/containers/flat_map.h"
+#include "base/containers/span.h"
+#include "base/strings/string_piece.h"
+#include "brave/components/brave_private_cdn/headers.h"
+#include "brave/components/brave_private_cdn/private_cdn_helper.h"
+#include "brave/components/brave_today/browser/network.h"
+#include "mojo/public/cpp/base/big_buffer.h"
+
+namespace brave_news {
+
+namespace {
+
+mojo_base::BigBuffer ToBigBuffer(const base::RefCountedBytes& image) {
+  // Large images are written straight into shared memory rather than being
+  // copied again when the mojo message is serialized.
+  return mojo_base::BigBuffer(base::make_span(image.front(), image.size()));
+}
+
+}  // namespace
+
+ImageController::ImageController(
+    api_request_helper::APIRequestHelper* api_request_helper)
+    : api_request_helper_(api_request_helper),
+      cache_(decltype(cache_)::NO_AUTO_EVICT) {}
+
+ImageController::~ImageController() = default;
+
+void ImageController::GetImageData(const GURL& padded_image_url,
+                                   GetImageDataCallback callback) {
+  auto cached = cache_.Get(padded_image_url);
+  if (cached != cache_.end()) {
+    std::move(callback).Run(ToBigBuffer(*cached->second));
+    return;
+  }
+  pending_[padded_image_url].push_back(std::move(callback));
+  Enqueue(padded_image_url, true);
+  StartFetches();
+}
+
+void ImageController::PrefetchImages(
+    const std::vector<GURL>& padded_image_urls) {
+  for (const auto& padded_image_url : padded_image_urls) {
+    if (!padded_image_url.is_valid() ||
+        cache_.Peek(padded_image_url) != cache_.end() ||
+        pending_.contains(padded_image_url)) {
+      continue;
+    }
+    pending_[padded_image_url];
+    Enqueue(padded_image_url, false);
+  }
+  StartFetches();
+}
+
+void ImageController::ClearCache() {
+  cache_.Clear();
+  cache_bytes_ = 0;
+  cache_generation_++;
+  // Nobody is waiting for queued prefetches, so forget them too.
+  prefetch_queue_.clear();
+  base::EraseIf(pending_, [this](const auto& item) {
+    return item.second.empty() && !in_flight_.contains(item.first);
+  });
+}
+
+void ImageController::Enqueue(const GURL& padded_image_url, bool is_visible) {
+  if (in_flight_.contains(padded_image_url))
+    return;
+  // An image that was prefetched and is now being shown jumps ahead; its
+  // prefetch queue entry is skipped once it has been fetched.
+  (is_visible ? visible_queue_ : prefetch_queue_).push_back(padded_image_url);
+}
+
+void ImageController::StartFetches() {
+  while (in_flight_.size() < kMaxConcurrentImageFetches) {
+    auto& queue = !visible_queue_.empty() ? visible_queue_ : prefetch_queue_;
+    if (queue.empty())
+      return;
+    GURL padded_image_url = std::move(queue.front());
+    queue.pop_front();
+    if (!pending_.contains(padded_image_url) ||
+        !in_flight_.insert(padded_image_url).second) {
+      continue;
+    }
+    api_request_helper_->Request(
+        "GET", padded_image_url, "", "", GetRequestOptions(kMaxImageBodySize),
+        base::BindOnce(&ImageController::OnImageResponse,
+                       weak_ptr_factory_.GetWeakPtr(), padded_image_url,
+                       cache_generation_),
+        brave::private_cdn_headers);
+  }
+}
+
+void ImageController::OnImageResponse(
+    const GURL& padded_image_url,
+    const int cache_generation,
+    const int status,
+    const std::string& body,
+    const base::flat_map<std::string, std::string>& headers) {
+  in_flight_.erase(padded_image_url);
+  std::vector<GetImageDataCallback> callbacks;
+  auto it = pending_.find(padded_image_url);
+  if (it != pending_.end()) {
+    callbacks = std::move(it->second);
+    pending_.erase(it);
+  }
+
+  // Attempt to remove byte padding
+  base::StringPiece body_payload(body.data(), body.size());
+  if (status < 200 || status >= 300 ||
+      !brave::PrivateCdnHelper::GetInstance()->RemovePadding(&body_payload)) {
+    VLOG(1) << "News: could not get image " << padded_image_url.spec();
+    for (auto& callback : callbacks)
+      std::move(callback).Run(absl::nullopt);
+  } else {
+    auto image = base::MakeRefCounted<base::RefCountedBytes>(
+        reinterpret_cast<const unsigned char*>(body_payload.data()),
+        body_payload.size());
+    for (auto& callback : callbacks)
+      std::move(callback).Run(ToBigBuffer(*image));
+    if (cache_generation == cache_generation_)
+      AddToCache(padded_image_url, std::move(image));
+  }
+  StartFetches();
+}
+
+void ImageController::AddToCache(const GURL& padded_image_url,
+                                 scoped_refptr<base::RefCountedBytes> image) {
+  if (image->size() > kMaxImageCacheBytes)
+    return;
+  auto existing = cache_.Peek(padded_image_url);
+  if (existing != cache_.end()) {
+    cache_bytes_ -= existing->second->size();
+    cache_.Erase(existing);
+  }
+  cache_bytes_ += image->size();
+  cache_.Put(padded_image_url, std::move(image));
+  while (cache_bytes_ > kMaxImageCacheBytes) {
+    auto oldest = cache_.rbegin();
+    cache_bytes_ -= oldest->second->size();
+    cache_.Erase(oldest);
+  }
+}
+
+}  // namespace brave_news
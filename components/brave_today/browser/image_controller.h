@@ -0,0 +1,84 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_IMAGE_CONTROLLER_H_
+#define BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_IMAGE_CONTROLLER_H_
+
+#include <string>
+#include <vector>
+
+#include "base/containers/circular_deque.h"
+#include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
+#include "base/containers/mru_cache.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/weak_ptr.h"
+#include "brave/components/api_request_helper/api_request_helper.h"
+#include "brave/components/brave_today/common/brave_news.mojom.h"
+#include "url/gurl.h"
+
+namespace brave_news {
+
+using GetImageDataCallback = mojom::BraveNewsController::GetImageDataCallback;
+
+// Unpadded images are kept in memory up to this many bytes, least recently
+// used first out.
+constexpr size_t kMaxImageCacheBytes = 16 * 1024 * 1024;
+// Number of image downloads allowed at the same time.
+constexpr size_t kMaxConcurrentImageFetches = 4;
+
+// Downloads and unpads Brave News card images from the private CDN.
+// Unpadded images are cached so that scrolling back or reopening the NTP
+// doesn't download them again, and requests for an image that is already
+// being fetched wait for that fetch. Downloads are limited to a few at a
+// time, with images for cards being shown going before prefetched ones.
+class ImageController {
+ public:
+  explicit ImageController(
+      api_request_helper::APIRequestHelper* api_request_helper);
+  ~ImageController();
+  ImageController(const ImageController&) = delete;
+  ImageController& operator=(const ImageController&) = delete;
+
+  void GetImageData(const GURL& padded_image_url,
+                    GetImageDataCallback callback);
+  // Fetches |padded_image_urls| into the cache, behind any images that have
+  // been asked for by GetImageData().
+  void PrefetchImages(const std::vector<GURL>& padded_image_urls);
+  // Drops cached and prefetch-only queued images. Fetches in progress still
+  // answer their callbacks, but their images are not cached.
+  void ClearCache();
+
+ private:
+  void Enqueue(const GURL& padded_image_url, bool is_visible);
+  void StartFetches();
+  void OnImageResponse(const GURL& padded_image_url,
+                       const int cache_generation,
+                       const int status,
+                       const std::string& body,
+                       const base::flat_map<std::string, std::string>& headers);
+  void AddToCache(const GURL& padded_image_url,
+                  scoped_refptr<base::RefCountedBytes> image);
+
+  api_request_helper::APIRequestHelper* api_request_helper_;
+
+  base::MRUCache<GURL, scoped_refptr<base::RefCountedBytes>> cache_;
+  size_t cache_bytes_ = 0;
+  // Incremented by ClearCache() so that fetches started before then don't
+  // put their images back in the cache.
+  int cache_generation_ = 0;
+  // Callbacks waiting for each queued or in-flight image. Prefetched images
+  // have none until somebody asks for them.
+  base::flat_map<GURL, std::vector<GetImageDataCallback>> pending_;
+  base::circular_deque<GURL> visible_queue_;
+  base::circular_deque<GURL> prefetch_queue_;
+  base::flat_set<GURL> in_flight_;
+
+  base::WeakPtrFactory<ImageController> weak_ptr_factory_{this};
+};
+
+}  // namespace brave_news
+
+#endif  // BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_IMAGE_CONTROLLER_H_
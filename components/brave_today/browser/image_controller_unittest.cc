@@ -0,0 +1,184 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/image_controller.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/big_endian.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "mojo/public/cpp/base/big_buffer.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_news {
+
+namespace {
+
+std::string Pad(const std::string& image) {
+  char length[4];
+  base::WriteBigEndian(length, static_cast<uint32_t>(image.size()));
+  return std::string(length, sizeof(length)) + image + "padding";
+}
+
+GURL GetImageUrl(size_t index) {
+  return GURL(base::StringPrintf("https://pcdn.brave.com/%zu.jpg.pad", index));
+}
+
+}  // namespace
+
+class BraveNewsImageControllerTest : public testing::Test {
+ public:
+  BraveNewsImageControllerTest()
+      : api_request_helper_(
+            TRAFFIC_ANNOTATION_FOR_TESTS,
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)),
+        image_controller_(&api_request_helper_) {}
+
+ protected:
+  GetImageDataCallback SaveImageData(
+      std::vector<absl::optional<std::string>>* images) {
+    return base::BindLambdaForTesting(
+        [images](absl::optional<mojo_base::BigBuffer> image_data) {
+          if (!image_data) {
+            images->push_back(absl::nullopt);
+            return;
+          }
+          images->push_back(std::string(image_data->data(),
+                                        image_data->data() +
+                                            image_data->size()));
+        });
+  }
+
+  void Respond(const GURL& url, const std::string& content) {
+    url_loader_factory_.AddResponse(url.spec(), content);
+    task_environment_.RunUntilIdle();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  api_request_helper::APIRequestHelper api_request_helper_;
+  ImageController image_controller_;
+};
+
+TEST_F(BraveNewsImageControllerTest, UnpadsImage) {
+  std::vector<absl::optional<std::string>> images;
+  image_controller_.GetImageData(GetImageUrl(0), SaveImageData(&images));
+  Respond(GetImageUrl(0), Pad("image"));
+
+  ASSERT_EQ(1u, images.size());
+  EXPECT_EQ("image", images[0]);
+}
+
+TEST_F(BraveNewsImageControllerTest, FailsOnBadPadding) {
+  std::vector<absl::optional<std::string>> images;
+  image_controller_.GetImageData(GetImageUrl(0), SaveImageData(&images));
+  Respond(GetImageUrl(0), "xx");
+
+  ASSERT_EQ(1u, images.size());
+  EXPECT_FALSE(images[0]);
+}
+
+TEST_F(BraveNewsImageControllerTest, CoalescesDuplicateRequests) {
+  std::vector<absl::optional<std::string>> images;
+  image_controller_.GetImageData(GetImageUrl(0), SaveImageData(&images));
+  image_controller_.GetImageData(GetImageUrl(0), SaveImageData(&images));
+  EXPECT_EQ(1, url_loader_factory_.NumPending());
+
+  Respond(GetImageUrl(0), Pad("image"));
+  ASSERT_EQ(2u, images.size());
+  EXPECT_EQ("image", images[0]);
+  EXPECT_EQ("image", images[1]);
+}
+
+TEST_F(BraveNewsImageControllerTest, ServesCachedImage) {
+  std::vector<absl::optional<std::string>> images;
+  image_controller_.GetImageData(GetImageUrl(0), SaveImageData(&images));
+  Respond(GetImageUrl(0), Pad("image"));
+  url_loader_factory_.ClearResponses();
+
+  image_controller_.GetImageData(GetImageUrl(0), SaveImageData(&images));
+  EXPECT_EQ(0, url_loader_factory_.NumPending());
+  ASSERT_EQ(2u, images.size());
+  EXPECT_EQ("image", images[1]);
+
+  image_controller_.ClearCache();
+  image_controller_.GetImageData(GetImageUrl(0), SaveImageData(&images));
+  EXPECT_EQ(1, url_loader_factory_.NumPending());
+}
+
+TEST_F(BraveNewsImageControllerTest, LimitsConcurrentFetches) {
+  std::vector<absl::optional<std::string>> images;
+  for (size_t i = 0; i < kMaxConcurrentImageFetches + 2; i++)
+    image_controller_.GetImageData(GetImageUrl(i), SaveImageData(&images));
+  EXPECT_EQ(static_cast<int>(kMaxConcurrentImageFetches),
+            url_loader_factory_.NumPending());
+
+  Respond(GetImageUrl(0), Pad("image"));
+  EXPECT_TRUE(url_loader_factory_.IsPending(
+      GetImageUrl(kMaxConcurrentImageFetches).spec()));
+}
+
+TEST_F(BraveNewsImageControllerTest, FetchesVisibleImagesBeforePrefetched) {
+  std::vector<GURL> prefetch_urls;
+  for (size_t i = 0; i < kMaxConcurrentImageFetches + 2; i++)
+    prefetch_urls.push_back(GetImageUrl(i));
+  image_controller_.PrefetchImages(prefetch_urls);
+  const GURL visible_url = GetImageUrl(100);
+  std::vector<absl::optional<std::string>> images;
+  image_controller_.GetImageData(visible_url, SaveImageData(&images));
+  EXPECT_FALSE(url_loader_factory_.IsPending(visible_url.spec()));
+
+  Respond(GetImageUrl(0), Pad("image"));
+  EXPECT_TRUE(url_loader_factory_.IsPending(visible_url.spec()));
+  EXPECT_FALSE(url_loader_factory_.IsPending(
+      GetImageUrl(kMaxConcurrentImageFetches).spec()));
+}
+
+TEST_F(BraveNewsImageControllerTest, ServesPrefetchedImage) {
+  image_controller_.PrefetchImages({GetImageUrl(0)});
+  Respond(GetImageUrl(0), Pad("image"));
+  url_loader_factory_.ClearResponses();
+
+  std::vector<absl::optional<std::string>> images;
+  image_controller_.GetImageData(GetImageUrl(0), SaveImageData(&images));
+  EXPECT_EQ(0, url_loader_factory_.NumPending());
+  ASSERT_EQ(1u, images.size());
+  EXPECT_EQ("image", images[0]);
+}
+
+TEST_F(BraveNewsImageControllerTest, DoesNotCacheFetchStartedBeforeClear) {
+  std::vector<absl::optional<std::string>> images;
+  image_controller_.GetImageData(GetImageUrl(0), SaveImageData(&images));
+  image_controller_.ClearCache();
+  Respond(GetImageUrl(0), Pad("image"));
+  ASSERT_EQ(1u, images.size());
+  EXPECT_EQ("image", images[0]);
+  url_loader_factory_.ClearResponses();
+
+  image_controller_.GetImageData(GetImageUrl(0), SaveImageData(&images));
+  EXPECT_EQ(1, url_loader_factory_.NumPending());
+}
+
+TEST_F(BraveNewsImageControllerTest, ClearDropsQueuedPrefetches) {
+  std::vector<GURL> prefetch_urls;
+  for (size_t i = 0; i < kMaxConcurrentImageFetches + 1; i++)
+    prefetch_urls.push_back(GetImageUrl(i));
+  image_controller_.PrefetchImages(prefetch_urls);
+  image_controller_.ClearCache();
+
+  Respond(GetImageUrl(0), Pad("image"));
+  EXPECT_FALSE(url_loader_factory_.IsPending(
+      GetImageUrl(kMaxConcurrentImageFetches).spec()));
+}
+
+}  // namespace brave_news
@@ -31,4 +31,12 @@ net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
     )");
 }
 
+api_request_helper::APIRequestOptions GetRequestOptions(size_t max_body_size) {
+  api_request_helper::APIRequestOptions options;
+  options.auto_retry_on_network_change = true;
+  options.max_body_size = max_body_size;
+  options.timeout = base::TimeDelta::FromMinutes(1);
+  return options;
+}
+
 }  // namespace brave_news
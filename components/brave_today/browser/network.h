@@ -5,11 +5,22 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_NETWORK_H_
 #define BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_NETWORK_H_
 
+#include "brave/components/api_request_helper/api_request_helper.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
 
 namespace brave_news {
 
+// Response headers are keyed in lower case by APIRequestHelper.
+constexpr char kEtagHeaderKey[] = "etag";
+constexpr char kIfNoneMatchHeaderKey[] = "If-None-Match";
+
+// Responses bigger than these are dropped rather than held in memory.
+constexpr size_t kMaxFeedBodySize = 20 * 1024 * 1024;
+constexpr size_t kMaxPublishersBodySize = 4 * 1024 * 1024;
+constexpr size_t kMaxImageBodySize = 8 * 1024 * 1024;
+
 net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag();
+api_request_helper::APIRequestOptions GetRequestOptions(size_t max_body_size);
 
 }  // namespace brave_news
 
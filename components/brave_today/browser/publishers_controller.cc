@@ -8,23 +8,40 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "base/bind.h"
 #include "base/callback_forward.h"
 #include "base/one_shot_event.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_private_cdn/headers.h"
+#include "brave/components/brave_today/browser/network.h"
 #include "brave/components/brave_today/browser/publishers_parsing.h"
 #include "brave/components/brave_today/browser/urls.h"
 #include "brave/components/brave_today/common/pref_names.h"
+#include "net/http/http_status_code.h"
 
 namespace brave_news {
 
+namespace {
+
+// Must be incremented whenever mojom::PublishersCacheRecord, or any struct it
+// holds, changes.
+constexpr uint32_t kPublishersCacheFormatVersion = 1;
+
+}  // namespace
+
 PublishersController::PublishersController(
     PrefService* prefs,
-    api_request_helper::APIRequestHelper* api_request_helper)
+    api_request_helper::APIRequestHelper* api_request_helper,
+    const base::FilePath& cache_path)
     : prefs_(prefs),
       api_request_helper_(api_request_helper),
-      on_current_update_complete_(new base::OneShotEvent()) {}
+      cache_file_(cache_path, kPublishersCacheFormatVersion),
+      on_current_update_complete_(new base::OneShotEvent()) {
+  cache_file_.Read(base::BindOnce(&PublishersController::OnCacheRead,
+                                  weak_ptr_factory_.GetWeakPtr()));
+}
 
 PublishersController::~PublishersController() = default;
 
@@ -57,6 +74,19 @@ void PublishersController::GetOrFetchPublishers(
 // To be consumed internally - provides no data so that we don't need to clone,
 // as data can be accessed via class property
 void PublishersController::GetOrFetchPublishers(base::OnceClosure callback) {
+  // Wait for the data from the previous session first.
+  if (!on_cache_read_.is_signaled()) {
+    on_cache_read_.Post(
+        FROM_HERE,
+        base::BindOnce(
+            [](base::WeakPtr<PublishersController> controller,
+               base::OnceClosure callback) {
+              if (controller)
+                controller->GetOrFetchPublishers(std::move(callback));
+            },
+            weak_ptr_factory_.GetWeakPtr(), std::move(callback)));
+    return;
+  }
   // If in-memory data is already present, no need to wait,
   // otherwise wait for fetch to be complete.
   if (!publishers_.empty()) {
@@ -70,61 +100,135 @@ void PublishersController::GetOrFetchPublishers(base::OnceClosure callback) {
 }
 
 void PublishersController::EnsurePublishersIsUpdating() {
+  FetchPublishers(false);
+}
+
+void PublishersController::UpdateIfRemoteChanged() {
+  FetchPublishers(true);
+}
+
+void PublishersController::FetchPublishers(bool if_changed) {
   // Only 1 update at a time, other calls for data will wait for
   // the current operation via the `on_current_update_complete_` OneShotEvent.
   if (is_update_in_progress_) {
     return;
   }
+  is_update_in_progress_ = true;
   GURL sources_url("https://" + brave_today::GetHostname() + "/sources." +
                    brave_today::GetRegionUrlPart() + "json");
-  auto onRequest = base::BindOnce(
-      [](PublishersController* controller, const int status,
-         const std::string& body,
-         const base::flat_map<std::string, std::string>& headers) {
-        VLOG(1) << "Downloaded sources, status: " << status;
-        // TODO(petemill): handle bad status or response
-        Publishers publisher_list;
-        ParsePublisherList(body, &publisher_list);
-        // Add user enabled statuses
-        const base::DictionaryValue* publisher_prefs =
-            controller->prefs_->GetDictionary(prefs::kBraveTodaySources);
-        for (auto kv : publisher_prefs->DictItems()) {
-          auto publisher_id = kv.first;
-          auto is_user_enabled = kv.second.GetIfBool();
-          if (publisher_list.contains(publisher_id) &&
-              is_user_enabled.has_value()) {
-            publisher_list[publisher_id]->user_enabled_status =
-                (is_user_enabled.value()
-                     ? brave_news::mojom::UserEnabled::ENABLED
-                     : brave_news::mojom::UserEnabled::DISABLED);
-          } else {
-            VLOG(1) << "Publisher list did not contain publisher found in"
-                       "user prefs: "
-                    << publisher_id;
-          }
-        }
-        // Set memory cache
-        controller->publishers_ = std::move(publisher_list);
-        // Let any callback know that the data is ready.
-        VLOG(1) << "Notify subscribers to publishers data";
-        // One-shot subscribers
-        controller->on_current_update_complete_->Signal();
-        controller->is_update_in_progress_ = false;
-        controller->on_current_update_complete_ =
-            std::make_unique<base::OneShotEvent>();
-        // Observers
-        for (auto& observer : controller->observers_) {
-          observer.OnPublishersUpdated(controller);
-        }
-      },
-      base::Unretained(this));
-  api_request_helper_->Request("GET", sources_url, "", "", true,
-                               std::move(onRequest),
-                               brave::private_cdn_headers);
+  auto headers = brave::private_cdn_headers;
+  if (if_changed && !publishers_.empty() && !publishers_etag_.empty())
+    headers[kIfNoneMatchHeaderKey] = publishers_etag_;
+  api_request_helper_->Request(
+      "GET", sources_url, "", "", GetRequestOptions(kMaxPublishersBodySize),
+      base::BindOnce(&PublishersController::OnPublishersResponse,
+                     weak_ptr_factory_.GetWeakPtr()),
+      headers);
+}
+
+void PublishersController::OnPublishersResponse(
+    const int status,
+    const std::string& body,
+    const base::flat_map<std::string, std::string>& headers) {
+  VLOG(1) << "Downloaded sources, status: " << status;
+  if (status == net::HTTP_NOT_MODIFIED) {
+    // What we have is current, so there is nothing for observers to do.
+    NotifyUpdateDone();
+    return;
+  }
+  // Keep what we have, if anything, when the list can't be fetched.
+  if (status < 200 || status >= 300) {
+    LOG(ERROR) << "Bad response from brave news sources.json. Status: "
+               << status;
+    NotifyUpdateDone();
+    return;
+  }
+  Publishers publisher_list;
+  if (!ParsePublisherList(body, &publisher_list) || publisher_list.empty()) {
+    LOG(ERROR) << "Brave News Publisher list could not be parsed";
+    NotifyUpdateDone();
+    return;
+  }
+  ApplyUserPrefs(&publisher_list);
+  // Set memory cache
+  publishers_ = std::move(publisher_list);
+  auto etag = headers.find(kEtagHeaderKey);
+  publishers_etag_ = etag != headers.end() ? etag->second : "";
+  // Save for the next session
+  if (!publishers_.empty()) {
+    mojom::PublishersCacheRecord record;
+    record.etag = publishers_etag_;
+    for (const auto& kv : publishers_) {
+      record.publishers.insert_or_assign(kv.first, kv.second->Clone());
+    }
+    const std::vector<uint8_t> data =
+        mojom::PublishersCacheRecord::Serialize(&record);
+    cache_file_.Write(std::string(data.begin(), data.end()));
+  }
+  NotifyUpdateDone();
+  // Observers
+  for (auto& observer : observers_) {
+    observer.OnPublishersUpdated(this);
+  }
+}
+
+void PublishersController::OnCacheRead(absl::optional<std::string> data) {
+  mojom::PublishersCacheRecord record;
+  const bool has_cache =
+      data && publishers_.empty() &&
+      mojom::PublishersCacheRecord::Deserialize(data->data(), data->size(),
+                                                &record);
+  if (has_cache) {
+    VLOG(1) << "Read " << record.publishers.size()
+            << " publishers from cache";
+    publishers_ = std::move(record.publishers);
+    publishers_etag_ = std::move(record.etag);
+    // The user may have changed a source since the cache was written.
+    ApplyUserPrefs(&publishers_);
+  }
+  on_cache_read_.Signal();
+  if (has_cache) {
+    UpdateIfRemoteChanged();
+  }
+}
+
+void PublishersController::ApplyUserPrefs(Publishers* publishers) {
+  // Start from the remote defaults, so that a source the user has since
+  // reset doesn't keep the status it was cached with.
+  for (auto& kv : *publishers) {
+    kv.second->user_enabled_status = mojom::UserEnabled::NOT_MODIFIED;
+  }
+  // Add user enabled statuses
+  const base::DictionaryValue* publisher_prefs =
+      prefs_->GetDictionary(prefs::kBraveTodaySources);
+  for (auto kv : publisher_prefs->DictItems()) {
+    auto publisher_id = kv.first;
+    auto is_user_enabled = kv.second.GetIfBool();
+    if (publishers->contains(publisher_id) && is_user_enabled.has_value()) {
+      (*publishers)[publisher_id]->user_enabled_status =
+          (is_user_enabled.value() ? brave_news::mojom::UserEnabled::ENABLED
+                                   : brave_news::mojom::UserEnabled::DISABLED);
+    } else {
+      VLOG(1) << "Publisher list did not contain publisher found in"
+                 "user prefs: "
+              << publisher_id;
+    }
+  }
+}
+
+void PublishersController::NotifyUpdateDone() {
+  // Let any callback know that the data is ready.
+  VLOG(1) << "Notify subscribers to publishers data";
+  // One-shot subscribers
+  on_current_update_complete_->Signal();
+  is_update_in_progress_ = false;
+  on_current_update_complete_ = std::make_unique<base::OneShotEvent>();
 }
 
 void PublishersController::ClearCache() {
   publishers_.clear();
+  publishers_etag_.clear();
+  cache_file_.Delete();
 }
 
 }  // namespace brave_news
@@ -9,10 +9,13 @@
 #include <memory>
 #include <string>
 
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
 #include "base/one_shot_event.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
+#include "brave/components/brave_today/browser/cache_file.h"
 #include "brave/components/brave_today/common/brave_news.mojom.h"
 #include "components/prefs/pref_service.h"
 
@@ -23,9 +26,12 @@ using Publishers = base::flat_map<std::string, mojom::PublisherPtr>;
 
 class PublishersController {
  public:
+  // The publishers are saved to |cache_path| and shown from there in the
+  // next session while they are revalidated.
   PublishersController(
       PrefService* prefs,
-      api_request_helper::APIRequestHelper* api_request_helper);
+      api_request_helper::APIRequestHelper* api_request_helper,
+      const base::FilePath& cache_path);
   ~PublishersController();
   PublishersController(const PublishersController&) = delete;
   PublishersController& operator=(const PublishersController&) = delete;
@@ -39,18 +45,35 @@ class PublishersController {
   void RemoveObserver(Observer* observer);
   void GetOrFetchPublishers(GetPublishersCallback callback);
   void EnsurePublishersIsUpdating();
+  // Fetches the publishers unless the remote list still matches the ETag of
+  // the one we have, in which case observers aren't notified.
+  void UpdateIfRemoteChanged();
   void ClearCache();
 
  private:
   void GetOrFetchPublishers(base::OnceClosure callback);
+  void FetchPublishers(bool if_changed);
+  void OnPublishersResponse(
+      const int status,
+      const std::string& body,
+      const base::flat_map<std::string, std::string>& headers);
+  void OnCacheRead(absl::optional<std::string> data);
+  void ApplyUserPrefs(Publishers* publishers);
+  void NotifyUpdateDone();
 
   PrefService* prefs_;
   api_request_helper::APIRequestHelper* api_request_helper_;
 
+  CacheFile cache_file_;
+  // Signaled once the cache from the previous session has been read, which
+  // data requests wait for.
+  base::OneShotEvent on_cache_read_;
   std::unique_ptr<base::OneShotEvent> on_current_update_complete_;
   base::ObserverList<Observer> observers_;
   Publishers publishers_;
+  std::string publishers_etag_;
   bool is_update_in_progress_ = false;
+  base::WeakPtrFactory<PublishersController> weak_ptr_factory_{this};
 };
 
 }  // namespace brave_news
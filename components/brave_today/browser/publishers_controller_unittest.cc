@@ -0,0 +1,219 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/publishers_controller.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "brave/components/brave_today/browser/urls.h"
+#include "brave/components/brave_today/common/pref_names.h"
+#include "components/prefs/scoped_user_pref_update.h"
+#include "components/prefs/testing_pref_service.h"
+#include "net/http/http_status_code.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "services/network/test/test_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_news {
+
+namespace {
+
+constexpr char kPublishersJson[] = R"([
+    {
+      "publisher_id": "111",
+      "publisher_name": "Test Publisher 1",
+      "category": "Tech",
+      "enabled": true
+    }
+  ])";
+
+GURL GetSourcesUrl() {
+  return GURL("https://" + brave_today::GetHostname() + "/sources." +
+              brave_today::GetRegionUrlPart() + "json");
+}
+
+class TestObserver : public PublishersController::Observer {
+ public:
+  void OnPublishersUpdated(PublishersController* controller) override {
+    update_count_++;
+  }
+
+  int update_count_ = 0;
+};
+
+}  // namespace
+
+class BraveNewsPublishersControllerTest : public testing::Test {
+ public:
+  BraveNewsPublishersControllerTest()
+      : api_request_helper_(
+            TRAFFIC_ANNOTATION_FOR_TESTS,
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)) {
+    prefs_.registry()->RegisterDictionaryPref(prefs::kBraveTodaySources);
+  }
+
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+ protected:
+  // Starts a session reading the cache left by the previous one.
+  void StartSession() {
+    controller_.reset();
+    url_loader_factory_.ClearResponses();
+    controller_ = std::make_unique<PublishersController>(
+        &prefs_, &api_request_helper_, GetCachePath());
+    controller_->AddObserver(&observer_);
+  }
+
+  Publishers GetPublishers() {
+    Publishers result;
+    controller_->GetOrFetchPublishers(
+        base::BindLambdaForTesting([&result](Publishers publishers) {
+          result = std::move(publishers);
+        }));
+    task_environment_.RunUntilIdle();
+    return result;
+  }
+
+  void RespondWithPublishers(const std::string& etag) {
+    auto head = network::CreateURLResponseHead(net::HTTP_OK);
+    head->headers->AddHeader("ETag", etag);
+    url_loader_factory_.AddResponse(GetSourcesUrl(), std::move(head),
+                                    kPublishersJson,
+                                    network::URLLoaderCompletionStatus());
+    task_environment_.RunUntilIdle();
+  }
+
+  void RespondWithError(net::Error error) {
+    url_loader_factory_.AddResponse(
+        GetSourcesUrl(), network::mojom::URLResponseHead::New(), "",
+        network::URLLoaderCompletionStatus(error));
+    task_environment_.RunUntilIdle();
+  }
+
+  // Returns the If-None-Match header of the pending sources request.
+  std::string GetPendingIfNoneMatch() {
+    std::string if_none_match;
+    for (const auto& pending : *url_loader_factory_.pending_requests()) {
+      if (pending.request.url == GetSourcesUrl()) {
+        pending.request.headers.GetHeader("If-None-Match", &if_none_match);
+      }
+    }
+    return if_none_match;
+  }
+
+  // Fetches the publishers in a first session so that the next one starts
+  // from the cache.
+  void FillCache() {
+    StartSession();
+    RespondWithPublishers("\"v1\"");
+    ASSERT_EQ(1u, GetPublishers().size());
+    StartSession();
+  }
+
+  base::FilePath GetCachePath() const {
+    return temp_dir_.GetPath().AppendASCII("publishers");
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  TestingPrefServiceSimple prefs_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  api_request_helper::APIRequestHelper api_request_helper_;
+  TestObserver observer_;
+  std::unique_ptr<PublishersController> controller_;
+};
+
+TEST_F(BraveNewsPublishersControllerTest, ColdStartReadsCache) {
+  FillCache();
+
+  Publishers publishers = GetPublishers();
+  ASSERT_EQ(1u, publishers.size());
+  EXPECT_EQ("Test Publisher 1", publishers["111"]->publisher_name);
+  // The cached list is revalidated in the background.
+  EXPECT_EQ("\"v1\"", GetPendingIfNoneMatch());
+}
+
+TEST_F(BraveNewsPublishersControllerTest, NotModifiedKeepsPublishers) {
+  FillCache();
+  GetPublishers();
+  observer_.update_count_ = 0;
+
+  url_loader_factory_.AddResponse(GetSourcesUrl().spec(), "",
+                                  net::HTTP_NOT_MODIFIED);
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(1u, GetPublishers().size());
+  EXPECT_EQ(0, observer_.update_count_);
+}
+
+TEST_F(BraveNewsPublishersControllerTest, FailedRevalidationKeepsPublishers) {
+  FillCache();
+  GetPublishers();
+  observer_.update_count_ = 0;
+
+  RespondWithError(net::ERR_INTERNET_DISCONNECTED);
+
+  EXPECT_EQ(1u, GetPublishers().size());
+  EXPECT_EQ(0, observer_.update_count_);
+}
+
+TEST_F(BraveNewsPublishersControllerTest, ServerErrorKeepsPublishers) {
+  FillCache();
+  GetPublishers();
+  observer_.update_count_ = 0;
+
+  url_loader_factory_.AddResponse(GetSourcesUrl().spec(), "",
+                                  net::HTTP_INTERNAL_SERVER_ERROR);
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(1u, GetPublishers().size());
+  EXPECT_EQ(0, observer_.update_count_);
+}
+
+TEST_F(BraveNewsPublishersControllerTest, CachedStatusFollowsUserPrefs) {
+  {
+    DictionaryPrefUpdate update(&prefs_, prefs::kBraveTodaySources);
+    update->SetBoolean("111", false);
+  }
+  StartSession();
+  RespondWithPublishers("\"v1\"");
+  Publishers publishers = GetPublishers();
+  ASSERT_EQ(1u, publishers.size());
+  EXPECT_EQ(mojom::UserEnabled::DISABLED,
+            publishers["111"]->user_enabled_status);
+
+  // The user resets the source before the next session.
+  {
+    DictionaryPrefUpdate update(&prefs_, prefs::kBraveTodaySources);
+    update->RemoveKey("111");
+  }
+  StartSession();
+  publishers = GetPublishers();
+  ASSERT_EQ(1u, publishers.size());
+  EXPECT_EQ(mojom::UserEnabled::NOT_MODIFIED,
+            publishers["111"]->user_enabled_status);
+}
+
+TEST_F(BraveNewsPublishersControllerTest, ClearCacheDeletesFile) {
+  FillCache();
+  ASSERT_TRUE(base::PathExists(GetCachePath()));
+
+  controller_->ClearCache();
+  task_environment_.RunUntilIdle();
+
+  EXPECT_FALSE(base::PathExists(GetCachePath()));
+}
+
+}  // namespace brave_news
@@ -0,0 +1,84 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_VPN_BRAVE_VPN_HOSTNAME_PROBER_H_
+#define BRAVE_COMPONENTS_BRAVE_VPN_BRAVE_VPN_HOSTNAME_PROBER_H_
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/circular_deque.h"
+#include "base/containers/flat_map.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/time/default_tick_clock.h"
+#include "base/time/time.h"
+
+namespace base {
+class TickClock;
+}  // namespace base
+
+namespace net {
+class HttpResponseHeaders;
+}  // namespace net
+
+namespace network {
+class SharedURLLoaderFactory;
+class SimpleURLLoader;
+}  // namespace network
+
+namespace brave_vpn {
+
+// Measures how long it takes to reach each of a set of VPN hostnames so that
+// a nearby, responsive host can be preferred. Each probe is a HEAD request to
+// the host over https. Any response, including a refused connection or a
+// certificate error, means that the host answered; only timeouts and
+// resolution or routing failures count as unreachable.
+class HostnameProber {
+ public:
+  // Probe times of the hostnames that answered.
+  using Results = base::flat_map<std::string, base::TimeDelta>;
+  using ProbeCallback = base::OnceCallback<void(Results)>;
+
+  static constexpr size_t kMaxConcurrentProbes = 3;
+  static constexpr base::TimeDelta kProbeTimeout =
+      base::TimeDelta::FromSeconds(3);
+
+  HostnameProber(
+      scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
+      const base::TickClock* clock = base::DefaultTickClock::GetInstance());
+  ~HostnameProber();
+
+  HostnameProber(const HostnameProber&) = delete;
+  HostnameProber& operator=(const HostnameProber&) = delete;
+
+  // Probes |hostnames|, running |callback| once every probe has finished.
+  // Replaces any probe in progress without running its callback.
+  void Probe(const std::vector<std::string>& hostnames,
+             ProbeCallback callback);
+  void Cancel();
+
+ private:
+  using LoaderList = std::list<std::unique_ptr<network::SimpleURLLoader>>;
+
+  void StartProbes();
+  void OnProbeComplete(LoaderList::iterator loader_it,
+                       const std::string& hostname,
+                       base::TimeTicks start_time,
+                       scoped_refptr<net::HttpResponseHeaders> headers);
+
+  scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
+  const base::TickClock* clock_;
+  base::circular_deque<std::string> pending_hostnames_;
+  LoaderList loaders_;
+  Results results_;
+  ProbeCallback callback_;
+};
+
+}  // namespace brave_vpn
+
+#endif  // BRAVE_COMPONENTS_BRAVE_VPN_BRAVE_VPN_HOSTNAME_PROBER_H_
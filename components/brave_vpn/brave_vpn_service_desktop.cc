@@ -6,17 +6,21 @@
 #include "brave/components/brave_vpn/brave_vpn_service_desktop.h"
 
 #include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include "base/bind.h"
 #include "base/command_line.h"
+#include "base/feature_list.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/notreached.h"
 #include "base/strings/string_split.h"
 #include "base/values.h"
 #include "brave/components/brave_vpn/brave_vpn_constants.h"
 #include "brave/components/brave_vpn/brave_vpn_utils.h"
+#include "brave/components/brave_vpn/features.h"
 #include "brave/components/brave_vpn/pref_names.h"
 #include "brave/components/brave_vpn/switches.h"
 #include "brave/components/skus/browser/pref_names.h"
@@ -33,6 +37,11 @@ constexpr char kRegionContinentKey[] = "continent";
 constexpr char kRegionNameKey[] = "name";
 constexpr char kRegionNamePrettyKey[] = "name-pretty";
 
+// Only the hostnames with the best capacity scores are probed.
+constexpr size_t kMaxProbedHostnames = 4;
+constexpr base::TimeDelta kProbeResultsLifetime =
+    base::TimeDelta::FromMinutes(10);
+
 std::string GetStringFor(ConnectionState state) {
   switch (state) {
     case ConnectionState::CONNECTED:
@@ -83,7 +92,9 @@ std::string GetBraveVPNPaymentsEnv() {
 BraveVpnServiceDesktop::BraveVpnServiceDesktop(
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
     PrefService* prefs)
-    : BraveVpnService(url_loader_factory), prefs_(prefs) {
+    : BraveVpnService(url_loader_factory),
+      prefs_(prefs),
+      hostname_prober_(url_loader_factory) {
   DCHECK(brave_vpn::IsBraveVPNEnabled());
   DETACH_FROM_SEQUENCE(sequence_checker_);
 
@@ -137,6 +148,7 @@ void BraveVpnServiceDesktop::Shutdown() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   observed_.Reset();
+  hostname_prober_.Cancel();
   receivers_.Clear();
   observers_.Clear();
   pref_change_registrar_.RemoveAll();
@@ -161,6 +173,7 @@ void BraveVpnServiceDesktop::OnCreated() {
 void BraveVpnServiceDesktop::OnCreateFailed() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   VLOG(2) << __func__;
+  probe_results_cache_.clear();
   UpdateAndNotifyConnectionStateChange(ConnectionState::CONNECT_FAILED);
 }
 
@@ -234,6 +247,8 @@ void BraveVpnServiceDesktop::OnIsConnecting() {
 void BraveVpnServiceDesktop::OnConnectFailed() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   VLOG(2) << __func__;
+  // The picked host may no longer be the best one, so probe again next time.
+  probe_results_cache_.clear();
 
   cancel_connecting_ = false;
   UpdateAndNotifyConnectionStateChange(ConnectionState::CONNECT_FAILED);
@@ -702,6 +717,7 @@ void BraveVpnServiceDesktop::FetchHostnamesForRegion(const std::string& name) {
   VLOG(2) << __func__;
   // Hostname will be replaced with latest one.
   hostname_.reset();
+  hostname_prober_.Cancel();
 
   // Unretained is safe here becasue this class owns request helper.
   GetHostnamesForRegion(
@@ -779,7 +795,78 @@ void BraveVpnServiceDesktop::ParseAndCacheHostnames(
     return;
   }
 
-  hostname_ = PickBestHostname(hostnames);
+  if (!base::FeatureList::IsEnabled(
+          brave_vpn::features::kBraveVPNHostnameProbing)) {
+    hostname_ = PickBestHostname(hostnames, {});
+    OnPickHostname(region);
+    return;
+  }
+
+  const auto cached_results = probe_results_cache_.find(region);
+  if (cached_results != probe_results_cache_.end() &&
+      cached_results->second.expiry > base::Time::Now()) {
+    hostname_ = PickBestHostname(hostnames, cached_results->second.results);
+    OnPickHostname(region);
+    return;
+  }
+
+  // Probe the online hostnames with the best capacity scores.
+  std::vector<brave_vpn::Hostname> candidates;
+  std::copy_if(
+      hostnames.begin(), hostnames.end(), std::back_inserter(candidates),
+      [](const brave_vpn::Hostname& hostname) { return !hostname.is_offline; });
+  std::stable_sort(
+      candidates.begin(), candidates.end(),
+      [](const brave_vpn::Hostname& a, const brave_vpn::Hostname& b) {
+        return a.capacity_score > b.capacity_score;
+      });
+  if (candidates.size() > kMaxProbedHostnames)
+    candidates.resize(kMaxProbedHostnames);
+
+  std::vector<std::string> candidate_names;
+  for (const auto& candidate : candidates)
+    candidate_names.push_back(candidate.hostname);
+
+  // Unretained is safe here because this class owns the prober.
+  hostname_prober_.Probe(
+      candidate_names,
+      base::BindOnce(&BraveVpnServiceDesktop::OnProbeHostnames,
+                     base::Unretained(this), region, hostnames));
+}
+
+void BraveVpnServiceDesktop::OnProbeHostnames(
+    const std::string& region,
+    const std::vector<brave_vpn::Hostname>& hostnames,
+    brave_vpn::HostnameProber::Results probe_results) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (cancel_connecting_) {
+    UpdateAndNotifyConnectionStateChange(ConnectionState::DISCONNECTED);
+    cancel_connecting_ = false;
+    return;
+  }
+
+  UMA_HISTOGRAM_EXACT_LINEAR("Brave.VPN.ReachableHostnameCount",
+                             probe_results.size(), kMaxProbedHostnames + 1);
+
+  // Don't cache a probe that reached nothing; it's likely a network blip.
+  if (!probe_results.empty()) {
+    probe_results_cache_[region] = {
+        probe_results, base::Time::Now() + kProbeResultsLifetime};
+  }
+
+  hostname_ = PickBestHostname(hostnames, probe_results);
+  const auto picked_result = probe_results.find(hostname_->hostname);
+  if (picked_result != probe_results.end()) {
+    UMA_HISTOGRAM_TIMES("Brave.VPN.PickedHostnameProbeTime",
+                        picked_result->second);
+  }
+
+  OnPickHostname(region);
+}
+
+void BraveVpnServiceDesktop::OnPickHostname(const std::string& region) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(hostname_);
   if (hostname_->hostname.empty()) {
     VLOG(2) << __func__ << " : got empty hostnames list for " << region;
     UpdateAndNotifyConnectionStateChange(ConnectionState::CONNECT_FAILED);
@@ -890,7 +977,8 @@ void BraveVpnServiceDesktop::OnGetProfileCredentials(
 }
 
 std::unique_ptr<brave_vpn::Hostname> BraveVpnServiceDesktop::PickBestHostname(
-    const std::vector<brave_vpn::Hostname>& hostnames) {
+    const std::vector<brave_vpn::Hostname>& hostnames,
+    const brave_vpn::HostnameProber::Results& probe_results) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   std::vector<brave_vpn::Hostname> filtered_hostnames;
   std::copy_if(
@@ -906,6 +994,39 @@ std::unique_ptr<brave_vpn::Hostname> BraveVpnServiceDesktop::PickBestHostname(
   if (filtered_hostnames.empty())
     return std::make_unique<brave_vpn::Hostname>();
 
+  // Hosts that answered nearly as fast as the fastest one are treated as
+  // equally close, so capacity decides between them.
+  base::TimeDelta fastest_probe_time = base::TimeDelta::Max();
+  for (const auto& hostname : filtered_hostnames) {
+    const auto result = probe_results.find(hostname.hostname);
+    if (result != probe_results.end())
+      fastest_probe_time = std::min(fastest_probe_time, result->second);
+  }
+
+  if (!fastest_probe_time.is_max()) {
+    const base::TimeDelta max_probe_time =
+        fastest_probe_time * 3 / 2 + base::TimeDelta::FromMilliseconds(20);
+    const brave_vpn::Hostname* best = nullptr;
+    base::TimeDelta best_probe_time;
+    for (const auto& hostname : filtered_hostnames) {
+      const auto result = probe_results.find(hostname.hostname);
+      if (result == probe_results.end() || result->second > max_probe_time)
+        continue;
+
+      // |filtered_hostnames| is sorted by capacity score.
+      if (!best || (hostname.capacity_score == best->capacity_score &&
+                    result->second < best_probe_time)) {
+        best = &hostname;
+        best_probe_time = result->second;
+      }
+    }
+
+    DCHECK(best);
+    UMA_HISTOGRAM_BOOLEAN("Brave.VPN.PickedHostnameByProbe",
+                          best->hostname != filtered_hostnames[0].hostname);
+    return std::make_unique<brave_vpn::Hostname>(*best);
+  }
+
   // Pick highest capacity score.
   return std::make_unique<brave_vpn::Hostname>(filtered_hostnames[0]);
 }
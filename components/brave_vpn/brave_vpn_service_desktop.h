@@ -10,12 +10,14 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/scoped_observation.h"
 #include "base/sequence_checker.h"
 #include "base/timer/timer.h"
 #include "brave/components/brave_vpn/brave_vpn.mojom.h"
 #include "brave/components/brave_vpn/brave_vpn_connection_info.h"
 #include "brave/components/brave_vpn/brave_vpn_data_types.h"
+#include "brave/components/brave_vpn/brave_vpn_hostname_prober.h"
 #include "brave/components/brave_vpn/brave_vpn_os_connection_api.h"
 #include "brave/components/brave_vpn/brave_vpn_service.h"
 #include "components/prefs/pref_change_registrar.h"
@@ -78,6 +80,8 @@ class BraveVpnServiceDesktop
   friend class BraveBrowserCommandControllerTest;
   FRIEND_TEST_ALL_PREFIXES(BraveVPNServiceTest, RegionDataTest);
   FRIEND_TEST_ALL_PREFIXES(BraveVPNServiceTest, HostnamesTest);
+  FRIEND_TEST_ALL_PREFIXES(BraveVPNServiceTest, ProbedHostnamesTest);
+  FRIEND_TEST_ALL_PREFIXES(BraveVPNServiceTest, PickBestHostnameTest);
   FRIEND_TEST_ALL_PREFIXES(BraveVPNServiceTest, CancelConnectingTest);
   FRIEND_TEST_ALL_PREFIXES(BraveVPNServiceTest, ConnectionInfoTest);
   FRIEND_TEST_ALL_PREFIXES(BraveVPNServiceTest, LoadPurchasedStateTest);
@@ -114,6 +118,10 @@ class BraveVpnServiceDesktop
                         bool success);
   void ParseAndCacheHostnames(const std::string& region,
                               base::Value hostnames_value);
+  void OnProbeHostnames(const std::string& region,
+                        const std::vector<brave_vpn::Hostname>& hostnames,
+                        brave_vpn::HostnameProber::Results probe_results);
+  void OnPickHostname(const std::string& region);
   void SetDeviceRegion(const std::string& name);
   void SetFallbackDeviceRegion();
   void SetDeviceRegion(const brave_vpn::mojom::Region& region);
@@ -121,8 +129,11 @@ class BraveVpnServiceDesktop
   std::string GetCurrentTimeZone();
   void SetPurchasedState(PurchasedState state);
   void ScheduleFetchRegionDataIfNeeded();
+  // Picks among the hostnames that answered a probe, if any, falling back to
+  // the highest capacity score.
   std::unique_ptr<brave_vpn::Hostname> PickBestHostname(
-      const std::vector<brave_vpn::Hostname>& hostnames);
+      const std::vector<brave_vpn::Hostname>& hostnames,
+      const brave_vpn::HostnameProber::Results& probe_results);
 
   void OnSkusVPNCredentialUpdated();
   void OnGetSubscriberCredential(const std::string& subscriber_credential,
@@ -154,6 +165,15 @@ class BraveVpnServiceDesktop
   mojo::ReceiverSet<brave_vpn::mojom::ServiceHandler> receivers_;
   mojo::RemoteSet<brave_vpn::mojom::ServiceObserver> observers_;
   base::RepeatingTimer region_data_update_timer_;
+  brave_vpn::HostnameProber hostname_prober_;
+
+  // Probe results are reused for a while per region, as server latency
+  // changes far less often than users reconnect.
+  struct CachedProbeResults {
+    brave_vpn::HostnameProber::Results results;
+    base::Time expiry;
+  };
+  base::flat_map<std::string, CachedProbeResults> probe_results_cache_;
 
   // Only for testing.
   std::string test_timezone_;
@@ -18,20 +18,29 @@
 #include "components/prefs/testing_pref_service.h"
 #include "components/sync_preferences/testing_pref_service_syncable.h"
 #include "content/public/test/browser_task_environment.h"
-#include "services/network/test/test_shared_url_loader_factory.h"
+#include "net/base/net_errors.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "services/network/test/test_url_loader_factory.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 class BraveVPNServiceTest : public testing::Test {
  public:
   BraveVPNServiceTest() {
-    scoped_feature_list_.InitAndEnableFeature(brave_vpn::features::kBraveVPN);
+    // Probing is covered by ProbedHostnamesTest. Other tests expect the
+    // hostname to be picked as soon as the list is fetched.
+    scoped_feature_list_.InitWithFeatures(
+        {brave_vpn::features::kBraveVPN},
+        {brave_vpn::features::kBraveVPNHostnameProbing});
   }
 
   void SetUp() override {
     brave_rewards::SkusSdkImpl::RegisterProfilePrefs(pref_service_.registry());
     brave_vpn::prefs::RegisterProfilePrefs(pref_service_.registry());
     service_ = std::make_unique<BraveVpnServiceDesktop>(
-        base::MakeRefCounted<network::TestSharedURLLoaderFactory>(),
+        base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+            &url_loader_factory_),
         &pref_service_);
   }
 
@@ -194,6 +203,7 @@ class BraveVPNServiceTest : public testing::Test {
 
   base::test::ScopedFeatureList scoped_feature_list_;
   content::BrowserTaskEnvironment task_environment_;
+  network::TestURLLoaderFactory url_loader_factory_;
   sync_preferences::TestingPrefServiceSyncable pref_service_;
   std::unique_ptr<BraveVpnServiceDesktop> service_;
 };
@@ -243,6 +253,86 @@ TEST_F(BraveVPNServiceTest, HostnamesTest) {
   EXPECT_FALSE(service_->hostname_);
 }
 
+TEST_F(BraveVPNServiceTest, ProbedHostnamesTest) {
+  base::test::ScopedFeatureList probing_feature_list;
+  probing_feature_list.InitAndEnableFeature(
+      brave_vpn::features::kBraveVPNHostnameProbing);
+
+  // host-2 has the best capacity score but doesn't answer.
+  url_loader_factory_.AddResponse(
+      GURL("https://host-2.brave.com/"),
+      network::mojom::URLResponseHead::New(), std::string(),
+      network::URLLoaderCompletionStatus(net::ERR_NAME_NOT_RESOLVED));
+  for (const char* url : {"https://host-1.brave.com/",
+                          "https://host-3.brave.com/",
+                          "https://host-5.brave.com/"}) {
+    url_loader_factory_.AddResponse(url, std::string());
+  }
+
+  service_->hostname_.reset();
+  service_->OnFetchHostnames("region-a", GetHostnamesData(), true);
+  // Hostname is picked once probing is done.
+  EXPECT_FALSE(service_->hostname_);
+  task_environment_.RunUntilIdle();
+  ASSERT_TRUE(service_->hostname_);
+  EXPECT_EQ("host-5.brave.com", service_->hostname_->hostname);
+
+  // Host-4 isn't probed as only the best four hostnames are.
+  const auto& cached_results = service_->probe_results_cache_["region-a"];
+  EXPECT_EQ(3u, cached_results.results.size());
+  EXPECT_FALSE(cached_results.results.contains("host-2.brave.com"));
+  EXPECT_FALSE(cached_results.results.contains("host-4.brave.com"));
+
+  // Cached probe results are used without probing again.
+  url_loader_factory_.ClearResponses();
+  service_->hostname_.reset();
+  service_->OnFetchHostnames("region-a", GetHostnamesData(), true);
+  ASSERT_TRUE(service_->hostname_);
+  EXPECT_EQ("host-5.brave.com", service_->hostname_->hostname);
+  EXPECT_EQ(0, url_loader_factory_.NumPending());
+
+  // Connection failure drops cached probe results.
+  service_->OnConnectFailed();
+  EXPECT_TRUE(service_->probe_results_cache_.empty());
+}
+
+TEST_F(BraveVPNServiceTest, PickBestHostnameTest) {
+  const std::vector<brave_vpn::Hostname> hostnames = {
+      {"host-1.brave.com", "host-1", false, 1},
+      {"host-2.brave.com", "host-2", false, 3},
+      {"host-3.brave.com", "host-3", false, 2},
+      {"host-4.brave.com", "host-4", true, 5},
+  };
+
+  // Highest capacity score is picked without probe results.
+  EXPECT_EQ("host-2.brave.com",
+            service_->PickBestHostname(hostnames, {})->hostname);
+
+  // Much slower host isn't picked even with the best capacity score.
+  brave_vpn::HostnameProber::Results probe_results = {
+      {"host-1.brave.com", base::TimeDelta::FromMilliseconds(40)},
+      {"host-2.brave.com", base::TimeDelta::FromMilliseconds(300)},
+      {"host-3.brave.com", base::TimeDelta::FromMilliseconds(70)},
+  };
+  EXPECT_EQ("host-3.brave.com",
+            service_->PickBestHostname(hostnames, probe_results)->hostname);
+
+  // Capacity score decides between hosts with similar probe times.
+  probe_results["host-2.brave.com"] = base::TimeDelta::FromMilliseconds(75);
+  EXPECT_EQ("host-2.brave.com",
+            service_->PickBestHostname(hostnames, probe_results)->hostname);
+
+  // Offline host isn't picked even if it answered the fastest.
+  probe_results["host-4.brave.com"] = base::TimeDelta::FromMilliseconds(10);
+  EXPECT_EQ("host-2.brave.com",
+            service_->PickBestHostname(hostnames, probe_results)->hostname);
+
+  // Unreachable hosts aren't picked.
+  probe_results = {{"host-1.brave.com", base::TimeDelta::FromMilliseconds(40)}};
+  EXPECT_EQ("host-1.brave.com",
+            service_->PickBestHostname(hostnames, probe_results)->hostname);
+}
+
 TEST_F(BraveVPNServiceTest, LoadPurchasedStateTest) {
   EXPECT_EQ(PurchasedState::NOT_PURCHASED, service_->purchased_state_);
   pref_service_.SetString(brave_rewards::prefs::kSkusVPNCredential, "abcdefg");
@@ -13,6 +13,10 @@ namespace features {
 
 const base::Feature kBraveVPN{"BraveVPN", base::FEATURE_DISABLED_BY_DEFAULT};
 
+// Probe candidate hostnames before picking one to connect to.
+const base::Feature kBraveVPNHostnameProbing{"BraveVPNHostnameProbing",
+                                             base::FEATURE_ENABLED_BY_DEFAULT};
+
 }  // namespace features
 
 }  // namespace brave_vpn
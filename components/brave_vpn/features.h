@@ -15,6 +15,7 @@ namespace brave_vpn {
 namespace features {
 
 extern const base::Feature kBraveVPN;
+extern const base::Feature kBraveVPNHostnameProbing;
 
 }  // namespace features
 
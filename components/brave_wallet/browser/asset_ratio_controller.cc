@@ -10,6 +10,7 @@
 
 #include "base/strings/stringprintf.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
+#include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "net/base/escape.h"
 #include "net/base/load_flags.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
@@ -156,7 +157,8 @@ void AssetRatioController::GetPrice(
       from_assets_lower, to_assets_lower, std::move(callback));
   api_request_helper_.Request(
       "GET", GetPriceURL(from_assets_lower, to_assets_lower, timeframe), "", "",
-      true, std::move(internal_callback));
+      GetAPIRequestOptions(kMaxAssetRatioResponseBodySize),
+      std::move(internal_callback));
 }
 
 void AssetRatioController::OnGetPrice(
@@ -187,8 +189,10 @@ void AssetRatioController::GetPriceHistory(
   auto internal_callback =
       base::BindOnce(&AssetRatioController::OnGetPriceHistory,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  api_request_helper_.Request("GET", GetPriceHistoryURL(asset_lower, timeframe),
-                              "", "", true, std::move(internal_callback));
+  api_request_helper_.Request(
+      "GET", GetPriceHistoryURL(asset_lower, timeframe), "", "",
+      GetAPIRequestOptions(kMaxAssetRatioResponseBodySize),
+      std::move(internal_callback));
 }
 
 void AssetRatioController::OnGetPriceHistory(
@@ -234,8 +238,10 @@ void AssetRatioController::GetEstimatedTime(const std::string& gas_price,
   auto internal_callback =
       base::BindOnce(&AssetRatioController::OnGetEstimatedTime,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  api_request_helper_.Request("GET", GetEstimatedTimeURL(gas_price), "", "",
-                              true, std::move(internal_callback));
+  api_request_helper_.Request(
+      "GET", GetEstimatedTimeURL(gas_price), "", "",
+      GetAPIRequestOptions(kMaxAssetRatioResponseBodySize),
+      std::move(internal_callback));
 }
 
 void AssetRatioController::OnGetEstimatedTime(
@@ -261,8 +267,10 @@ void AssetRatioController::GetGasOracle(GetGasOracleCallback callback) {
   auto internal_callback =
       base::BindOnce(&AssetRatioController::OnGetGasOracle,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  api_request_helper_.Request("GET", GetGasOracleURL(), "", "", true,
-                              std::move(internal_callback));
+  api_request_helper_.Request(
+      "GET", GetGasOracleURL(), "", "",
+      GetAPIRequestOptions(kMaxAssetRatioResponseBodySize),
+      std::move(internal_callback));
 }
 
 void AssetRatioController::OnGetGasOracle(
@@ -27,6 +27,11 @@ constexpr uint256_t kDefaultERC20ApproveGasLimit = 300000;
 constexpr int32_t kAutoLockMinutesMin = 1;
 constexpr int32_t kAutoLockMinutesMax = 10080;
 
+// Responses bigger than these are dropped rather than held in memory.
+constexpr size_t kMaxJsonRpcResponseBodySize = 10 * 1024 * 1024;
+constexpr size_t kMaxAssetRatioResponseBodySize = 2 * 1024 * 1024;
+constexpr size_t kMaxSwapResponseBodySize = 1024 * 1024;
+
 // List of assets from Wyre, available to buy
 static base::NoDestructor<std::vector<mojom::ERCToken>> kBuyTokens(
     {{"0x0D8775F648430679A709E98d2b0Cb6250d2887EF", "Basic Attention Token",
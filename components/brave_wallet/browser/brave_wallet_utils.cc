@@ -19,6 +19,7 @@
 #include "base/strings/stringprintf.h"
 #include "base/time/time.h"
 #include "base/values.h"
+#include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_wallet/browser/pref_names.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "brave/components/brave_wallet/common/features.h"
@@ -788,4 +789,13 @@ void AddCustomNetwork(PrefService* prefs, mojom::EthereumChainPtr chain) {
   asset_list->Append(std::move(native_asset));
 }
 
+api_request_helper::APIRequestOptions GetAPIRequestOptions(
+    size_t max_body_size) {
+  api_request_helper::APIRequestOptions options;
+  options.auto_retry_on_network_change = true;
+  options.max_body_size = max_body_size;
+  options.timeout = base::TimeDelta::FromMinutes(1);
+  return options;
+}
+
 }  // namespace brave_wallet
@@ -21,6 +21,10 @@ class Value;
 
 class GURL;
 
+namespace api_request_helper {
+struct APIRequestOptions;
+}  // namespace api_request_helper
+
 namespace brave_wallet {
 
 bool IsNativeWalletEnabled();
@@ -113,6 +117,11 @@ void AddCustomNetwork(PrefService* prefs, mojom::EthereumChainPtr chain);
 mojom::EthereumChainPtr GetChain(PrefService* prefs,
                                  const std::string& chain_id);
 
+// Options for requests to wallet backends, which are retried on network
+// changes and time out after a minute.
+api_request_helper::APIRequestOptions GetAPIRequestOptions(
+    size_t max_body_size);
+
 }  // namespace brave_wallet
 
 #endif  // BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_BRAVE_WALLET_UTILS_H_
@@ -11,6 +11,7 @@
 #include "base/environment.h"
 #include "base/no_destructor.h"
 #include "base/strings/utf_string_conversions.h"
+#include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/eth_address.h"
 #include "brave/components/brave_wallet/browser/eth_data_builder.h"
@@ -129,9 +130,12 @@ void EthJsonRpcController::RequestInternal(const std::string& json_payload,
   }
   request_headers["x-brave-key"] = brave_key;
 
+  auto options = GetAPIRequestOptions(kMaxJsonRpcResponseBodySize);
+  options.auto_retry_on_network_change = auto_retry_on_network_change;
+  options.timing_histogram_name = "Brave.Wallet.JsonRpcRequestTime";
   api_request_helper_.Request("POST", network_url, json_payload,
-                              "application/json", auto_retry_on_network_change,
-                              std::move(callback), request_headers);
+                              "application/json", options, std::move(callback),
+                              request_headers);
 }
 
 void EthJsonRpcController::FirePendingRequestCompleted(
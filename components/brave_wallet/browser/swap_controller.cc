@@ -9,6 +9,7 @@
 
 #include "base/strings/stringprintf.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
+#include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/eth_json_rpc_controller.h"
 #include "brave/components/brave_wallet/browser/swap_response_parser.h"
 #include "net/base/escape.h"
@@ -186,7 +187,8 @@ void SwapController::GetPriceQuote(mojom::SwapParamsPtr swap_params,
   api_request_helper_.Request(
       "GET",
       GetPriceQuoteURL(std::move(swap_params), rpc_controller_->GetChainId()),
-      "", "", true, std::move(internal_callback));
+      "", "", GetAPIRequestOptions(kMaxSwapResponseBodySize),
+      std::move(internal_callback));
 }
 
 void SwapController::OnGetPriceQuote(
@@ -222,7 +224,8 @@ void SwapController::GetTransactionPayload(
       "GET",
       GetTransactionPayloadURL(std::move(swap_params),
                                rpc_controller_->GetChainId()),
-      "", "", true, std::move(internal_callback));
+      "", "", GetAPIRequestOptions(kMaxSwapResponseBodySize),
+      std::move(internal_callback));
 }
 
 void SwapController::OnGetTransactionPayload(
@@ -4,6 +4,7 @@
 // you can obtain one at http://mozilla.org/MPL/2.0/.
 
 import * as mojo from 'gen/mojo/public/mojom/base/time.mojom.m.js'
+import { BigBuffer } from 'gen/mojo/public/mojom/base/big_buffer.mojom.m.js'
 
 /**
  * Converts a mojo time to a JS time.
@@ -23,3 +24,20 @@ export function mojoTimeToJSDate (mojoTime: mojo.Time): Date {
 
   return new Date(timeInMs - epochDeltaInMs)
 }
+
+/**
+ * Gets the contents of a mojo BigBuffer. Small buffers carry their bytes
+ * inline, larger ones arrive as a shared memory region which is mapped
+ * rather than copied.
+ */
+export function mojoBigBufferToArrayBuffer (bigBuffer: BigBuffer): ArrayBuffer | undefined {
+  if (bigBuffer.bytes) {
+    return new Uint8Array(bigBuffer.bytes).buffer
+  }
+  if (bigBuffer.sharedMemory) {
+    const { buffer } = bigBuffer.sharedMemory.bufferHandle.mapBuffer(
+      0, bigBuffer.sharedMemory.size)
+    return buffer
+  }
+  return undefined
+}
@@ -32,6 +32,10 @@
 namespace content_settings {
 namespace {
 
+// Bumped on the render thread whenever new content setting rules arrive, so
+// per-document caches derived from the rules can tell they are stale.
+uint64_t g_content_setting_rules_generation = 0;
+
 bool IsFrameWithOpaqueOrigin(blink::WebFrame* frame) {
   // Storage access is keyed off the top origin and the frame's origin.
   // It will be denied any opaque origins so have this method to return early
@@ -86,8 +90,14 @@ BraveContentSettingsAgentImpl::BraveContentSettingsAgentImpl(
 
 BraveContentSettingsAgentImpl::~BraveContentSettingsAgentImpl() {}
 
+// static
+void BraveContentSettingsAgentImpl::OnContentSettingRulesChanged() {
+  ++g_content_setting_rules_generation;
+}
+
 void BraveContentSettingsAgentImpl::DidCommitProvisionalLoad(
     ui::PageTransition transition) {
+  cached_farbling_level_.reset();
   temporarily_allowed_scripts_ =
       std::move(preloaded_temporarily_allowed_scripts_);
   ContentSettingsAgentImpl::DidCommitProvisionalLoad(transition);
@@ -223,12 +233,7 @@ bool BraveContentSettingsAgentImpl::AllowFingerprinting(
     bool enabled_per_settings) {
   if (!enabled_per_settings)
     return false;
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
-  const GURL secondary_url(url::Origin(frame->GetSecurityOrigin()).GetURL());
-  if (IsBraveShieldsDown(frame, secondary_url)) {
-    return true;
-  }
-
+  // Shields down resolves to BraveFarblingLevel::OFF.
   return GetBraveFarblingLevel() != BraveFarblingLevel::MAXIMUM;
 }
 
@@ -276,29 +281,41 @@ bool BraveContentSettingsAgentImpl::IsFirstPartyCosmeticFilteringEnabled(
 }
 
 BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
+  // Farbled APIs ask for the level on every call, so resolve it against the
+  // rules once per committed document and rules update.
+  if (cached_farbling_level_ &&
+      cached_farbling_level_rules_generation_ ==
+          g_content_setting_rules_generation) {
+    return *cached_farbling_level_;
+  }
+
+  // Rules have not arrived yet, don't cache the fallback.
+  if (!content_setting_rules_)
+    return BraveFarblingLevel::BALANCED;
+
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
 
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  if (content_setting_rules_) {
-    if (IsBraveShieldsDown(frame,
-                           url::Origin(frame->GetSecurityOrigin()).GetURL())) {
-      setting = CONTENT_SETTING_ALLOW;
-    } else {
-      setting = GetBraveFPContentSettingFromRules(
-          content_setting_rules_->fingerprinting_rules, GetOriginOrURL(frame));
-    }
+  if (IsBraveShieldsDown(frame,
+                         url::Origin(frame->GetSecurityOrigin()).GetURL())) {
+    setting = CONTENT_SETTING_ALLOW;
+  } else {
+    setting = GetBraveFPContentSettingFromRules(
+        content_setting_rules_->fingerprinting_rules, GetOriginOrURL(frame));
   }
 
+  cached_farbling_level_rules_generation_ = g_content_setting_rules_generation;
   if (setting == CONTENT_SETTING_BLOCK) {
     VLOG(1) << "farbling level MAXIMUM";
-    return BraveFarblingLevel::MAXIMUM;
+    cached_farbling_level_ = BraveFarblingLevel::MAXIMUM;
   } else if (setting == CONTENT_SETTING_ALLOW) {
     VLOG(1) << "farbling level OFF";
-    return BraveFarblingLevel::OFF;
+    cached_farbling_level_ = BraveFarblingLevel::OFF;
   } else {
     VLOG(1) << "farbling level BALANCED";
-    return BraveFarblingLevel::BALANCED;
+    cached_farbling_level_ = BraveFarblingLevel::BALANCED;
   }
+  return *cached_farbling_level_;
 }
 
 bool BraveContentSettingsAgentImpl::AllowAutoplay(bool play_requested) {
@@ -21,6 +21,7 @@
 #include "mojo/public/cpp/bindings/associated_receiver_set.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_associated_receiver.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 #include "url/gurl.h"
 
@@ -44,6 +45,10 @@ class BraveContentSettingsAgentImpl
 
   bool IsFirstPartyCosmeticFilteringEnabled(const GURL& url) override;
 
+  // Called when the renderer receives new content setting rules, which can
+  // happen in the middle of a document's lifetime.
+  static void OnContentSettingRulesChanged();
+
  protected:
   bool AllowScript(bool enabled_per_settings) override;
   bool AllowScriptFromSource(bool enabled_per_settings,
@@ -102,6 +107,11 @@ class BraveContentSettingsAgentImpl
   base::flat_map<url::Origin, blink::WebSecurityOrigin>
       cached_ephemeral_storage_origins_;
 
+  // Farbling level resolved for the current document, and the rules
+  // generation it was resolved against.
+  absl::optional<BraveFarblingLevel> cached_farbling_level_;
+  uint64_t cached_farbling_level_rules_generation_ = 0;
+
   mojo::AssociatedRemote<brave_shields::mojom::BraveShieldsHost>
       brave_shields_remote_;
 
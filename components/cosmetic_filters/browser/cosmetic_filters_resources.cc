@@ -5,9 +5,10 @@
 
 #include "brave/components/cosmetic_filters/browser/cosmetic_filters_resources.h"
 
+#include <string>
 #include <utility>
+#include <vector>
 
-#include "base/json/json_reader.h"
 #include "base/values.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
@@ -16,63 +17,78 @@
 
 namespace cosmetic_filters {
 
-CosmeticFiltersResources::CosmeticFiltersResources(
-    brave_shields::AdBlockService* ad_block_service)
-    : ad_block_service_(ad_block_service) {}
-
-CosmeticFiltersResources::~CosmeticFiltersResources() {}
-
-void CosmeticFiltersResources::HiddenClassIdSelectors(
-    const std::string& input,
-    const std::vector<std::string>& exceptions,
-    HiddenClassIdSelectorsCallback callback) {
-  absl::optional<base::Value> input_value = base::JSONReader::Read(input);
-  if (!input_value || !input_value->is_dict()) {
-    // Nothing to work with
-    std::move(callback).Run(base::Value());
+namespace {
 
+void AppendStrings(const base::Value* list, std::vector<std::string>* out) {
+  if (!list || !list->is_list())
     return;
+  out->reserve(out->size() + list->GetList().size());
+  for (const auto& item : list->GetList()) {
+    if (item.is_string())
+      out->push_back(item.GetString());
   }
-  base::DictionaryValue* input_dict;
-  if (!input_value->GetAsDictionary(&input_dict)) {
-    std::move(callback).Run(base::Value());
+}
 
-    return;
-  }
-  std::vector<std::string> classes;
-  base::ListValue* classes_list;
-  if (input_dict->GetList("classes", &classes_list)) {
-    for (size_t i = 0; i < classes_list->GetList().size(); i++) {
-      if (!classes_list->GetList()[i].is_string()) {
-        continue;
-      }
-      classes.push_back(classes_list->GetList()[i].GetString());
+}  // namespace
+
+mojom::CosmeticResourcesPtr ToCosmeticResources(const base::Value& value) {
+  if (!value.is_dict())
+    return nullptr;
+
+  auto resources = mojom::CosmeticResources::New();
+  AppendStrings(value.FindListKey("hide_selectors"),
+                &resources->hide_selectors);
+  AppendStrings(value.FindListKey("force_hide_selectors"),
+                &resources->force_hide_selectors);
+  AppendStrings(value.FindListKey("exceptions"), &resources->exceptions);
+
+  if (const base::Value* style_selectors =
+          value.FindDictKey("style_selectors")) {
+    for (const auto item : style_selectors->DictItems()) {
+      AppendStrings(&item.second, &resources->style_selectors[item.first]);
     }
   }
-  std::vector<std::string> ids;
-  base::ListValue* ids_list;
-  if (input_dict->GetList("ids", &ids_list)) {
-    for (size_t i = 0; i < ids_list->GetList().size(); i++) {
-      if (!ids_list->GetList()[i].is_string()) {
-        continue;
-      }
-      ids.push_back(ids_list->GetList()[i].GetString());
-    }
+
+  if (const std::string* injected_script =
+          value.FindStringKey("injected_script")) {
+    resources->injected_script = *injected_script;
   }
+  resources->generichide = value.FindBoolKey("generichide").value_or(false);
 
-  auto selectors =
-      ad_block_service_->HiddenClassIdSelectors(classes, ids, exceptions);
+  return resources;
+}
+
+CosmeticFiltersResources::CosmeticFiltersResources(
+    brave_shields::AdBlockService* ad_block_service)
+    : ad_block_service_(ad_block_service) {}
+
+CosmeticFiltersResources::~CosmeticFiltersResources() {}
+
+void CosmeticFiltersResources::HiddenClassIdSelectors(
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids,
+    HiddenClassIdSelectorsCallback callback) {
+  const uint64_t engine_generation =
+      brave_shields::AdBlockBaseService::GetEngineGeneration();
+  auto selectors = ad_block_service_->HiddenClassIdSelectors(
+      classes, ids, /*exceptions=*/std::vector<std::string>());
 
-  std::move(callback).Run(selectors ? std::move(selectors.value())
-                                    : base::Value());
+  std::vector<std::string> result;
+  AppendStrings(selectors ? &*selectors : nullptr, &result);
+  std::move(callback).Run(std::move(result), engine_generation);
 }
 
 void CosmeticFiltersResources::UrlCosmeticResources(
     const std::string& url,
     UrlCosmeticResourcesCallback callback) {
+  const uint64_t engine_generation =
+      brave_shields::AdBlockBaseService::GetEngineGeneration();
   auto resources = ad_block_service_->UrlCosmeticResources(url);
-  std::move(callback).Run(resources ? std::move(resources.value())
-                                    : base::Value());
+  mojom::CosmeticResourcesPtr result =
+      resources ? ToCosmeticResources(*resources) : nullptr;
+  if (result)
+    result->engine_generation = engine_generation;
+  std::move(callback).Run(std::move(result));
 }
 
 }  // namespace cosmetic_filters
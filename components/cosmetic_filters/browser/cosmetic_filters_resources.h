@@ -23,6 +23,11 @@ class AdBlockService;
 
 namespace cosmetic_filters {
 
+// Converts the merged dictionary produced by AdBlockService into the typed
+// struct sent to the renderer. Entries of the wrong type are skipped; returns
+// null if |value| isn't a dictionary.
+mojom::CosmeticResourcesPtr ToCosmeticResources(const base::Value& value);
+
 // CosmeticFiltersResources is a class that is responsible for interaction
 // between CosmeticFiltersJSHandler class that lives inside renderer process.
 
@@ -36,9 +41,9 @@ class CosmeticFiltersResources final
   ~CosmeticFiltersResources() override;
 
   // Sends back to renderer a response about rules that has to be applied
-  // for the specified selectors.
-  void HiddenClassIdSelectors(const std::string& input,
-                              const std::vector<std::string>& exceptions,
+  // for the specified class and id names.
+  void HiddenClassIdSelectors(const std::vector<std::string>& classes,
+                              const std::vector<std::string>& ids,
                               HiddenClassIdSelectorsCallback callback) override;
 
   // Sends the renderer a response including whether or not to apply cosmetic
@@ -0,0 +1,89 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/cosmetic_filters/browser/cosmetic_filters_resources.h"
+
+#include <string>
+#include <vector>
+
+#include "base/json/json_reader.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace cosmetic_filters {
+
+namespace {
+
+mojom::CosmeticResourcesPtr Convert(const char* json) {
+  absl::optional<base::Value> value = base::JSONReader::Read(json);
+  EXPECT_TRUE(value);
+  return ToCosmeticResources(*value);
+}
+
+}  // namespace
+
+TEST(CosmeticFiltersResourcesTest, ConvertsAllFields) {
+  mojom::CosmeticResourcesPtr resources = Convert(R"({
+    "hide_selectors": [".ad", "#banner"],
+    "force_hide_selectors": [".custom"],
+    "style_selectors": {
+      ".sticky": ["position: static !important"],
+      ".overlay": []
+    },
+    "exceptions": [".ad-ok"],
+    "injected_script": "console.log(\"\\u2028\")",
+    "generichide": true
+  })");
+  ASSERT_TRUE(resources);
+  EXPECT_EQ((std::vector<std::string>{".ad", "#banner"}),
+            resources->hide_selectors);
+  EXPECT_EQ(std::vector<std::string>{".custom"},
+            resources->force_hide_selectors);
+  ASSERT_EQ(2u, resources->style_selectors.size());
+  EXPECT_EQ(std::vector<std::string>{"position: static !important"},
+            resources->style_selectors[".sticky"]);
+  EXPECT_TRUE(resources->style_selectors[".overlay"].empty());
+  EXPECT_EQ(std::vector<std::string>{".ad-ok"}, resources->exceptions);
+  EXPECT_EQ("console.log(\"\xE2\x80\xA8\")", resources->injected_script);
+  EXPECT_TRUE(resources->generichide);
+}
+
+TEST(CosmeticFiltersResourcesTest, ConvertsEmptyResources) {
+  mojom::CosmeticResourcesPtr resources = Convert("{}");
+  ASSERT_TRUE(resources);
+  EXPECT_TRUE(resources->hide_selectors.empty());
+  EXPECT_TRUE(resources->force_hide_selectors.empty());
+  EXPECT_TRUE(resources->style_selectors.empty());
+  EXPECT_TRUE(resources->exceptions.empty());
+  EXPECT_TRUE(resources->injected_script.empty());
+  EXPECT_FALSE(resources->generichide);
+}
+
+TEST(CosmeticFiltersResourcesTest, SkipsMalformedEntries) {
+  mojom::CosmeticResourcesPtr resources = Convert(R"({
+    "hide_selectors": [".ad", 1, null, {"a": "b"}],
+    "force_hide_selectors": ".custom",
+    "style_selectors": {".sticky": "position: static", ".x": [2, "a: b"]},
+    "exceptions": {"a": "b"},
+    "injected_script": ["x"],
+    "generichide": "true"
+  })");
+  ASSERT_TRUE(resources);
+  EXPECT_EQ(std::vector<std::string>{".ad"}, resources->hide_selectors);
+  EXPECT_TRUE(resources->force_hide_selectors.empty());
+  EXPECT_TRUE(resources->style_selectors[".sticky"].empty());
+  EXPECT_EQ(std::vector<std::string>{"a: b"},
+            resources->style_selectors[".x"]);
+  EXPECT_TRUE(resources->exceptions.empty());
+  EXPECT_TRUE(resources->injected_script.empty());
+  EXPECT_FALSE(resources->generichide);
+}
+
+TEST(CosmeticFiltersResourcesTest, RejectsNonDictionary) {
+  EXPECT_FALSE(Convert("[]"));
+  EXPECT_FALSE(Convert("\"hide_selectors\""));
+}
+
+}  // namespace cosmetic_filters
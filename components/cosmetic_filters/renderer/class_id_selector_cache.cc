@@ -0,0 +1,126 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/cosmetic_filters/renderer/class_id_selector_cache.h"
+
+#include "base/containers/flat_map.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+
+namespace cosmetic_filters {
+
+namespace {
+
+// Upper bound on the number of class and id names remembered each.
+constexpr size_t kMaxCachedNames = 4096;
+
+bool IsNameChar(char c) {
+  return base::IsAsciiAlphaNumeric(c) || c == '-' || c == '_' ||
+         static_cast<unsigned char>(c) >= 0x80;
+}
+
+// Generic hide rules are indexed by the class or id their selector starts
+// with, so the leading ".name" or "#name" token tells which of the requested
+// names a returned selector belongs to. Returns an empty piece for selectors
+// that can't be attributed this way, e.g. ones starting with an escape.
+base::StringPiece LeadingName(base::StringPiece selector) {
+  size_t end = 1;
+  while (end < selector.size() && IsNameChar(selector[end]))
+    ++end;
+  if (end < selector.size() && selector[end] == '\\')
+    return base::StringPiece();
+  return selector.substr(1, end - 1);
+}
+
+}  // namespace
+
+// static
+ClassIdSelectorCache* ClassIdSelectorCache::GetInstance() {
+  static base::NoDestructor<ClassIdSelectorCache> instance;
+  return instance.get();
+}
+
+ClassIdSelectorCache::ClassIdSelectorCache()
+    : class_selectors_(kMaxCachedNames), id_selectors_(kMaxCachedNames) {}
+
+ClassIdSelectorCache::~ClassIdSelectorCache() = default;
+
+void ClassIdSelectorCache::OnEngineGeneration(uint64_t engine_generation) {
+  if (engine_generation <= engine_generation_)
+    return;
+  Clear();
+  engine_generation_ = engine_generation;
+}
+
+void ClassIdSelectorCache::Lookup(const std::vector<std::string>& classes,
+                                  const std::vector<std::string>& ids,
+                                  std::vector<std::string>* selectors,
+                                  std::vector<std::string>* missing_classes,
+                                  std::vector<std::string>* missing_ids) {
+  for (const auto& class_name : classes) {
+    auto it = class_selectors_.Get(class_name);
+    if (it == class_selectors_.end()) {
+      missing_classes->push_back(class_name);
+      continue;
+    }
+    selectors->insert(selectors->end(), it->second.begin(), it->second.end());
+  }
+  for (const auto& id : ids) {
+    auto it = id_selectors_.Get(id);
+    if (it == id_selectors_.end()) {
+      missing_ids->push_back(id);
+      continue;
+    }
+    selectors->insert(selectors->end(), it->second.begin(), it->second.end());
+  }
+}
+
+void ClassIdSelectorCache::Store(uint64_t engine_generation,
+                                 const std::vector<std::string>& classes,
+                                 const std::vector<std::string>& ids,
+                                 const std::vector<std::string>& selectors) {
+  OnEngineGeneration(engine_generation);
+  // An answer computed against an older engine must not be cached.
+  if (engine_generation != engine_generation_)
+    return;
+
+  using SelectorsByNamePiece =
+      base::flat_map<base::StringPiece, std::vector<std::string>>;
+  SelectorsByNamePiece by_class;
+  SelectorsByNamePiece by_id;
+  for (const auto& class_name : classes)
+    by_class[class_name];
+  for (const auto& id : ids)
+    by_id[id];
+
+  for (const auto& selector : selectors) {
+    SelectorsByNamePiece* names = nullptr;
+    if (base::StartsWith(selector, "."))
+      names = &by_class;
+    else if (base::StartsWith(selector, "#"))
+      names = &by_id;
+    // If any selector can't be attributed to one of the requested names, a
+    // negative answer for the others can't be trusted either.
+    if (!names)
+      return;
+    auto it = names->find(LeadingName(selector));
+    if (it == names->end())
+      return;
+    it->second.push_back(selector);
+  }
+
+  for (auto& entry : by_class)
+    class_selectors_.Put(std::string(entry.first), std::move(entry.second));
+  for (auto& entry : by_id)
+    id_selectors_.Put(std::string(entry.first), std::move(entry.second));
+}
+
+void ClassIdSelectorCache::Clear() {
+  class_selectors_.Clear();
+  id_selectors_.Clear();
+}
+
+}  // namespace cosmetic_filters
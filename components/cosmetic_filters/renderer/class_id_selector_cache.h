@@ -0,0 +1,66 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_COSMETIC_FILTERS_RENDERER_CLASS_ID_SELECTOR_CACHE_H_
+#define BRAVE_COMPONENTS_COSMETIC_FILTERS_RENDERER_CLASS_ID_SELECTOR_CACHE_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+
+namespace cosmetic_filters {
+
+// Per renderer process cache of the generic hide selectors the browser
+// returned for individual class and id names. Both positive and negative
+// answers are kept so that names seen again in other frames or after a
+// navigation don't need another round trip. The whole cache is dropped when
+// the browser reports a newer ad-block engine generation.
+//
+// Only used on the render main thread.
+class ClassIdSelectorCache {
+ public:
+  static ClassIdSelectorCache* GetInstance();
+
+  ClassIdSelectorCache();
+  ~ClassIdSelectorCache();
+
+  ClassIdSelectorCache(const ClassIdSelectorCache&) = delete;
+  ClassIdSelectorCache& operator=(const ClassIdSelectorCache&) = delete;
+
+  // Clears the cache if |engine_generation| is newer than the generation the
+  // cached answers were computed against.
+  void OnEngineGeneration(uint64_t engine_generation);
+
+  // Appends the cached selectors for |classes| and |ids| to |selectors| and
+  // the names without a cached answer to |missing_classes|/|missing_ids|.
+  void Lookup(const std::vector<std::string>& classes,
+              const std::vector<std::string>& ids,
+              std::vector<std::string>* selectors,
+              std::vector<std::string>* missing_classes,
+              std::vector<std::string>* missing_ids);
+
+  // Records the browser's answer for a request about |classes| and |ids|.
+  void Store(uint64_t engine_generation,
+             const std::vector<std::string>& classes,
+             const std::vector<std::string>& ids,
+             const std::vector<std::string>& selectors);
+
+ private:
+  using SelectorsByName =
+      base::HashingMRUCache<std::string, std::vector<std::string>>;
+
+  void Clear();
+
+  uint64_t engine_generation_ = 0;
+  SelectorsByName class_selectors_;
+  SelectorsByName id_selectors_;
+};
+
+}  // namespace cosmetic_filters
+
+#endif  // BRAVE_COMPONENTS_COSMETIC_FILTERS_RENDERER_CLASS_ID_SELECTOR_CACHE_H_
@@ -0,0 +1,95 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/cosmetic_filters/renderer/class_id_selector_cache.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace cosmetic_filters {
+
+namespace {
+
+using Names = std::vector<std::string>;
+
+struct LookupResult {
+  Names selectors;
+  Names missing_classes;
+  Names missing_ids;
+};
+
+}  // namespace
+
+class ClassIdSelectorCacheTest : public testing::Test {
+ protected:
+  LookupResult Lookup(const Names& classes, const Names& ids) {
+    LookupResult result;
+    cache_.Lookup(classes, ids, &result.selectors, &result.missing_classes,
+                  &result.missing_ids);
+    return result;
+  }
+
+  ClassIdSelectorCache cache_;
+};
+
+TEST_F(ClassIdSelectorCacheTest, CachesPositiveAndNegativeAnswers) {
+  cache_.Store(1, {"ad", "content"}, {"banner"}, {".ad", "#banner > img"});
+
+  LookupResult result = Lookup({"ad", "content", "other"}, {"banner"});
+  EXPECT_EQ((Names{".ad", "#banner > img"}), result.selectors);
+  EXPECT_EQ(Names{"other"}, result.missing_classes);
+  EXPECT_TRUE(result.missing_ids.empty());
+}
+
+TEST_F(ClassIdSelectorCacheTest, AttributesSelectorsByLeadingName) {
+  cache_.Store(1, {"ad", "ad-banner"}, {},
+               {".ad-banner > div", ".ad.sponsored", ".ad_x"});
+  // ".ad_x" starts with a name that wasn't asked about, so the answer can't be
+  // attributed and nothing is cached.
+  EXPECT_EQ((Names{"ad", "ad-banner"}),
+            Lookup({"ad", "ad-banner"}, {}).missing_classes);
+
+  cache_.Store(1, {"ad", "ad-banner"}, {}, {".ad-banner > div", ".ad.x"});
+  EXPECT_EQ(Names{".ad-banner > div"}, Lookup({"ad-banner"}, {}).selectors);
+  EXPECT_EQ(Names{".ad.x"}, Lookup({"ad"}, {}).selectors);
+}
+
+TEST_F(ClassIdSelectorCacheTest, SkipsUnattributableSelectors) {
+  // Escaped names and selectors that don't start with a class or id can't be
+  // matched to a requested name.
+  cache_.Store(1, {"a"}, {}, {".a\\:b"});
+  EXPECT_EQ(Names{"a"}, Lookup({"a"}, {}).missing_classes);
+
+  cache_.Store(1, {"a"}, {}, {"div.a"});
+  EXPECT_EQ(Names{"a"}, Lookup({"a"}, {}).missing_classes);
+
+  // A class selector isn't attributed to an id of the same name.
+  cache_.Store(1, {}, {"a"}, {".a"});
+  EXPECT_EQ(Names{"a"}, Lookup({}, {"a"}).missing_ids);
+}
+
+TEST_F(ClassIdSelectorCacheTest, ClearedByNewerGeneration) {
+  cache_.Store(1, {"ad"}, {}, {".ad"});
+  cache_.OnEngineGeneration(1);
+  EXPECT_EQ(Names{".ad"}, Lookup({"ad"}, {}).selectors);
+
+  cache_.OnEngineGeneration(2);
+  EXPECT_EQ(Names{"ad"}, Lookup({"ad"}, {}).missing_classes);
+}
+
+TEST_F(ClassIdSelectorCacheTest, IgnoresAnswersFromOlderGeneration) {
+  cache_.OnEngineGeneration(2);
+  cache_.Store(1, {"ad"}, {}, {".ad"});
+  EXPECT_EQ(Names{"ad"}, Lookup({"ad"}, {}).missing_classes);
+
+  // An older generation reported late doesn't clear newer answers.
+  cache_.Store(2, {"ad"}, {}, {".ad"});
+  cache_.OnEngineGeneration(1);
+  EXPECT_EQ(Names{".ad"}, Lookup({"ad"}, {}).selectors);
+}
+
+}  // namespace cosmetic_filters
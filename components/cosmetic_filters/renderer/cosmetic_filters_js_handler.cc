@@ -8,12 +8,16 @@
 #include <utility>
 
 #include "base/bind.h"
-#include "base/json/json_writer.h"
+#include "base/callback_helpers.h"
+#include "base/containers/contains.h"
+#include "base/containers/cxx20_erase.h"
+#include "base/json/string_escape.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/no_destructor.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/components/content_settings/renderer/brave_content_settings_agent_impl.h"
+#include "brave/components/cosmetic_filters/renderer/class_id_selector_cache.h"
 #include "brave/components/cosmetic_filters/resources/grit/cosmetic_filters_generated_map.h"
 #include "components/content_settings/renderer/content_settings_agent_impl.h"
 #include "content/public/renderer/render_frame.h"
@@ -21,6 +25,7 @@
 #include "gin/function_template.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "third_party/blink/public/common/browser_interface_broker_proxy.h"
+#include "third_party/blink/public/platform/task_type.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_document.h"
 #include "third_party/blink/public/web/web_local_frame.h"
@@ -169,6 +174,26 @@ std::string LoadDataResource(const int id) {
   return std::string(resource_bundle.GetRawDataResource(id));
 }
 
+// Quotes and escapes |value| so that it can be embedded in a script as a
+// JavaScript string literal.
+std::string ToStringLiteral(const std::string& value) {
+  std::string literal;
+  base::EscapeJSONString(value, /*put_in_quotes=*/true, &literal);
+  return literal;
+}
+
+// Serializes |values| as a JavaScript array literal of strings.
+std::string ToArrayLiteral(const std::vector<std::string>& values) {
+  std::string literal = "[";
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (i > 0)
+      literal += ',';
+    base::EscapeJSONString(values[i], /*put_in_quotes=*/true, &literal);
+  }
+  literal += ']';
+  return literal;
+}
+
 bool IsVettedSearchEngine(const GURL& url) {
   std::string domain_and_registry =
       net::registry_controlled_domains::GetDomainAndRegistry(
@@ -204,14 +229,38 @@ CosmeticFiltersJSHandler::CosmeticFiltersJSHandler(
 CosmeticFiltersJSHandler::~CosmeticFiltersJSHandler() = default;
 
 void CosmeticFiltersJSHandler::HiddenClassIdSelectors(
-    const std::string& input) {
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids) {
+  std::vector<std::string> selectors;
+  std::vector<std::string> missing_classes;
+  std::vector<std::string> missing_ids;
+  ClassIdSelectorCache::GetInstance()->Lookup(
+      classes, ids, &selectors, &missing_classes, &missing_ids);
+
+  if (missing_classes.empty() && missing_ids.empty()) {
+    // This runs inside a call from the page's script, so the injection is
+    // posted rather than re-entering script here.
+    if (!selectors.empty()) {
+      render_frame_->GetTaskRunner(blink::TaskType::kInternalDefault)
+          ->PostTask(
+              FROM_HERE,
+              base::BindOnce(
+                  &CosmeticFiltersJSHandler::ApplyHiddenClassIdSelectors,
+                  weak_ptr_factory_.GetWeakPtr(), std::move(selectors)));
+    }
+    return;
+  }
+
   if (!EnsureConnected())
     return;
 
+  // The cached selectors are applied together with the fetched ones, so the
+  // observing script is only called once for this batch of names.
   cosmetic_filters_resources_->HiddenClassIdSelectors(
-      input, exceptions_,
+      missing_classes, missing_ids,
       base::BindOnce(&CosmeticFiltersJSHandler::OnHiddenClassIdSelectors,
-                     base::Unretained(this)));
+                     weak_ptr_factory_.GetWeakPtr(), missing_classes,
+                     missing_ids, std::move(selectors)));
 }
 
 bool CosmeticFiltersJSHandler::OnIsFirstParty(const std::string& url_string) {
@@ -303,7 +352,7 @@ void CosmeticFiltersJSHandler::OnRemoteDisconnect() {
 bool CosmeticFiltersJSHandler::ProcessURL(
     const GURL& url,
     absl::optional<base::OnceClosure> callback) {
-  resources_dict_.reset();
+  resources_.reset();
   url_ = url;
   enabled_1st_party_cf_ = false;
 
@@ -328,14 +377,15 @@ bool CosmeticFiltersJSHandler::ProcessURL(
     cosmetic_filters_resources_->UrlCosmeticResources(
         url_.spec(),
         base::BindOnce(&CosmeticFiltersJSHandler::OnUrlCosmeticResources,
-                       base::Unretained(this), std::move(callback.value())));
+                       weak_ptr_factory_.GetWeakPtr(),
+                       std::move(callback.value())));
   } else {
     SCOPED_UMA_HISTOGRAM_TIMER_MICROS(
         "Brave.CosmeticFilters.UrlCosmeticResourcesSync");
-    base::Value result;
-    cosmetic_filters_resources_->UrlCosmeticResources(url_.spec(), &result);
-    resources_dict_ = base::DictionaryValue::From(
-        base::Value::ToUniquePtrValue(std::move(result)));
+    mojom::CosmeticResourcesPtr resources;
+    cosmetic_filters_resources_->UrlCosmeticResources(url_.spec(),
+                                                      &resources);
+    OnUrlCosmeticResources(base::DoNothing(), std::move(resources));
   }
 
   return true;
@@ -343,28 +393,27 @@ bool CosmeticFiltersJSHandler::ProcessURL(
 
 void CosmeticFiltersJSHandler::OnUrlCosmeticResources(
     base::OnceClosure callback,
-    base::Value result) {
+    mojom::CosmeticResourcesPtr resources) {
   if (!EnsureConnected())
     return;
 
-  resources_dict_ = base::DictionaryValue::From(
-      base::Value::ToUniquePtrValue(std::move(result)));
+  if (resources) {
+    ClassIdSelectorCache::GetInstance()->OnEngineGeneration(
+        resources->engine_generation);
+  }
+  resources_ = std::move(resources);
   std::move(callback).Run();
 }
 
 void CosmeticFiltersJSHandler::ApplyRules() {
   blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  if (!resources_dict_ || web_frame->IsProvisional())
+  if (!resources_ || web_frame->IsProvisional())
     return;
 
-  std::string scriptlet_script;
-  base::Value* injected_script = resources_dict_->FindPath("injected_script");
-  if (injected_script &&
-      base::JSONWriter::Write(*injected_script, &scriptlet_script)) {
-    scriptlet_script =
-        base::StringPrintf(kScriptletInitScript, scriptlet_script.c_str());
-  }
-  if (!scriptlet_script.empty()) {
+  if (!resources_->injected_script.empty()) {
+    std::string scriptlet_script = base::StringPrintf(
+        kScriptletInitScript,
+        ToStringLiteral(resources_->injected_script).c_str());
     web_frame->ExecuteScriptInIsolatedWorld(
         isolated_world_id_, blink::WebString::FromUTF8(scriptlet_script),
         blink::BackForwardCacheAware::kAllow);
@@ -374,11 +423,9 @@ void CosmeticFiltersJSHandler::ApplyRules() {
     return;
 
   // Working on css rules, we do that on a main frame only
-  bool generichide = false;
-  resources_dict_->GetBoolean("generichide", &generichide);
   std::string cosmetic_filtering_init_script = base::StringPrintf(
       kCosmeticFilteringInitScript, enabled_1st_party_cf_ ? "true" : "false",
-      generichide ? "true" : "false");
+      resources_->generichide ? "true" : "false");
   std::string pre_init_script = base::StringPrintf(
       kPreInitScript, cosmetic_filtering_init_script.c_str());
 
@@ -387,112 +434,98 @@ void CosmeticFiltersJSHandler::ApplyRules() {
       blink::BackForwardCacheAware::kAllow);
   ExecuteObservingBundleEntryPoint();
 
-  CSSRulesRoutine(resources_dict_.get());
+  CSSRulesRoutine(*resources_);
 }
 
 void CosmeticFiltersJSHandler::CSSRulesRoutine(
-    base::DictionaryValue* resources_dict) {
+    const mojom::CosmeticResources& resources) {
   // Otherwise, if its a vetted engine AND we're not in aggressive
   // mode, also don't do cosmetic filtering.
   if (!enabled_1st_party_cf_ && IsVettedSearchEngine(url_))
     return;
 
   blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  base::ListValue* cf_exceptions_list;
-  if (resources_dict->GetList("exceptions", &cf_exceptions_list)) {
-    for (size_t i = 0; i < cf_exceptions_list->GetList().size(); i++) {
-      exceptions_.push_back(cf_exceptions_list->GetList()[i].GetString());
-    }
-  }
-  base::ListValue* hide_selectors_list;
-  if (!resources_dict->GetList("hide_selectors", &hide_selectors_list)) {
-    hide_selectors_list = nullptr;
-  }
-  base::ListValue* force_hide_selectors_list;
-  if (!resources_dict->GetList("force_hide_selectors",
-                               &force_hide_selectors_list)) {
-    force_hide_selectors_list = nullptr;
-  }
+  exceptions_.insert(resources.exceptions.begin(),
+                     resources.exceptions.end());
 
-  if (hide_selectors_list && hide_selectors_list->GetList().size() != 0) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*hide_selectors_list, &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
+  if (!resources.hide_selectors.empty()) {
     // Building a script for stylesheet modifications
     std::string new_selectors_script =
-        base::StringPrintf(kHideSelectorsInjectScript, json_selectors.c_str());
+        base::StringPrintf(kHideSelectorsInjectScript,
+                           ToArrayLiteral(resources.hide_selectors).c_str());
     web_frame->ExecuteScriptInIsolatedWorld(
         isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
         blink::BackForwardCacheAware::kAllow);
   }
 
-  if (force_hide_selectors_list &&
-      force_hide_selectors_list->GetList().size() != 0) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*force_hide_selectors_list, &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
+  if (!resources.force_hide_selectors.empty()) {
     // Building a script for stylesheet modifications
     std::string new_selectors_script = base::StringPrintf(
-        kForceHideSelectorsInjectScript, json_selectors.c_str());
+        kForceHideSelectorsInjectScript,
+        ToArrayLiteral(resources.force_hide_selectors).c_str());
     web_frame->ExecuteScriptInIsolatedWorld(
         isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
         blink::BackForwardCacheAware::kAllow);
   }
 
-  base::DictionaryValue* style_selectors_dictionary = nullptr;
-  if (resources_dict->GetDictionary("style_selectors",
-                                    &style_selectors_dictionary)) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*style_selectors_dictionary,
-                                 &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
-    std::string new_selectors_script =
-        base::StringPrintf(kStyleSelectorsInjectScript, json_selectors.c_str());
-    if (!json_selectors.empty()) {
-      web_frame->ExecuteScriptInIsolatedWorld(
-          isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
-          blink::BackForwardCacheAware::kAllow);
+  if (!resources.style_selectors.empty()) {
+    std::string style_selectors = "{";
+    for (const auto& style_selector : resources.style_selectors) {
+      if (style_selectors.size() > 1)
+        style_selectors += ',';
+      style_selectors += ToStringLiteral(style_selector.first);
+      style_selectors += ':';
+      style_selectors += ToArrayLiteral(style_selector.second);
     }
+    style_selectors += '}';
+    std::string new_selectors_script = base::StringPrintf(
+        kStyleSelectorsInjectScript, style_selectors.c_str());
+    web_frame->ExecuteScriptInIsolatedWorld(
+        isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
+        blink::BackForwardCacheAware::kAllow);
   }
 
   if (!enabled_1st_party_cf_)
     ExecuteObservingBundleEntryPoint();
 }
 
-void CosmeticFiltersJSHandler::OnHiddenClassIdSelectors(base::Value result) {
+void CosmeticFiltersJSHandler::OnHiddenClassIdSelectors(
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids,
+    std::vector<std::string> cached_selectors,
+    const std::vector<std::string>& selectors,
+    uint64_t engine_generation) {
+  ClassIdSelectorCache::GetInstance()->Store(engine_generation, classes, ids,
+                                             selectors);
+  cached_selectors.insert(cached_selectors.end(), selectors.begin(),
+                          selectors.end());
+  ApplyHiddenClassIdSelectors(std::move(cached_selectors));
+}
+
+void CosmeticFiltersJSHandler::ApplyHiddenClassIdSelectors(
+    std::vector<std::string> selectors) {
   // If its a vetted engine AND we're not in aggressive
   // mode, don't do cosmetic filtering.
   if (!enabled_1st_party_cf_ && IsVettedSearchEngine(url_))
     return;
 
-  // We expect a List value from adblock service. That is
-  // an extra check to be sure that adblock file exist and gives us
-  // rules that we expect
-  base::ListValue* selectors_list;
-  if (!result.GetAsList(&selectors_list))
-    return;
-
-  blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  std::string json_selectors;
-  if (!base::JSONWriter::Write(*selectors_list, &json_selectors) ||
-      json_selectors.empty()) {
-    json_selectors = "[]";
-  }
-  // Building a script for stylesheet modifications
-  std::string new_selectors_script =
-      base::StringPrintf(kHideSelectorsInjectScript, json_selectors.c_str());
-  if (selectors_list->GetList().size() != 0) {
+  // Exceptions are applied here rather than in the browser so that the
+  // selectors cached per class and id name are the same for every page.
+  base::EraseIf(selectors, [this](const std::string& selector) {
+    return base::Contains(exceptions_, selector);
+  });
+  if (!selectors.empty()) {
+    blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
+    // Building a script for stylesheet modifications
+    std::string new_selectors_script = base::StringPrintf(
+        kHideSelectorsInjectScript, ToArrayLiteral(selectors).c_str());
     web_frame->ExecuteScriptInIsolatedWorld(
         isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
         blink::BackForwardCacheAware::kAllow);
   }
 
+  // The observing script keeps watching for new class and id names even when
+  // none of the current ones are hidden.
   if (!enabled_1st_party_cf_)
     ExecuteObservingBundleEntryPoint();
 }
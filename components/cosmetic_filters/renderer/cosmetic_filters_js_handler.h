@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_set.h"
 #include "base/memory/weak_ptr.h"
 #include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
 #include "content/public/renderer/render_frame.h"
@@ -37,6 +38,9 @@ class CosmeticFiltersJSHandler {
   // Fetches an initial set of resources to inject into the page if cosmetic
   // filtering is enabled, and returns whether or not to proceed with cosmetic
   // filtering.
+  // With a |callback|, the resources are requested asynchronously and
+  // |callback| runs once they have arrived. Without one, they are fetched
+  // with a sync IPC before returning.
   bool ProcessURL(const GURL& url, absl::optional<base::OnceClosure> callback);
   void ApplyRules();
 
@@ -58,13 +62,20 @@ class CosmeticFiltersJSHandler {
 
   void CreateWorkerObject(v8::Isolate* isolate, v8::Local<v8::Context> context);
 
-  // A function to be called from JS
-  void HiddenClassIdSelectors(const std::string& input);
+  // A function to be called from JS with the class and id names seen since
+  // the last call.
+  void HiddenClassIdSelectors(const std::vector<std::string>& classes,
+                              const std::vector<std::string>& ids);
 
   void OnUrlCosmeticResources(base::OnceClosure callback,
-                              base::Value result);
-  void CSSRulesRoutine(base::DictionaryValue* resources_dict);
-  void OnHiddenClassIdSelectors(base::Value result);
+                              mojom::CosmeticResourcesPtr resources);
+  void CSSRulesRoutine(const mojom::CosmeticResources& resources);
+  void OnHiddenClassIdSelectors(const std::vector<std::string>& classes,
+                                const std::vector<std::string>& ids,
+                                std::vector<std::string> cached_selectors,
+                                const std::vector<std::string>& selectors,
+                                uint64_t engine_generation);
+  void ApplyHiddenClassIdSelectors(std::vector<std::string> selectors);
   bool OnIsFirstParty(const std::string& url_string);
 
   content::RenderFrame* render_frame_;
@@ -72,9 +83,9 @@ class CosmeticFiltersJSHandler {
       cosmetic_filters_resources_;
   int32_t isolated_world_id_;
   bool enabled_1st_party_cf_;
-  std::vector<std::string> exceptions_;
+  base::flat_set<std::string> exceptions_;
   GURL url_;
-  std::unique_ptr<base::DictionaryValue> resources_dict_;
+  mojom::CosmeticResourcesPtr resources_;
 
   // True if the content_cosmetic.bundle.js has injected in the current frame.
   bool bundle_injected_ = false;
@@ -86,12 +86,16 @@ void CosmeticFiltersJsRenderFrameObserver::ReadyToCommitNavigation(
     if (native_javascript_handle_->ProcessURL(url_, absl::nullopt)) {
       ready_->Signal();
     }
-  } else {
-    native_javascript_handle_->ProcessURL(
-        url_, absl::make_optional(base::BindOnce(
-                  &CosmeticFiltersJsRenderFrameObserver::OnProcessURL,
-                  weak_factory_.GetWeakPtr())));
+    return;
   }
+
+  // Resources are requested asynchronously as soon as the navigation is
+  // about to commit, so the browser usually answers (often from its cache)
+  // before the document starts running scripts.
+  native_javascript_handle_->ProcessURL(
+      url_, absl::make_optional(base::BindOnce(
+                &CosmeticFiltersJsRenderFrameObserver::OnProcessURL,
+                weak_factory_.GetWeakPtr())));
 }
 
 void CosmeticFiltersJsRenderFrameObserver::RunScriptsAtDocumentStart() {
@@ -27,6 +27,9 @@ const queriedClasses = new Set<string>()
 let notYetQueriedClasses: string[]
 let notYetQueriedIds: string[]
 let cosmeticObserver: MutationObserver | undefined
+// Pending animation frame request for sending the names collected from
+// mutations, so that a burst of mutations results in a single query.
+let fetchNewClassIdRulesFrameId: number | undefined
 
 window.content_cosmetic = window.content_cosmetic || {}
 const CC = window.content_cosmetic
@@ -96,14 +99,21 @@ const fetchNewClassIdRules = () => {
   }
   // Callback to c++ renderer process
   // @ts-expect-error
-  cf_worker.hiddenClassIdSelectors(
-      JSON.stringify({
-        classes: notYetQueriedClasses, ids: notYetQueriedIds
-      }))
+  cf_worker.hiddenClassIdSelectors(notYetQueriedClasses, notYetQueriedIds)
   notYetQueriedClasses = []
   notYetQueriedIds = []
 }
 
+const scheduleFetchNewClassIdRules = () => {
+  if (fetchNewClassIdRulesFrameId !== undefined) {
+    return
+  }
+  fetchNewClassIdRulesFrameId = window.requestAnimationFrame(() => {
+    fetchNewClassIdRulesFrameId = undefined
+    fetchNewClassIdRules()
+  })
+}
+
 const handleMutations: MutationCallback = (mutations: MutationRecord[]) => {
   for (const aMutation of mutations) {
     if (aMutation.type === 'attributes') {
@@ -152,7 +162,7 @@ const handleMutations: MutationCallback = (mutations: MutationRecord[]) => {
     }
   }
 
-  fetchNewClassIdRules()
+  scheduleFetchNewClassIdRules()
 }
 
 const isFirstPartyUrl = (url: string): boolean => {
@@ -45,6 +45,8 @@ void DecentralizedDnsService::RegisterLocalStatePrefs(
 }
 
 void DecentralizedDnsService::OnPreferenceChanged() {
+  ens_cache_.Clear();
+  unstoppable_domains_cache_.Clear();
   delegate_->UpdateNetworkService();
 }
 
@@ -7,7 +7,10 @@
 #define BRAVE_COMPONENTS_DECENTRALIZED_DNS_DECENTRALIZED_DNS_SERVICE_H_
 
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "brave/components/decentralized_dns/resolution_cache.h"
 #include "components/keyed_service/core/keyed_service.h"
 
 namespace content {
@@ -35,11 +38,20 @@ class DecentralizedDnsService : public KeyedService {
 
   static void RegisterLocalStatePrefs(PrefRegistrySimple* registry);
 
+  // Content hashes of ENS names.
+  ResolutionCache<std::string>* ens_cache() { return &ens_cache_; }
+  // Browser resolution records of Unstoppable Domains names, see kRecordKeys.
+  ResolutionCache<std::vector<std::string>>* unstoppable_domains_cache() {
+    return &unstoppable_domains_cache_;
+  }
+
  private:
   void OnPreferenceChanged();
 
   std::unique_ptr<PrefChangeRegistrar> pref_change_registrar_;
   std::unique_ptr<DecentralizedDnsServiceDelegate> delegate_;
+  ResolutionCache<std::string> ens_cache_;
+  ResolutionCache<std::vector<std::string>> unstoppable_domains_cache_;
 };
 
 }  // namespace decentralized_dns
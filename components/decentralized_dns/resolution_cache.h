@@ -0,0 +1,122 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_DECENTRALIZED_DNS_RESOLUTION_CACHE_H_
+#define BRAVE_COMPONENTS_DECENTRALIZED_DNS_RESOLUTION_CACHE_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/flat_map.h"
+#include "base/containers/mru_cache.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/default_tick_clock.h"
+#include "base/time/tick_clock.h"
+#include "base/time/time.h"
+
+namespace decentralized_dns {
+
+// Successful lookups are kept for this long. On-chain records rarely change
+// and the JSON-RPC responses carry no TTL of their own.
+constexpr base::TimeDelta kResolvedTTL = base::TimeDelta::FromMinutes(5);
+// Failed lookups (no resolver, RPC errors) are kept briefly so the
+// subresources of a page don't each repeat them, while a reload soon after
+// still retries.
+constexpr base::TimeDelta kFailedTTL = base::TimeDelta::FromSeconds(30);
+constexpr size_t kMaxResolutionCacheSize = 128;
+
+// Caches the results of resolving decentralized DNS names and coalesces
+// concurrent lookups of the same name into one request. |T| is the raw result
+// type of the lookup.
+template <typename T>
+class ResolutionCache {
+ public:
+  using ResultCallback =
+      base::OnceCallback<void(bool success, const T& result)>;
+
+  struct Entry {
+    bool success = false;
+    T result;
+    base::TimeTicks expiry;
+  };
+
+  explicit ResolutionCache(
+      const base::TickClock* clock = base::DefaultTickClock::GetInstance())
+      : clock_(clock), entries_(kMaxResolutionCacheSize) {}
+  ~ResolutionCache() = default;
+
+  ResolutionCache(const ResolutionCache&) = delete;
+  ResolutionCache& operator=(const ResolutionCache&) = delete;
+
+  // Returns the unexpired entry for |name|, or nullptr.
+  const Entry* Get(const std::string& name) {
+    auto it = entries_.Get(name);
+    if (it == entries_.end())
+      return nullptr;
+    if (it->second.expiry <= clock_->NowTicks()) {
+      entries_.Erase(it);
+      return nullptr;
+    }
+    return &it->second;
+  }
+
+  // Queues |callback| for the result of resolving |name|. Returns true if no
+  // lookup of |name| is in flight, in which case the caller must start one and
+  // report its result through the callback from GetResolvedCallback().
+  bool AddPendingRequest(const std::string& name, ResultCallback callback) {
+    auto& callbacks = pending_[PendingKey(generation_, name)];
+    callbacks.push_back(std::move(callback));
+    return callbacks.size() == 1;
+  }
+
+  ResultCallback GetResolvedCallback(const std::string& name) {
+    return base::BindOnce(&ResolutionCache::OnResolved,
+                          weak_factory_.GetWeakPtr(), generation_, name);
+  }
+
+  // Drops all cached results. Lookups already in flight still answer their
+  // callers, but their results aren't cached, and new requests for the same
+  // names start fresh lookups instead of joining them.
+  void Clear() {
+    entries_.Clear();
+    ++generation_;
+  }
+
+ private:
+  using PendingKey = std::pair<uint64_t, std::string>;
+
+  void OnResolved(uint64_t generation,
+                  const std::string& name,
+                  bool success,
+                  const T& result) {
+    if (generation == generation_) {
+      entries_.Put(name,
+                   Entry{success, result,
+                         clock_->NowTicks() +
+                             (success ? kResolvedTTL : kFailedTTL)});
+    }
+
+    auto it = pending_.find(PendingKey(generation, name));
+    if (it == pending_.end())
+      return;
+    std::vector<ResultCallback> callbacks = std::move(it->second);
+    pending_.erase(it);
+    for (auto& callback : callbacks)
+      std::move(callback).Run(success, result);
+  }
+
+  const base::TickClock* clock_;
+  base::MRUCache<std::string, Entry> entries_;
+  // Bumped by Clear() to fence off lookups started before it.
+  uint64_t generation_ = 0;
+  base::flat_map<PendingKey, std::vector<ResultCallback>> pending_;
+  base::WeakPtrFactory<ResolutionCache> weak_factory_{this};
+};
+
+}  // namespace decentralized_dns
+
+#endif  // BRAVE_COMPONENTS_DECENTRALIZED_DNS_RESOLUTION_CACHE_H_
@@ -20,5 +20,10 @@ const base::Feature kIpfsFeature{
 #endif
 };
 
+// With a local node, races it against the public gateway for each ipfs://
+// navigation and goes to whichever serves the content first.
+const base::Feature kIpfsGatewayRacingFeature{
+    "IpfsGatewayRacing", base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace features
 }  // namespace ipfs
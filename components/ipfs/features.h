@@ -14,6 +14,7 @@ namespace ipfs {
 namespace features {
 
 extern const base::Feature kIpfsFeature;
+extern const base::Feature kIpfsGatewayRacingFeature;
 
 }  // namespace features
 }  // namespace ipfs
@@ -0,0 +1,136 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/ipfs_gateway_race.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "brave/components/ipfs/ipfs_network_utils.h"
+#include "brave/components/ipfs/ipfs_utils.h"
+#include "net/http/http_response_headers.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+
+namespace ipfs {
+
+namespace {
+
+// Checks the X-Ipfs-Path a gateway reports against what was asked for, e.g.
+// /ipfs/[cid]/index.html. Gateways may re-encode a CIDv0 root as its base32
+// CIDv1, so a CIDv0 root also matches that CIDv1.
+bool IsRequestedRoot(const std::string& served,
+                     const std::string& requested,
+                     const std::string& ns) {
+  if (base::EqualsCaseInsensitiveASCII(served, requested))
+    return true;
+  if (ns != kIPFSScheme)
+    return false;
+  const std::string cidv1 = CIDv0ToCIDv1(requested);
+  return !cidv1.empty() && base::EqualsCaseInsensitiveASCII(served, cidv1);
+}
+
+bool IsRequestedPath(const std::string& served, const std::string& requested) {
+  const auto split = [](const std::string& path) {
+    return base::SplitString(base::TrimString(path, "/", base::TRIM_ALL), "/",
+                             base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
+  };
+  const std::vector<std::string> served_parts = split(served);
+  const std::vector<std::string> requested_parts = split(requested);
+  if (served_parts.size() != requested_parts.size() ||
+      requested_parts.size() < 2) {
+    return false;
+  }
+  for (size_t i = 0; i < requested_parts.size(); i++) {
+    if (i != 1) {
+      if (served_parts[i] != requested_parts[i])
+        return false;
+    } else if (!IsRequestedRoot(served_parts[i], requested_parts[i],
+                                requested_parts[0])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+IpfsGatewayRace::IpfsGatewayRace(const GURL& ipfs_uri,
+                                 const std::vector<GURL>& gateways)
+    : gateways_(gateways) {
+  for (const auto& gateway : gateways_) {
+    GURL url;
+    if (!TranslateIPFSURI(ipfs_uri, &url, gateway, false))
+      url = GURL();
+    urls_.push_back(url);
+  }
+}
+
+IpfsGatewayRace::~IpfsGatewayRace() = default;
+
+void IpfsGatewayRace::Start(
+    network::SharedURLLoaderFactory* url_loader_factory,
+    ResultCallback callback) {
+  callback_ = std::move(callback);
+  loaders_.resize(urls_.size());
+  for (size_t i = 0; i < urls_.size(); i++) {
+    if (!urls_[i].is_valid())
+      continue;
+    loaders_[i] = CreateURLLoader(urls_[i], "HEAD");
+    loaders_[i]->SetTimeoutDuration(kGatewayRaceTimeout);
+    pending_++;
+  }
+  if (!pending_) {
+    std::move(callback_).Run(GURL());
+    return;
+  }
+  for (size_t i = 0; i < loaders_.size(); i++) {
+    if (!loaders_[i])
+      continue;
+    loaders_[i]->DownloadHeadersOnly(
+        url_loader_factory, base::BindOnce(&IpfsGatewayRace::OnResponse,
+                                           base::Unretained(this), i));
+  }
+}
+
+void IpfsGatewayRace::OnResponse(
+    size_t index,
+    scoped_refptr<net::HttpResponseHeaders> headers) {
+  loaders_[index].reset();
+  pending_--;
+
+  // Only a gateway that reports serving the requested path wins, so that a
+  // captive portal or an error page answering 200 can't.
+  std::string ipfs_path;
+  const bool served =
+      headers && headers->response_code() >= 200 &&
+      headers->response_code() < 300 &&
+      headers->GetNormalizedHeader("x-ipfs-path", &ipfs_path) &&
+      IsRequestedPath(ipfs_path, urls_[index].path());
+  if (!served) {
+    VLOG(1) << "Gateway " << gateways_[index].spec() << " didn't serve "
+            << urls_[index].spec();
+    if (OnlyFirstGatewayPending()) {
+      loaders_.clear();
+      pending_ = 0;
+    }
+    if (!pending_)
+      std::move(callback_).Run(GURL());
+    return;
+  }
+
+  // Cancel the rest.
+  loaders_.clear();
+  pending_ = 0;
+  std::move(callback_).Run(gateways_[index]);
+}
+
+bool IpfsGatewayRace::OnlyFirstGatewayPending() const {
+  return pending_ == 1 && !loaders_.empty() && loaders_[0];
+}
+
+}  // namespace ipfs
@@ -0,0 +1,72 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_IPFS_IPFS_GATEWAY_RACE_H_
+#define BRAVE_COMPONENTS_IPFS_IPFS_GATEWAY_RACE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/time/time.h"
+#include "url/gurl.h"
+
+namespace net {
+class HttpResponseHeaders;
+}  // namespace net
+
+namespace network {
+class SharedURLLoaderFactory;
+class SimpleURLLoader;
+}  // namespace network
+
+namespace ipfs {
+
+// Gateways that haven't answered by then are treated as not having the
+// content. Navigations wait on the race, so this is kept short.
+constexpr base::TimeDelta kGatewayRaceTimeout =
+    base::TimeDelta::FromSeconds(3);
+
+// Asks several gateways whether they can serve an ipfs:// or ipns:// URI at
+// the same time and picks the first one that answers for it. The requests
+// still outstanding at that point are cancelled. The first gateway is the one
+// used when none wins, so the race also ends as soon as every other gateway
+// has failed.
+class IpfsGatewayRace {
+ public:
+  // |gateway| is the winning entry of the gateways raced, or empty if none of
+  // them served the content.
+  using ResultCallback = base::OnceCallback<void(const GURL& gateway)>;
+
+  IpfsGatewayRace(const GURL& ipfs_uri, const std::vector<GURL>& gateways);
+  ~IpfsGatewayRace();
+  IpfsGatewayRace(const IpfsGatewayRace&) = delete;
+  IpfsGatewayRace& operator=(const IpfsGatewayRace&) = delete;
+
+  // |callback| is run last, so it may delete |this|.
+  void Start(network::SharedURLLoaderFactory* url_loader_factory,
+             ResultCallback callback);
+
+ private:
+  void OnResponse(size_t index,
+                  scoped_refptr<net::HttpResponseHeaders> headers);
+  // Whether the first gateway is the only one left, so that it would be used
+  // whether it wins or not.
+  bool OnlyFirstGatewayPending() const;
+
+  std::vector<GURL> gateways_;
+  // What each gateway is asked for, empty where |ipfs_uri| can't be
+  // translated.
+  std::vector<GURL> urls_;
+  std::vector<std::unique_ptr<network::SimpleURLLoader>> loaders_;
+  size_t pending_ = 0;
+  ResultCallback callback_;
+};
+
+}  // namespace ipfs
+
+#endif  // BRAVE_COMPONENTS_IPFS_IPFS_GATEWAY_RACE_H_
@@ -0,0 +1,166 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/ipfs_gateway_race.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "net/http/http_status_code.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "services/network/test/test_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ipfs {
+
+namespace {
+
+const char kCID[] = "QmfM2r8seH2GiRaC4esTjeraXEachRt8ZsSeGaWTPLyMoG";
+const char kOtherCID[] = "QmSrPmbaUKA3ZodhzPWZnpFgcPMFWF4QsxXbkWfEptTBJd";
+// kCID and kOtherCID as base32 CIDv1.
+const char kCIDv1[] =
+    "bafybeih4v623g54vbdrm5iw7caen2yqzgqeemwvz5qspvqt56wurdist7m";
+const char kOtherCIDv1[] =
+    "bafybeicdbvdywksfzbklqq4kyoeabzwgx7waimdboyrxbyuuxtxbbkffiy";
+const char kLocalGateway[] = "http://localhost:48080/";
+const char kPublicGateway[] = "https://dweb.link/";
+
+std::string GetGatewayURL(const char* gateway, const char* cid) {
+  return std::string(gateway) + "ipfs/" + cid + "/index.html";
+}
+
+}  // namespace
+
+class IpfsGatewayRaceTest : public testing::Test {
+ public:
+  IpfsGatewayRaceTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME),
+        shared_url_loader_factory_(
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)) {}
+
+ protected:
+  void StartRace() {
+    race_ = std::make_unique<IpfsGatewayRace>(
+        GURL(std::string("ipfs://") + kCID + "/index.html"),
+        std::vector<GURL>{GURL(kLocalGateway), GURL(kPublicGateway)});
+    race_->Start(shared_url_loader_factory_.get(),
+                 base::BindLambdaForTesting([this](const GURL& gateway) {
+                   winner_ = gateway;
+                   done_ = true;
+                 }));
+  }
+
+  void Respond(const char* gateway,
+               net::HttpStatusCode status,
+               const std::string& ipfs_path) {
+    auto head = network::CreateURLResponseHead(status);
+    if (!ipfs_path.empty())
+      head->headers->AddHeader("X-Ipfs-Path", ipfs_path);
+    url_loader_factory_.AddResponse(GURL(GetGatewayURL(gateway, kCID)),
+                                    std::move(head), "",
+                                    network::URLLoaderCompletionStatus());
+    task_environment_.RunUntilIdle();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  std::unique_ptr<IpfsGatewayRace> race_;
+  GURL winner_;
+  bool done_ = false;
+};
+
+TEST_F(IpfsGatewayRaceTest, AsksEveryGateway) {
+  StartRace();
+  EXPECT_TRUE(
+      url_loader_factory_.IsPending(GetGatewayURL(kLocalGateway, kCID)));
+  EXPECT_TRUE(
+      url_loader_factory_.IsPending(GetGatewayURL(kPublicGateway, kCID)));
+  EXPECT_FALSE(done_);
+}
+
+TEST_F(IpfsGatewayRaceTest, FirstToServeWinsAndOthersAreCancelled) {
+  StartRace();
+  Respond(kPublicGateway, net::HTTP_OK,
+          std::string("/ipfs/") + kCID + "/index.html");
+  EXPECT_TRUE(done_);
+  EXPECT_EQ(GURL(kPublicGateway), winner_);
+  EXPECT_EQ(0, url_loader_factory_.NumPending());
+}
+
+TEST_F(IpfsGatewayRaceTest, SkipsGatewaysThatDontServeContent) {
+  StartRace();
+  Respond(kLocalGateway, net::HTTP_NOT_FOUND,
+          std::string("/ipfs/") + kCID + "/index.html");
+  EXPECT_FALSE(done_);
+  Respond(kPublicGateway, net::HTTP_OK,
+          std::string("/ipfs/") + kCID + "/index.html");
+  EXPECT_TRUE(done_);
+  EXPECT_EQ(GURL(kPublicGateway), winner_);
+}
+
+TEST_F(IpfsGatewayRaceTest, SkipsGatewaysWithoutIpfsPath) {
+  StartRace();
+  // E.g. a captive portal answering everything with 200.
+  Respond(kLocalGateway, net::HTTP_OK, "");
+  EXPECT_FALSE(done_);
+  Respond(kPublicGateway, net::HTTP_OK, "");
+  EXPECT_TRUE(done_);
+  EXPECT_TRUE(winner_.is_empty());
+}
+
+TEST_F(IpfsGatewayRaceTest, SkipsGatewaysServingOtherContent) {
+  StartRace();
+  Respond(kLocalGateway, net::HTTP_OK,
+          std::string("/ipfs/") + kCID + "/other.html");
+  EXPECT_FALSE(done_);
+  Respond(kPublicGateway, net::HTTP_OK,
+          std::string("/ipfs/") + kOtherCID + "/index.html");
+  EXPECT_TRUE(done_);
+  EXPECT_TRUE(winner_.is_empty());
+}
+
+TEST_F(IpfsGatewayRaceTest, EndsOnceOnlyFirstGatewayIsLeft) {
+  StartRace();
+  // The local node would be used whether it wins or not, so don't wait for it.
+  Respond(kPublicGateway, net::HTTP_NOT_FOUND,
+          std::string("/ipfs/") + kCID + "/index.html");
+  EXPECT_TRUE(done_);
+  EXPECT_TRUE(winner_.is_empty());
+  EXPECT_EQ(0, url_loader_factory_.NumPending());
+}
+
+TEST_F(IpfsGatewayRaceTest, AcceptsReencodedCIDv0) {
+  StartRace();
+  // Subdomain gateways report CIDv0 roots as CIDv1.
+  Respond(kPublicGateway, net::HTTP_OK,
+          std::string("/ipfs/") + kCIDv1 + "/index.html");
+  EXPECT_EQ(GURL(kPublicGateway), winner_);
+}
+
+TEST_F(IpfsGatewayRaceTest, SkipsReencodedOtherCIDv0) {
+  StartRace();
+  Respond(kLocalGateway, net::HTTP_OK,
+          std::string("/ipfs/") + kOtherCIDv1 + "/index.html");
+  EXPECT_FALSE(done_);
+  Respond(kPublicGateway, net::HTTP_OK,
+          std::string("/ipfs/") + kCIDv1 + "/index.html");
+  EXPECT_EQ(GURL(kPublicGateway), winner_);
+}
+
+TEST_F(IpfsGatewayRaceTest, GivesUpAfterTimeout) {
+  StartRace();
+  task_environment_.FastForwardBy(kGatewayRaceTimeout);
+  EXPECT_TRUE(done_);
+  EXPECT_TRUE(winner_.is_empty());
+}
+
+}  // namespace ipfs
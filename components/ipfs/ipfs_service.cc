@@ -10,6 +10,7 @@
 #include "base/command_line.h"
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/process/launch.h"
 #include "base/process/process.h"
 #include "base/rand_util.h"
@@ -869,6 +870,36 @@ void IpfsService::OnPreWarmComplete(
     std::move(prewarm_callback_for_testing_).Run();
 }
 
+void IpfsService::RaceGateways(const GURL& ipfs_uri,
+                               RaceGatewaysCallback callback) {
+  auto race = std::make_unique<IpfsGatewayRace>(
+      ipfs_uri, std::vector<GURL>{GetDefaultIPFSLocalGateway(channel_),
+                                  GetDefaultIPFSGateway(prefs_)});
+  auto iter = gateway_races_.insert(gateway_races_.begin(), std::move(race));
+  iter->get()->Start(
+      url_loader_factory_.get(),
+      base::BindOnce(&IpfsService::OnGatewayRaceComplete,
+                     base::Unretained(this), iter, std::move(callback),
+                     base::TimeTicks::Now()));
+}
+
+void IpfsService::OnGatewayRaceComplete(
+    std::list<std::unique_ptr<IpfsGatewayRace>>::iterator iter,
+    RaceGatewaysCallback callback,
+    base::TimeTicks start_time,
+    const GURL& gateway) {
+  gateway_races_.erase(iter);
+  // Local node (0), public gateway (1), neither, including races that ended
+  // with only the local node left (2)
+  int winner = 2;
+  if (!gateway.is_empty())
+    winner = gateway == GetDefaultIPFSLocalGateway(channel_) ? 0 : 1;
+  UMA_HISTOGRAM_EXACT_LINEAR("Brave.IPFS.GatewayRaceWinner", winner, 3);
+  UMA_HISTOGRAM_TIMES("Brave.IPFS.GatewayRaceTime",
+                      base::TimeTicks::Now() - start_time);
+  std::move(callback).Run(gateway);
+}
+
 void IpfsService::ValidateGateway(const GURL& url, BoolCallback callback) {
   GURL::Replacements replacements;
   std::string path = "/ipfs/";
@@ -22,6 +22,7 @@
 #include "brave/components/ipfs/buildflags/buildflags.h"
 #include "brave/components/ipfs/import/imported_data.h"
 #include "brave/components/ipfs/ipfs_constants.h"
+#include "brave/components/ipfs/ipfs_gateway_race.h"
 #include "brave/components/ipfs/ipfs_p3a.h"
 #include "brave/components/ipfs/node_info.h"
 #include "brave/components/ipfs/repo_stats.h"
@@ -77,6 +78,7 @@ class IpfsService : public KeyedService,
 
   using BoolCallback = base::OnceCallback<void(bool)>;
   using GetConfigCallback = base::OnceCallback<void(bool, const std::string&)>;
+  using RaceGatewaysCallback = base::OnceCallback<void(const GURL&)>;
 
   // Retry after some time If local node responded with error.
   // The connected peers are often called immediately after startup
@@ -103,6 +105,10 @@ class IpfsService : public KeyedService,
   void ValidateGateway(const GURL& url, BoolCallback callback);
 
   virtual void PreWarmShareableLink(const GURL& url);
+  // Asks the local node's gateway and the public gateway for |ipfs_uri| at
+  // once. |callback| gets the base URL of whichever serves it first, or an
+  // empty URL if neither does.
+  void RaceGateways(const GURL& ipfs_uri, RaceGatewaysCallback callback);
 
 #if BUILDFLAG(ENABLE_IPFS_LOCAL_NODE)
   virtual void ImportFileToIpfs(const base::FilePath& path,
@@ -203,6 +209,11 @@ class IpfsService : public KeyedService,
                            std::unique_ptr<std::string> response_body);
   void OnPreWarmComplete(SimpleURLLoaderList::iterator iter,
                          std::unique_ptr<std::string> response_body);
+  void OnGatewayRaceComplete(
+      std::list<std::unique_ptr<IpfsGatewayRace>>::iterator iter,
+      RaceGatewaysCallback callback,
+      base::TimeTicks start_time,
+      const GURL& gateway);
   std::string GetStorageSize();
   // The remote to the ipfs service running on an utility process. The browser
   // will not launch a new ipfs service process if this remote is already
@@ -215,6 +226,7 @@ class IpfsService : public KeyedService,
   PrefService* prefs_ = nullptr;
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   SimpleURLLoaderList url_loaders_;
+  std::list<std::unique_ptr<IpfsGatewayRace>> gateway_races_;
   BlobContextGetterFactoryPtr blob_context_getter_factory_;
 
   base::queue<BoolCallback> pending_launch_callbacks_;
@@ -5,6 +5,7 @@
 
 #include "brave/components/ipfs/ipfs_utils.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -17,6 +18,7 @@
 #include "brave/components/ipfs/ipfs_ports.h"
 #include "brave/components/ipfs/keys/ipns_keys_manager.h"
 #include "brave/components/ipfs/pref_names.h"
+#include "brave/third_party/bitcoin-core/src/src/base58.h"
 #include "components/base32/base32.h"
 #include "components/prefs/pref_service.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
@@ -71,6 +73,13 @@ const char kCIDv0Prefix[] = "Qm";
 const int64_t kIpfsNSCodec = 0xE3;
 const int64_t kIpnsNSCodec = 0xE5;
 
+// CIDv0 is a base58btc sha2-256 multihash, which is 34 bytes long.
+const size_t kCIDv0Length = 46;
+const uint8_t kSha256Multihash[] = {0x12, 0x20};
+const size_t kSha256MultihashLength = 34;
+// CIDv1 version and dag-pb codec, which CIDv0 implies.
+const uint8_t kCIDv1DagPbPrefix[] = {0x01, 0x70};
+
 }  // namespace
 
 namespace ipfs {
@@ -389,6 +398,26 @@ GURL ContentHashToCIDv1URL(const std::string& contenthash) {
   return GURL(scheme + "://" + cidv1);
 }
 
+std::string CIDv0ToCIDv1(const std::string& cid) {
+  if (cid.size() != kCIDv0Length || !base::StartsWith(cid, kCIDv0Prefix))
+    return std::string();
+  std::vector<unsigned char> multihash;
+  if (!DecodeBase58(cid, multihash, kSha256MultihashLength) ||
+      multihash.size() != kSha256MultihashLength ||
+      !std::equal(std::begin(kSha256Multihash), std::end(kSha256Multihash),
+                  multihash.begin())) {
+    return std::string();
+  }
+  const std::string cidv1 =
+      std::string(reinterpret_cast<const char*>(kCIDv1DagPbPrefix),
+                  sizeof(kCIDv1DagPbPrefix)) +
+      std::string(multihash.begin(), multihash.end());
+  std::string trimmed;
+  base::TrimString(base32::Base32Encode(cidv1), "=", &trimmed);
+  // Lower case base32 multibase prefix.
+  return "b" + base::ToLowerASCII(trimmed);
+}
+
 bool IsValidCIDOrDomain(const std::string& value) {
   if (ipfs::IsValidCID(value))
     return true;
@@ -59,6 +59,9 @@ bool ParsePeerConnectionString(const std::string& value,
                                std::string* id,
                                std::string* address);
 GURL ContentHashToCIDv1URL(const std::string& contenthash);
+// Returns the base32 CIDv1 that subdomain gateways use for a CIDv0, or an
+// empty string if |cid| isn't a CIDv0.
+std::string CIDv0ToCIDv1(const std::string& cid);
 bool IsAPIGateway(const GURL& url, version_info::Channel channel);
 bool IsIpfsResolveMethodDisabled(PrefService* prefs);
 std::string GetRegistryDomainFromIPNS(const GURL& url);
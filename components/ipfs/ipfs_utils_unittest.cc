@@ -650,6 +650,27 @@ TEST_F(IpfsUtilsUnitTest, ContentHashToIpfsTest) {
   EXPECT_EQ(ipfs_url.spec(), "");
 }
 
+TEST_F(IpfsUtilsUnitTest, CIDv0ToCIDv1Test) {
+  EXPECT_EQ(
+      ipfs::CIDv0ToCIDv1("QmbWqxBEKC3P8tqsKc98xmWNzrzDtRLMiMPL8wBuTGsMnR"),
+      "bafybeigdyrzt5sfp7udm7hu76uh7y26nf3efuylqabf3oclgtqy55fbzdi");
+  EXPECT_EQ(
+      ipfs::CIDv0ToCIDv1("QmfM2r8seH2GiRaC4esTjeraXEachRt8ZsSeGaWTPLyMoG"),
+      "bafybeih4v623g54vbdrm5iw7caen2yqzgqeemwvz5qspvqt56wurdist7m");
+  EXPECT_EQ(ipfs::CIDv0ToCIDv1(""), "");
+  // Already a CIDv1.
+  EXPECT_EQ(ipfs::CIDv0ToCIDv1(
+                "bafybeigdyrzt5sfp7udm7hu76uh7y26nf3efuylqabf3oclgtqy55fbzdi"),
+            "");
+  // Wrong length.
+  EXPECT_EQ(ipfs::CIDv0ToCIDv1("QmbWqxBEKC3P8tqsKc98xmWNzrzDtRLMiMPL8wBuTGsMn"),
+            "");
+  // '0' isn't in the base58btc alphabet.
+  EXPECT_EQ(
+      ipfs::CIDv0ToCIDv1("QmbWqxBEKC3P8tqsKc98xmWNzrzDtRLMiMPL8wBuTGsMn0"),
+      "");
+}
+
 TEST_F(IpfsUtilsUnitTest, IsAPIGatewayTest) {
   auto channel = version_info::Channel::UNKNOWN;
   GURL api_server = ipfs::GetAPIServer(channel);
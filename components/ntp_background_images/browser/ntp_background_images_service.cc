@@ -471,6 +471,8 @@ void NTPBackgroundImagesService::OnGetComponentJsonData(
     const std::string& json_string) {
   bi_images_data_.reset(
       new NTPBackgroundImagesData(json_string, bi_installed_dir_));
+  // Cached images may belong to the previous component version.
+  images_file_cache_.Clear();
 
   for (auto& observer : observer_list_) {
     observer.OnUpdated(bi_images_data_.get());
@@ -518,6 +520,7 @@ void NTPBackgroundImagesService::OnGetSponsoredComponentJsonData(
     si_images_data_.reset(
         new NTPSponsoredImagesData(json_string, si_installed_dir_));
   }
+  images_file_cache_.Clear();
 
   if (is_super_referral && !sr_images_data_->IsValid()) {
     DVLOG(2) << __func__ << ": NTP SR campaign ends.";
@@ -16,6 +16,7 @@
 #include "base/observer_list.h"
 #include "base/timer/timer.h"
 #include "base/values.h"
+#include "brave/components/ntp_background_images/browser/ntp_images_file_cache.h"
 #include "components/prefs/pref_change_registrar.h"
 
 namespace component_updater {
@@ -72,6 +73,9 @@ class NTPBackgroundImagesService {
   std::vector<std::string> GetTopSitesFaviconList() const;
   void CheckNTPSIComponentUpdateIfNeeded();
 
+  // Shared by the background and sponsored images sources of all profiles.
+  NTPImagesFileCache* images_file_cache() { return &images_file_cache_; }
+
  private:
   friend class TestNTPBackgroundImagesService;
   friend class NTPBackgroundImagesServiceTest;
@@ -172,6 +176,7 @@ class NTPBackgroundImagesService {
   // not show SI images until user chooses Brave default images. So, we should
   // know the exact timing whether SR assets is ready to use or not.
   base::Value initial_sr_component_info_;
+  NTPImagesFileCache images_file_cache_;
   base::WeakPtrFactory<NTPBackgroundImagesService> weak_factory_;
 };
 
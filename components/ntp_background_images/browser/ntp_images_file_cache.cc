@@ -0,0 +1,137 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/ntp_images_file_cache.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/location.h"
+#include "base/task/thread_pool.h"
+
+namespace ntp_background_images {
+
+namespace {
+
+// Enough for the current background image and sponsored image, their logos
+// and the prefetched next wallpaper.
+constexpr size_t kMaxCachedImages = 6;
+constexpr size_t kMaxCachedBytes = 24 * 1024 * 1024;
+
+absl::optional<std::string> ReadFileToString(const base::FilePath& path) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return absl::optional<std::string>();
+  return contents;
+}
+
+}  // namespace
+
+NTPImagesFileCache::NTPImagesFileCache()
+    : cache_(kMaxCachedImages), max_cached_bytes_(kMaxCachedBytes) {
+  memory_pressure_listener_ = std::make_unique<base::MemoryPressureListener>(
+      FROM_HERE, base::BindRepeating(&NTPImagesFileCache::OnMemoryPressure,
+                                     base::Unretained(this)));
+}
+
+NTPImagesFileCache::~NTPImagesFileCache() = default;
+
+void NTPImagesFileCache::GetImage(const base::FilePath& image_file,
+                                  GetImageCallback callback) {
+  auto cached = cache_.Get(image_file);
+  if (cached != cache_.end()) {
+    std::move(callback).Run(cached->second);
+    return;
+  }
+
+  const bool is_reading = pending_reads_.count(image_file);
+  pending_reads_[image_file].push_back(std::move(callback));
+  if (!is_reading)
+    ReadImageFile(image_file);
+}
+
+void NTPImagesFileCache::Prefetch(const base::FilePath& image_file) {
+  if (image_file.empty() || cache_.Peek(image_file) != cache_.end() ||
+      pending_reads_.count(image_file)) {
+    return;
+  }
+
+  pending_reads_[image_file];
+  ReadImageFile(image_file);
+}
+
+void NTPImagesFileCache::Clear() {
+  cache_.Clear();
+  cached_bytes_ = 0;
+  cache_generation_++;
+}
+
+void NTPImagesFileCache::ReadImageFile(const base::FilePath& image_file) {
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&ReadFileToString, image_file),
+      base::BindOnce(&NTPImagesFileCache::OnGotImageFile,
+                     weak_factory_.GetWeakPtr(), image_file,
+                     cache_generation_));
+}
+
+void NTPImagesFileCache::OnGotImageFile(const base::FilePath& image_file,
+                                        int cache_generation,
+                                        absl::optional<std::string> input) {
+  scoped_refptr<base::RefCountedMemory> bytes;
+  if (input) {
+    bytes = base::RefCountedString::TakeString(&input.value());
+    if (cache_generation == cache_generation_)
+      Put(image_file, bytes);
+  }
+
+  auto pending = pending_reads_.find(image_file);
+  if (pending == pending_reads_.end())
+    return;
+  std::vector<GetImageCallback> callbacks = std::move(pending->second);
+  pending_reads_.erase(pending);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(bytes);
+}
+
+void NTPImagesFileCache::Put(const base::FilePath& image_file,
+                             scoped_refptr<base::RefCountedMemory> bytes) {
+  // Don't cache an image that would evict everything else.
+  if (bytes->size() > max_cached_bytes_ / 2)
+    return;
+
+  auto existing = cache_.Peek(image_file);
+  if (existing != cache_.end()) {
+    cached_bytes_ -= existing->second->size();
+    cache_.Erase(existing);
+  }
+
+  while (!cache_.empty() &&
+         (cached_bytes_ + bytes->size() > max_cached_bytes_ ||
+          cache_.size() >= cache_.max_size())) {
+    EraseOldest();
+  }
+
+  cached_bytes_ += bytes->size();
+  cache_.Put(image_file, std::move(bytes));
+}
+
+void NTPImagesFileCache::EraseOldest() {
+  auto oldest = cache_.rbegin();
+  cached_bytes_ -= oldest->second->size();
+  cache_.Erase(oldest);
+}
+
+void NTPImagesFileCache::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  if (memory_pressure_level ==
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE) {
+    return;
+  }
+  Clear();
+}
+
+}  // namespace ntp_background_images
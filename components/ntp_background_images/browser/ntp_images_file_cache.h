@@ -0,0 +1,82 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_IMAGES_FILE_CACHE_H_
+#define BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_IMAGES_FILE_CACHE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/gtest_prod_util.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/weak_ptr.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace ntp_background_images {
+
+// Keeps the encoded bytes of recently served NTP images in memory. Only a few
+// wallpapers rotate across new tabs, so most requests are served without
+// touching the disk. Concurrent reads of the same file are coalesced and the
+// cache is dropped under memory pressure.
+class NTPImagesFileCache {
+ public:
+  using GetImageCallback =
+      base::OnceCallback<void(scoped_refptr<base::RefCountedMemory>)>;
+
+  NTPImagesFileCache();
+  ~NTPImagesFileCache();
+
+  NTPImagesFileCache(const NTPImagesFileCache&) = delete;
+  NTPImagesFileCache& operator=(const NTPImagesFileCache&) = delete;
+
+  // Runs |callback| with the contents of |image_file|, or with null if it
+  // can't be read. Cached contents are returned synchronously.
+  void GetImage(const base::FilePath& image_file, GetImageCallback callback);
+  // Reads |image_file| into the cache ahead of the next request for it.
+  void Prefetch(const base::FilePath& image_file);
+  // Drops cached images. Reads in progress still answer their callbacks, but
+  // their contents are not cached.
+  void Clear();
+
+  size_t cached_bytes() const { return cached_bytes_; }
+
+ private:
+  FRIEND_TEST_ALL_PREFIXES(NTPImagesFileCacheTest, EvictsOverByteLimit);
+
+  using Cache =
+      base::MRUCache<base::FilePath, scoped_refptr<base::RefCountedMemory>>;
+
+  void ReadImageFile(const base::FilePath& image_file);
+  void OnGotImageFile(const base::FilePath& image_file,
+                      int cache_generation,
+                      absl::optional<std::string> input);
+  void Put(const base::FilePath& image_file,
+           scoped_refptr<base::RefCountedMemory> bytes);
+  void EraseOldest();
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
+  Cache cache_;
+  size_t cached_bytes_ = 0;
+  size_t max_cached_bytes_;
+  // Incremented by Clear() so that reads started before then don't put their
+  // contents back in the cache.
+  int cache_generation_ = 0;
+  // Callbacks waiting for an in-flight read, keyed by file. A prefetch adds
+  // an entry with no callbacks.
+  std::map<base::FilePath, std::vector<GetImageCallback>> pending_reads_;
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+  base::WeakPtrFactory<NTPImagesFileCache> weak_factory_{this};
+};
+
+}  // namespace ntp_background_images
+
+#endif  // BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_IMAGES_FILE_CACHE_H_
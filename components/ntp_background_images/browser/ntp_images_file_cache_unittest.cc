@@ -0,0 +1,146 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/ntp_images_file_cache.h"
+
+#include <string>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/run_loop.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ntp_background_images {
+
+class NTPImagesFileCacheTest : public testing::Test {
+ public:
+  NTPImagesFileCacheTest() = default;
+
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  base::FilePath WriteImage(const std::string& name,
+                            const std::string& contents) {
+    base::FilePath path = temp_dir_.GetPath().AppendASCII(name);
+    EXPECT_TRUE(base::WriteFile(path, contents));
+    return path;
+  }
+
+  std::string GetImage(const base::FilePath& path) {
+    std::string result;
+    base::RunLoop run_loop;
+    cache_.GetImage(path, base::BindOnce(
+                              [](std::string* result, base::OnceClosure quit,
+                                 scoped_refptr<base::RefCountedMemory> bytes) {
+                                if (bytes)
+                                  result->assign(bytes->front_as<char>(),
+                                                 bytes->size());
+                                std::move(quit).Run();
+                              },
+                              &result, run_loop.QuitClosure()));
+    run_loop.Run();
+    return result;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  NTPImagesFileCache cache_;
+};
+
+TEST_F(NTPImagesFileCacheTest, ServesCachedImageWithoutDisk) {
+  const base::FilePath path = WriteImage("wallpaper-0.jpg", "image data");
+  EXPECT_EQ("image data", GetImage(path));
+  EXPECT_EQ(10u, cache_.cached_bytes());
+
+  ASSERT_TRUE(base::DeleteFile(path));
+  EXPECT_EQ("image data", GetImage(path));
+}
+
+TEST_F(NTPImagesFileCacheTest, MissingFileRunsCallbackWithNull) {
+  EXPECT_EQ("", GetImage(temp_dir_.GetPath().AppendASCII("missing.jpg")));
+  EXPECT_EQ(0u, cache_.cached_bytes());
+}
+
+TEST_F(NTPImagesFileCacheTest, CoalescesConcurrentReads) {
+  const base::FilePath path = WriteImage("wallpaper-0.jpg", "image data");
+  int called = 0;
+  base::RunLoop run_loop;
+  auto callback = base::BindRepeating(
+      [](int* called, base::RepeatingClosure quit,
+         scoped_refptr<base::RefCountedMemory> bytes) {
+        EXPECT_TRUE(bytes);
+        if (++(*called) == 2)
+          quit.Run();
+      },
+      &called, run_loop.QuitClosure());
+  cache_.GetImage(path, callback);
+  cache_.GetImage(path, callback);
+  run_loop.Run();
+  EXPECT_EQ(2, called);
+  EXPECT_EQ(10u, cache_.cached_bytes());
+}
+
+TEST_F(NTPImagesFileCacheTest, PrefetchFillsCache) {
+  const base::FilePath path = WriteImage("wallpaper-1.jpg", "next");
+  cache_.Prefetch(path);
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(4u, cache_.cached_bytes());
+
+  ASSERT_TRUE(base::DeleteFile(path));
+  EXPECT_EQ("next", GetImage(path));
+}
+
+TEST_F(NTPImagesFileCacheTest, EvictsOverByteLimit) {
+  cache_.max_cached_bytes_ = 10;
+  const base::FilePath first = WriteImage("wallpaper-0.jpg", "aaaa");
+  const base::FilePath second = WriteImage("wallpaper-1.jpg", "bbbb");
+  const base::FilePath third = WriteImage("wallpaper-2.jpg", "cccc");
+  GetImage(first);
+  GetImage(second);
+  GetImage(third);
+  EXPECT_EQ(8u, cache_.cached_bytes());
+
+  // The least recently used image was evicted and is read from disk again.
+  ASSERT_TRUE(base::DeleteFile(first));
+  EXPECT_EQ("", GetImage(first));
+  ASSERT_TRUE(base::DeleteFile(third));
+  EXPECT_EQ("cccc", GetImage(third));
+}
+
+TEST_F(NTPImagesFileCacheTest, ReadsInFlightDontRefillClearedCache) {
+  const base::FilePath path = WriteImage("wallpaper-0.jpg", "image data");
+  std::string result;
+  cache_.GetImage(path, base::BindOnce(
+                            [](std::string* result,
+                               scoped_refptr<base::RefCountedMemory> bytes) {
+                              ASSERT_TRUE(bytes);
+                              result->assign(bytes->front_as<char>(),
+                                             bytes->size());
+                            },
+                            &result));
+  cache_.Prefetch(WriteImage("wallpaper-1.jpg", "next"));
+  cache_.Clear();
+  task_environment_.RunUntilIdle();
+
+  // The waiting request is still answered.
+  EXPECT_EQ("image data", result);
+  EXPECT_EQ(0u, cache_.cached_bytes());
+}
+
+TEST_F(NTPImagesFileCacheTest, ClearsOnMemoryPressure) {
+  const base::FilePath path = WriteImage("wallpaper-0.jpg", "image data");
+  GetImage(path);
+  EXPECT_EQ(10u, cache_.cached_bytes());
+
+  base::MemoryPressureListener::SimulatePressureNotification(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(0u, cache_.cached_bytes());
+}
+
+}  // namespace ntp_background_images
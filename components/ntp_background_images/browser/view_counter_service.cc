@@ -257,6 +257,27 @@ void ViewCounterService::RegisterPageView() {
   // This will be no-op when component is not ready.
   service_->CheckNTPSIComponentUpdateIfNeeded();
   model_.RegisterPageView();
+  PrefetchCurrentWallpaper();
+}
+
+void ViewCounterService::PrefetchCurrentWallpaper() const {
+#if !defined(OS_ANDROID)
+  base::FilePath image_file;
+  if (ShouldShowBrandedWallpaper()) {
+    auto* data = GetCurrentBrandedWallpaperData();
+    const size_t index = model_.current_branded_wallpaper_image_index();
+    if (data && index < data->backgrounds.size())
+      image_file = data->backgrounds[index].image_file;
+  } else if (IsBackgroundWallpaperActive()) {
+    auto* data = GetCurrentWallpaperData();
+    const size_t index = model_.current_wallpaper_image_index();
+    if (index < data->backgrounds.size())
+      image_file = data->backgrounds[index].image_file;
+  }
+
+  if (!image_file.empty())
+    service_->images_file_cache()->Prefetch(image_file);
+#endif
 }
 
 void ViewCounterService::BrandedWallpaperLogoClicked(
@@ -133,6 +133,8 @@ class ViewCounterService : public KeyedService,
   bool ShouldShowBrandedWallpaper() const;
 
   void ResetModel();
+  // Warms the images cache with the wallpaper the next new tab will show.
+  void PrefetchCurrentWallpaper() const;
 
   void UpdateP3AValues() const;
 
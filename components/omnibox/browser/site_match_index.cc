@@ -0,0 +1,91 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/omnibox/browser/site_match_index.h"
+
+#include <algorithm>
+
+#include "base/check_op.h"
+#include "base/strings/string_piece.h"
+
+SiteMatchIndex::SiteMatchIndex(const std::vector<std::string>& strings,
+                               Mode mode)
+    : strings_(strings) {
+  for (size_t i = 0; i < strings_.size(); ++i) {
+    const size_t suffix_count =
+        mode == Mode::kSubstring ? strings_[i].length() : 1;
+    for (size_t offset = 0; offset < suffix_count; ++offset) {
+      suffixes_.push_back(
+          {static_cast<uint32_t>(i), static_cast<uint32_t>(offset)});
+    }
+  }
+
+  // Ties are broken by list order so equal suffixes stay deterministic.
+  std::sort(suffixes_.begin(), suffixes_.end(),
+            [this](const Suffix& a, const Suffix& b) {
+              const int result =
+                  base::StringPiece(strings_[a.index])
+                      .substr(a.offset)
+                      .compare(base::StringPiece(strings_[b.index])
+                                   .substr(b.offset));
+              if (result != 0)
+                return result < 0;
+              return a.index < b.index;
+            });
+}
+
+SiteMatchIndex::~SiteMatchIndex() = default;
+
+SiteMatchIndex::Range SiteMatchIndex::GetFullRange() const {
+  return {0, suffixes_.size()};
+}
+
+SiteMatchIndex::Range SiteMatchIndex::Search(const std::string& query,
+                                             const Range& within) const {
+  DCHECK_LE(within.begin, within.end);
+  DCHECK_LE(within.end, suffixes_.size());
+
+  const auto suffix_prefix = [this, &query](const Suffix& suffix) {
+    return base::StringPiece(strings_[suffix.index])
+        .substr(suffix.offset, query.length());
+  };
+
+  const auto first = suffixes_.begin() + within.begin;
+  const auto last = suffixes_.begin() + within.end;
+  const auto lower = std::lower_bound(
+      first, last, query, [&](const Suffix& suffix, const std::string& value) {
+        return suffix_prefix(suffix) < value;
+      });
+  const auto upper = std::upper_bound(
+      lower, last, query, [&](const std::string& value, const Suffix& suffix) {
+        return value < suffix_prefix(suffix);
+      });
+  return {static_cast<size_t>(lower - suffixes_.begin()),
+          static_cast<size_t>(upper - suffixes_.begin())};
+}
+
+std::vector<SiteMatchIndex::Match> SiteMatchIndex::GetMatches(
+    const Range& range,
+    size_t max_matches) const {
+  std::vector<Match> matches;
+  matches.reserve(range.end - range.begin);
+  for (size_t i = range.begin; i < range.end; ++i)
+    matches.push_back({suffixes_[i].index, suffixes_[i].offset});
+
+  // A string may contain the query more than once; keep its first occurrence.
+  std::sort(matches.begin(), matches.end(),
+            [](const Match& a, const Match& b) {
+              return a.index != b.index ? a.index < b.index
+                                        : a.position < b.position;
+            });
+  matches.erase(std::unique(matches.begin(), matches.end(),
+                            [](const Match& a, const Match& b) {
+                              return a.index == b.index;
+                            }),
+                matches.end());
+  if (matches.size() > max_matches)
+    matches.resize(max_matches);
+  return matches;
+}
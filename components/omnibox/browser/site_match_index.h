@@ -0,0 +1,67 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_OMNIBOX_BROWSER_SITE_MATCH_INDEX_H_
+#define BRAVE_COMPONENTS_OMNIBOX_BROWSER_SITE_MATCH_INDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+// Finds which strings of a fixed list contain a query, or start with it, by
+// binary search over a sorted array of their suffixes. Typing usually extends
+// the previous input, so a search can be narrowed to the range found for a
+// prefix of the query instead of the whole array.
+class SiteMatchIndex {
+ public:
+  enum class Mode {
+    // Matches the query anywhere in a string.
+    kSubstring,
+    // Matches the query only at the start of a string.
+    kPrefix,
+  };
+
+  // Range of the suffix array whose suffixes start with a query.
+  struct Range {
+    size_t begin = 0;
+    size_t end = 0;
+  };
+
+  struct Match {
+    // Position of the matching string in the list given to the constructor.
+    size_t index;
+    // Offset of the first occurrence of the query in that string.
+    size_t position;
+  };
+
+  SiteMatchIndex(const std::vector<std::string>& strings, Mode mode);
+  ~SiteMatchIndex();
+
+  SiteMatchIndex(const SiteMatchIndex&) = delete;
+  SiteMatchIndex& operator=(const SiteMatchIndex&) = delete;
+
+  Range GetFullRange() const;
+
+  // Returns the range of suffixes starting with |query|. |within| must be
+  // the range of a prefix of |query|.
+  Range Search(const std::string& query, const Range& within) const;
+
+  // Returns up to |max_matches| matches for the query whose range is
+  // |range|, in list order.
+  std::vector<Match> GetMatches(const Range& range, size_t max_matches) const;
+
+ private:
+  struct Suffix {
+    uint32_t index;
+    uint32_t offset;
+  };
+
+  const std::vector<std::string> strings_;
+  std::vector<Suffix> suffixes_;
+};
+
+#endif  // BRAVE_COMPONENTS_OMNIBOX_BROWSER_SITE_MATCH_INDEX_H_
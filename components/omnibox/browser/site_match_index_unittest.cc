@@ -0,0 +1,86 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/omnibox/browser/site_match_index.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+std::vector<std::string> GetSites() {
+  return {"google.com", "gmail.com", "mail.google.com", "yahoo.com",
+          "brave.com"};
+}
+
+std::vector<size_t> GetIndices(const std::vector<SiteMatchIndex::Match>& m) {
+  std::vector<size_t> indices;
+  for (const auto& match : m)
+    indices.push_back(match.index);
+  return indices;
+}
+
+}  // namespace
+
+TEST(SiteMatchIndexTest, SubstringMatches) {
+  SiteMatchIndex index(GetSites(), SiteMatchIndex::Mode::kSubstring);
+
+  // Matches are in list order with the first occurrence of the query.
+  const auto matches =
+      index.GetMatches(index.Search("goo", index.GetFullRange()), 10);
+  ASSERT_EQ(2u, matches.size());
+  EXPECT_EQ(0u, matches[0].index);
+  EXPECT_EQ(0u, matches[0].position);
+  EXPECT_EQ(2u, matches[1].index);
+  EXPECT_EQ(5u, matches[1].position);
+
+  // A string containing the query twice is matched once.
+  EXPECT_EQ(std::vector<size_t>({0, 2}),
+            GetIndices(index.GetMatches(
+                index.Search("o", index.GetFullRange()), 2)));
+  EXPECT_EQ(std::vector<size_t>({0, 1, 2, 3, 4}),
+            GetIndices(index.GetMatches(
+                index.Search(".com", index.GetFullRange()), 10)));
+
+  EXPECT_TRUE(index
+                  .GetMatches(index.Search("bing", index.GetFullRange()), 10)
+                  .empty());
+}
+
+TEST(SiteMatchIndexTest, PrefixMatches) {
+  SiteMatchIndex index(GetSites(), SiteMatchIndex::Mode::kPrefix);
+
+  EXPECT_EQ(std::vector<size_t>({1}),
+            GetIndices(index.GetMatches(
+                index.Search("gm", index.GetFullRange()), 10)));
+  EXPECT_EQ(std::vector<size_t>({0, 1}),
+            GetIndices(index.GetMatches(
+                index.Search("g", index.GetFullRange()), 10)));
+  EXPECT_EQ(std::vector<size_t>({2}),
+            GetIndices(index.GetMatches(
+                index.Search("mail.g", index.GetFullRange()), 10)));
+  EXPECT_TRUE(index
+                  .GetMatches(index.Search("com", index.GetFullRange()), 10)
+                  .empty());
+}
+
+TEST(SiteMatchIndexTest, NarrowedSearch) {
+  SiteMatchIndex index(GetSites(), SiteMatchIndex::Mode::kSubstring);
+
+  // Searching within the range of a prefix gives the same result as
+  // searching the whole index.
+  const std::string input = "mail.google";
+  SiteMatchIndex::Range range = index.GetFullRange();
+  for (size_t length = 1; length <= input.length(); ++length) {
+    const std::string query = input.substr(0, length);
+    range = index.Search(query, range);
+    const auto full_range = index.Search(query, index.GetFullRange());
+    EXPECT_EQ(full_range.begin, range.begin);
+    EXPECT_EQ(full_range.end, range.end);
+  }
+  EXPECT_EQ(std::vector<size_t>({2}), GetIndices(index.GetMatches(range, 10)));
+}
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/no_destructor.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
@@ -41,32 +42,48 @@ void SuggestedSitesProvider::Start(const AutocompleteInput& input,
 
   const std::string input_text =
       base::ToLowerASCII(base::UTF16ToUTF8(input.text()));
-  auto check_add_match =
-      [&](const SuggestedSitesMatch& match) {
+
+  // The index only matches at the start of the match string. We want only
+  // people that really want these suggestions. Example don't suggest bitcoin
+  // and litecoin for just a coin search.
+  const SiteMatchIndex& index = GetSuggestedSitesIndex();
+  const SiteMatchIndex::Range search_range =
+      !last_input_text_.empty() &&
+              base::StartsWith(input_text, last_input_text_)
+          ? last_input_range_
+          : index.GetFullRange();
+  last_input_range_ = index.Search(input_text, search_range);
+  last_input_text_ = input_text;
+
+  const auto& suggested_sites = GetSuggestedSites();
+  for (const auto& site_match :
+       index.GetMatches(last_input_range_, suggested_sites.size())) {
+    const SuggestedSitesMatch& match = suggested_sites[site_match.index];
     // Don't bother matching until 4 chars, or less if it's an exact match
     if (input_text.length() < 4 &&
         match.match_string_.length() != input_text.length()) {
-      return;
+      continue;
     }
-    size_t foundPos = match.match_string_.find(input_text);
-    // We'd normally check for npos here but we want only people that
-    // really want these suggestions. Example don't suggest bitcoin and
-    // litecoin for just a coin search.
-    if (foundPos == 0) {
-      ACMatchClassifications styles =
-          StylesForSingleMatch(input_text,
-              base::UTF16ToASCII(match.display_));
-      AddMatch(match, styles);
-    }
-  };
-
-  const auto& suggested_sites = GetSuggestedSites();
-  std::for_each(suggested_sites.begin(), suggested_sites.end(),
-      check_add_match);
+    ACMatchClassifications styles =
+        StylesForSingleMatch(input_text, base::UTF16ToASCII(match.display_));
+    AddMatch(match, styles);
+  }
 }
 
 SuggestedSitesProvider::~SuggestedSitesProvider() {}
 
+const SiteMatchIndex& SuggestedSitesProvider::GetSuggestedSitesIndex() {
+  static base::NoDestructor<SiteMatchIndex> index(
+      [this] {
+        std::vector<std::string> match_strings;
+        for (const auto& match : GetSuggestedSites())
+          match_strings.push_back(match.match_string_);
+        return match_strings;
+      }(),
+      SiteMatchIndex::Mode::kPrefix);
+  return *index;
+}
+
 // static
 ACMatchClassifications SuggestedSitesProvider::StylesForSingleMatch(
     const std::string &input_text,
@@ -12,6 +12,7 @@
 #include "base/compiler_specific.h"
 #include "base/macros.h"
 #include "brave/components/omnibox/browser/suggested_sites_match.h"
+#include "brave/components/omnibox/browser/site_match_index.h"
 #include "components/omnibox/browser/autocomplete_match.h"
 #include "components/omnibox/browser/autocomplete_provider.h"
 
@@ -31,6 +32,7 @@ class SuggestedSitesProvider : public AutocompleteProvider {
   static const int kRelevance;
 
   const std::vector<SuggestedSitesMatch>& GetSuggestedSites();
+  const SiteMatchIndex& GetSuggestedSitesIndex();
   void AddMatch(const SuggestedSitesMatch& match,
                 const ACMatchClassifications& styles);
 
@@ -39,6 +41,9 @@ class SuggestedSitesProvider : public AutocompleteProvider {
       const std::string &site);
 
   AutocompleteProviderClient* client_;
+  // The last input and its range in the index, to narrow the next search.
+  std::string last_input_text_;
+  SiteMatchIndex::Range last_input_range_;
   DISALLOW_COPY_AND_ASSIGN(SuggestedSitesProvider);
 };
 
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <string>
 
+#include "base/no_destructor.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
@@ -42,16 +43,23 @@ void TopSitesProvider::Start(const AutocompleteInput& input,
   const std::string input_text =
       base::ToLowerASCII(base::UTF16ToUTF8(input.text()));
 
-  for (std::vector<std::string>::const_iterator i = top_sites_.begin();
-       (i != top_sites_.end()) && (matches_.size() < provider_max_matches());
-       ++i) {
-    const std::string &current_site = *i;
-    size_t foundPos = current_site.find(input_text);
-    if (std::string::npos != foundPos) {
-      ACMatchClassifications styles =
-          StylesForSingleMatch(input_text, current_site, foundPos);
-      AddMatch(base::ASCIIToUTF16(current_site), styles);
-    }
+  const SiteMatchIndex& index = GetTopSitesIndex();
+  // Sites matching a longer input are a subset of those matching the input
+  // it extends.
+  const SiteMatchIndex::Range search_range =
+      !last_input_text_.empty() &&
+              base::StartsWith(input_text, last_input_text_)
+          ? last_input_range_
+          : index.GetFullRange();
+  last_input_range_ = index.Search(input_text, search_range);
+  last_input_text_ = input_text;
+
+  for (const auto& site_match :
+       index.GetMatches(last_input_range_, provider_max_matches())) {
+    const std::string& current_site = top_sites_[site_match.index];
+    ACMatchClassifications styles =
+        StylesForSingleMatch(input_text, current_site, site_match.position);
+    AddMatch(base::ASCIIToUTF16(current_site), styles);
   }
 
   for (size_t i = 0; i < matches_.size(); ++i) {
@@ -70,6 +78,13 @@ void TopSitesProvider::Start(const AutocompleteInput& input,
 
 TopSitesProvider::~TopSitesProvider() {}
 
+// static
+const SiteMatchIndex& TopSitesProvider::GetTopSitesIndex() {
+  static base::NoDestructor<SiteMatchIndex> index(
+      top_sites_, SiteMatchIndex::Mode::kSubstring);
+  return *index;
+}
+
 // static
 ACMatchClassifications TopSitesProvider::StylesForSingleMatch(
     const std::string &input_text,
@@ -11,6 +11,7 @@
 
 #include "base/compiler_specific.h"
 #include "base/macros.h"
+#include "brave/components/omnibox/browser/site_match_index.h"
 #include "components/omnibox/browser/autocomplete_match.h"
 #include "components/omnibox/browser/autocomplete_provider.h"
 
@@ -31,6 +32,8 @@ class TopSitesProvider : public AutocompleteProvider {
 
   static std::vector<std::string> top_sites_;
 
+  static const SiteMatchIndex& GetTopSitesIndex();
+
   void AddMatch(const std::u16string& match_string,
                 const ACMatchClassifications& styles);
 
@@ -40,6 +43,9 @@ class TopSitesProvider : public AutocompleteProvider {
       const size_t &foundPos);
 
   AutocompleteProviderClient* client_;
+  // The last input and its range in the index, to narrow the next search.
+  std::string last_input_text_;
+  SiteMatchIndex::Range last_input_range_;
   DISALLOW_COPY_AND_ASSIGN(TopSitesProvider);
 };
 
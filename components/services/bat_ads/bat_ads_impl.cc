@@ -127,6 +127,15 @@ void BatAdsImpl::OnTabClosed(
   ads_->OnTabClosed(tab_id);
 }
 
+void BatAdsImpl::OnBrowsingHistoryDeleted() {
+  ads_->OnBrowsingHistoryDeleted();
+}
+
+void BatAdsImpl::OnBrowsingHistoryUrlsDeleted(
+    const std::vector<std::string>& urls) {
+  ads_->OnBrowsingHistoryUrlsDeleted(urls);
+}
+
 void BatAdsImpl::GetAdNotification(
     const std::string& uuid,
     GetAdNotificationCallback callback) {
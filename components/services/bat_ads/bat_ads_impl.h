@@ -78,6 +78,9 @@ class BatAdsImpl :
       const bool is_incognito) override;
   void OnTabClosed(
       const int32_t tab_id) override;
+  void OnBrowsingHistoryDeleted() override;
+  void OnBrowsingHistoryUrlsDeleted(
+      const std::vector<std::string>& urls) override;
 
   void GetAdNotification(
       const std::string& uuid,
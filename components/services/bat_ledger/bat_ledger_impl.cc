@@ -148,6 +148,10 @@ void BatLedgerImpl::OnBackground(uint32_t tab_id, uint64_t current_time) {
   ledger_->OnBackground(tab_id, current_time);
 }
 
+void BatLedgerImpl::OnBrowsingHistoryDeleted() {
+  ledger_->OnBrowsingHistoryDeleted();
+}
+
 void BatLedgerImpl::OnPostData(const std::string& url,
     const std::string& first_party_url, const std::string& referrer,
     const std::string& post_data, ledger::type::VisitDataPtr visit_data) {
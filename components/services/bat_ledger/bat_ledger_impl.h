@@ -63,6 +63,7 @@ class BatLedgerImpl :
   void OnHide(uint32_t tab_id, uint64_t current_time) override;
   void OnForeground(uint32_t tab_id, uint64_t current_time) override;
   void OnBackground(uint32_t tab_id, uint64_t current_time) override;
+  void OnBrowsingHistoryDeleted() override;
 
   void OnPostData(
       const std::string& url,
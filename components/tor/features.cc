@@ -0,0 +1,19 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/tor/features.h"
+
+#include "base/feature_list.h"
+
+namespace tor {
+namespace features {
+
+// Starts tor in the background when the app menu is opened so that a Tor
+// window opened from it is connected sooner.
+const base::Feature kTorSpeculativeLaunchFeature{
+    "TorSpeculativeLaunch", base::FEATURE_DISABLED_BY_DEFAULT};
+
+}  // namespace features
+}  // namespace tor
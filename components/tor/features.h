@@ -0,0 +1,21 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_TOR_FEATURES_H_
+#define BRAVE_COMPONENTS_TOR_FEATURES_H_
+
+namespace base {
+struct Feature;
+}  // namespace base
+
+namespace tor {
+namespace features {
+
+extern const base::Feature kTorSpeculativeLaunchFeature;
+
+}  // namespace features
+}  // namespace tor
+
+#endif  // BRAVE_COMPONENTS_TOR_FEATURES_H_
@@ -0,0 +1,64 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/tor/tor_consensus_cache.h"
+
+#include <stdio.h>
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/strings/string_util.h"
+
+namespace tor {
+
+namespace {
+
+constexpr char kConsensusFile[] = "cached-microdesc-consensus";
+constexpr char kConsensusHeader[] = "network-status-version 3 microdesc\n";
+constexpr char kValidUntil[] = "\nvalid-until ";
+// The timestamps are all in the preamble, well within the first few lines.
+constexpr size_t kMaxPreambleSize = 4096;
+
+bool ParseValidUntil(const std::string& preamble, base::Time* valid_until) {
+  const size_t start = preamble.find(kValidUntil);
+  if (start == std::string::npos)
+    return false;
+  base::Time::Exploded exploded = {};
+  if (sscanf(preamble.c_str() + start + strlen(kValidUntil),
+             "%4d-%2d-%2d %2d:%2d:%2d", &exploded.year, &exploded.month,
+             &exploded.day_of_month, &exploded.hour, &exploded.minute,
+             &exploded.second) != 6) {
+    return false;
+  }
+  return base::Time::FromUTCExploded(exploded, valid_until);
+}
+
+}  // namespace
+
+ConsensusCacheState CheckCachedConsensus(const base::FilePath& tor_data_path,
+                                         base::Time now) {
+  const base::FilePath consensus = tor_data_path.AppendASCII(kConsensusFile);
+  if (!base::PathExists(consensus))
+    return ConsensusCacheState::kMissing;
+
+  // Only the preamble is read, so this fails for every real consensus; the
+  // contents are still filled in up to the limit.
+  std::string preamble;
+  base::ReadFileToStringWithMaxSize(consensus, &preamble, kMaxPreambleSize);
+  base::Time valid_until;
+  if (!base::StartsWith(preamble, kConsensusHeader) ||
+      !ParseValidUntil(preamble, &valid_until)) {
+    base::DeleteFile(consensus);
+    return ConsensusCacheState::kMalformed;
+  }
+
+  return now > valid_until + kConsensusReasonablyLive
+             ? ConsensusCacheState::kExpired
+             : ConsensusCacheState::kUsable;
+}
+
+}  // namespace tor
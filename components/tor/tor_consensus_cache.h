@@ -0,0 +1,39 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_TOR_TOR_CONSENSUS_CACHE_H_
+#define BRAVE_COMPONENTS_TOR_TOR_CONSENSUS_CACHE_H_
+
+#include "base/time/time.h"
+
+namespace base {
+class FilePath;
+}  // namespace base
+
+namespace tor {
+
+// Tor keeps using a consensus for this long after its valid-until time.
+constexpr base::TimeDelta kConsensusReasonablyLive =
+    base::TimeDelta::FromHours(24);
+
+enum class ConsensusCacheState {
+  kMissing,
+  // The cached consensus was truncated or isn't a microdesc consensus and has
+  // been deleted so tor doesn't spend time on it.
+  kMalformed,
+  kExpired,
+  kUsable,
+};
+
+// Checks the microdescriptor consensus that tor cached in |tor_data_path| on
+// a previous run. A usable one lets tor bootstrap without downloading a new
+// consensus and microdescriptors first; tor still verifies its signatures.
+// Blocks, so must be called on a sequence that allows it.
+ConsensusCacheState CheckCachedConsensus(const base::FilePath& tor_data_path,
+                                         base::Time now);
+
+}  // namespace tor
+
+#endif  // BRAVE_COMPONENTS_TOR_TOR_CONSENSUS_CACHE_H_
@@ -0,0 +1,95 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/tor/tor_consensus_cache.h"
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace tor {
+
+namespace {
+
+constexpr char kConsensus[] =
+    "network-status-version 3 microdesc\n"
+    "vote-status consensus\n"
+    "consensus-method 31\n"
+    "valid-after 2021-11-01 12:00:00\n"
+    "fresh-until 2021-11-01 13:00:00\n"
+    "valid-until 2021-11-01 15:00:00\n"
+    "voting-delay 300 300\n";
+
+base::Time GetTime(const char* time) {
+  base::Time result;
+  EXPECT_TRUE(base::Time::FromUTCString(time, &result));
+  return result;
+}
+
+}  // namespace
+
+class TorConsensusCacheTest : public testing::Test {
+ protected:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  base::FilePath GetConsensusPath() const {
+    return temp_dir_.GetPath().AppendASCII("cached-microdesc-consensus");
+  }
+
+  void WriteConsensus(const std::string& consensus) {
+    ASSERT_TRUE(base::WriteFile(GetConsensusPath(), consensus));
+  }
+
+  ConsensusCacheState Check(const char* now) {
+    return CheckCachedConsensus(temp_dir_.GetPath(), GetTime(now));
+  }
+
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(TorConsensusCacheTest, Missing) {
+  EXPECT_EQ(ConsensusCacheState::kMissing, Check("2021-11-01 12:30:00 UTC"));
+}
+
+TEST_F(TorConsensusCacheTest, Usable) {
+  WriteConsensus(kConsensus);
+  EXPECT_EQ(ConsensusCacheState::kUsable, Check("2021-11-01 12:30:00 UTC"));
+  // Tor still bootstraps from a consensus that is a little out of date.
+  EXPECT_EQ(ConsensusCacheState::kUsable, Check("2021-11-02 14:00:00 UTC"));
+  EXPECT_TRUE(base::PathExists(GetConsensusPath()));
+}
+
+TEST_F(TorConsensusCacheTest, LargeConsensus) {
+  WriteConsensus(kConsensus + std::string(1024 * 1024, 'r'));
+  EXPECT_EQ(ConsensusCacheState::kUsable, Check("2021-11-01 12:30:00 UTC"));
+}
+
+TEST_F(TorConsensusCacheTest, Expired) {
+  WriteConsensus(kConsensus);
+  EXPECT_EQ(ConsensusCacheState::kExpired, Check("2021-11-02 16:00:00 UTC"));
+  EXPECT_TRUE(base::PathExists(GetConsensusPath()));
+}
+
+TEST_F(TorConsensusCacheTest, Malformed) {
+  const char* cases[] = {
+      "",
+      "network-status-version 3\nvalid-until 2021-11-01 15:00:00\n",
+      "network-status-version 3 microdesc\nvalid-after 2021-11-01 12:00:00\n",
+      "network-status-version 3 microdesc\nvalid-until 2021-11-01\n",
+      "network-status-version 3 microdesc\nvalid-until 2021-13-45 15:00:00\n",
+  };
+  for (const char* consensus : cases) {
+    SCOPED_TRACE(consensus);
+    WriteConsensus(consensus);
+    EXPECT_EQ(ConsensusCacheState::kMalformed,
+              Check("2021-11-01 12:30:00 UTC"));
+    EXPECT_FALSE(base::PathExists(GetConsensusPath()));
+  }
+}
+
+}  // namespace tor
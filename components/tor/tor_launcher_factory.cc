@@ -10,6 +10,8 @@
 #include "base/bind.h"
 #include "base/bind_post_task.h"
 #include "base/callback_helpers.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/task/thread_pool.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "brave/components/tor/service_sandbox_type.h"
 #include "brave/components/tor/tor_file_watcher.h"
@@ -24,8 +26,19 @@ constexpr char kTorProxyScheme[] = "socks5://";
 // tor::TorControlEvent::STATUS_CLIENT response
 constexpr char kStatusClientBootstrap[] = "BOOTSTRAP";
 constexpr char kStatusClientBootstrapProgress[] = "PROGRESS=";
+constexpr char kStatusClientBootstrapTag[] = "TAG=";
 constexpr char kStatusClientCircuitEstablished[] = "CIRCUIT_ESTABLISHED";
 constexpr char kStatusClientCircuitNotEstablished[] = "CIRCUIT_NOT_ESTABLISHED";
+
+// Returns the value of |key| (e.g. "TAG=") from the space separated arguments
+// in |initial|.
+std::string GetStatusArgument(const std::string& initial, const char* key) {
+  size_t start = initial.find(key);
+  if (start == std::string::npos)
+    return std::string();
+  start += strlen(key);
+  return initial.substr(start, initial.find(' ', start) - start);
+}
 }  // namespace
 
 // static
@@ -91,6 +104,26 @@ void TorLauncherFactory::LaunchTorProcess(const tor::mojom::TorConfig& config) {
     Init();
   }
 
+  CheckCachedConsensusAndLaunch();
+}
+
+void TorLauncherFactory::CheckCachedConsensusAndLaunch() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&tor::CheckCachedConsensus, config_.tor_data_path,
+                     base::Time::Now()),
+      base::BindOnce(&TorLauncherFactory::OnCachedConsensusChecked,
+                     launch_weak_ptr_factory_.GetWeakPtr()));
+}
+
+void TorLauncherFactory::OnCachedConsensusChecked(
+    tor::ConsensusCacheState state) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  VLOG(2) << "Cached consensus state: " << static_cast<int>(state);
+  warm_start_ = state == tor::ConsensusCacheState::kUsable;
   LaunchTorInternal();
 }
 
@@ -98,6 +131,7 @@ void TorLauncherFactory::LaunchTorInternal() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   if (tor_launcher_.is_bound()) {
+    launch_time_ = base::TimeTicks::Now();
     auto config = tor::mojom::TorConfig::New(config_);
     tor_launcher_->Launch(std::move(config),
                           base::BindOnce(&TorLauncherFactory::OnTorLaunched,
@@ -113,6 +147,8 @@ void TorLauncherFactory::KillTorProcess() {
     tor_launcher_->Shutdown();
   control_->Stop();
   tor_launcher_.reset();
+  launch_weak_ptr_factory_.InvalidateWeakPtrs();
+  launch_time_ = base::TimeTicks();
   tor_pid_ = -1;
   is_starting_ = false;
   is_connected_ = false;
@@ -262,10 +298,25 @@ void TorLauncherFactory::GotCircuitEstablished(bool error, bool established) {
     return;
   }
   is_connected_ = established;
+  if (established)
+    RecordBootstrapTime();
   for (auto& observer : observers_)
     observer.OnTorCircuitEstablished(established);
 }
 
+void TorLauncherFactory::RecordBootstrapTime() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (launch_time_.is_null())
+    return;
+  const base::TimeDelta elapsed = base::TimeTicks::Now() - launch_time_;
+  launch_time_ = base::TimeTicks();
+  VLOG(2) << "Tor bootstrapped " << (warm_start_ ? "warm" : "cold") << " in "
+          << elapsed;
+  base::UmaHistogramMediumTimes(warm_start_ ? "Brave.Tor.BootstrapTime.Warm"
+                                            : "Brave.Tor.BootstrapTime.Cold",
+                                elapsed);
+}
+
 void TorLauncherFactory::OnTorControlClosed(bool was_running) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   VLOG(2) << "TOR CONTROL: Closed!";
@@ -306,7 +357,7 @@ void TorLauncherFactory::OnTorControlPrerequisitesReady(
 void TorLauncherFactory::RelaunchTor() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   Init();
-  LaunchTorInternal();
+  CheckCachedConsensusAndLaunch();
 }
 
 void TorLauncherFactory::DelayedRelaunchTor() {
@@ -342,8 +393,17 @@ void TorLauncherFactory::OnTorEvent(
           progress_length - strlen(kStatusClientBootstrapProgress));
       for (auto& observer : observers_)
         observer.OnTorInitializing(percentage);
+      const std::string tag =
+          GetStatusArgument(initial, kStatusClientBootstrapTag);
+      if (!tag.empty() && !launch_time_.is_null()) {
+        const base::TimeDelta elapsed = base::TimeTicks::Now() - launch_time_;
+        VLOG(2) << "Tor bootstrap phase " << tag << " after " << elapsed;
+        for (auto& observer : observers_)
+          observer.OnTorBootstrapPhase(tag, elapsed);
+      }
     } else if (initial.find(kStatusClientCircuitEstablished) !=
                std::string::npos) {
+      RecordBootstrapTime();
       for (auto& observer : observers_)
         observer.OnTorCircuitEstablished(true);
       is_connected_ = true;
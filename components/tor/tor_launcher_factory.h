@@ -17,7 +17,9 @@
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/sequence_checker.h"
+#include "base/time/time.h"
 #include "brave/components/services/tor/public/interfaces/tor.mojom.h"
+#include "brave/components/tor/tor_consensus_cache.h"
 #include "brave/components/tor/tor_control.h"
 #include "mojo/public/cpp/bindings/remote.h"
 
@@ -78,6 +80,12 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
   void GotSOCKSListeners(bool error, const std::vector<std::string>& listeners);
   void GotCircuitEstablished(bool error, bool established);
 
+  // Checks the consensus cached by the previous run before launching, so that
+  // bootstrap times can be told apart by whether tor started warm.
+  void CheckCachedConsensusAndLaunch();
+  void OnCachedConsensusChecked(tor::ConsensusCacheState state);
+  void RecordBootstrapTime();
+
   void LaunchTorInternal();
   void RelaunchTor();
   void DelayedRelaunchTor();
@@ -94,6 +102,10 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
 
   int64_t tor_pid_;
 
+  bool warm_start_ = false;
+  // Null once the first circuit since launch has been established.
+  base::TimeTicks launch_time_;
+
   tor::mojom::TorConfig config_;
 
   base::ObserverList<TorLauncherObserver> observers_;
@@ -102,6 +114,9 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
 
   SEQUENCE_CHECKER(sequence_checker_);
 
+  // Invalidated when tor is killed, dropping a launch that is waiting on the
+  // consensus check.
+  base::WeakPtrFactory<TorLauncherFactory> launch_weak_ptr_factory_{this};
   base::WeakPtrFactory<TorLauncherFactory> weak_ptr_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(TorLauncherFactory);
@@ -9,6 +9,7 @@
 #include <string>
 
 #include "base/observer_list_types.h"
+#include "base/time/time.h"
 
 class TorLauncherObserver : public base::CheckedObserver {
  public:
@@ -20,6 +21,10 @@ class TorLauncherObserver : public base::CheckedObserver {
   virtual void OnTorNewProxyURI(const std::string& uri) {}
   virtual void OnTorCircuitEstablished(bool result) {}
   virtual void OnTorInitializing(const std::string& percentage) {}
+  // Tor reached bootstrap phase |tag| (e.g. "requesting_descriptors") this
+  // long after it was launched.
+  virtual void OnTorBootstrapPhase(const std::string& tag,
+                                   base::TimeDelta elapsed) {}
   virtual void OnTorControlEvent(const std::string& event) {}
   virtual void OnTorLogUpdated() {}
 };
@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+# Copyright (c) 2021 The Brave Authors. All rights reserved.
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this file,
+# You can obtain one at https://mozilla.org/MPL/2.0/.
+
+"""Compiles the third-party entities JSON into a C++ header.
+
+The header holds the names of the entities relevant to the bandwidth model
+and two tables sorted by domain, one by full domain and one by root domain,
+which NamedThirdPartyRegistry binary searches in place.
+
+The tables match what NamedThirdPartyRegistry::LoadMappings() builds from
+the same JSON with |discard_irrelevant| set: irrelevant entities are
+skipped, the first entity claiming a domain wins, and a root domain is
+dropped when domains of several entities share it.
+"""
+
+import argparse
+import ipaddress
+import json
+import re
+import sys
+
+HEADER = """/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef {guard}
+#define {guard}
+
+/* This file is automatically generated, do not edit directly */
+
+#include <cstdint>
+
+#include "base/strings/string_piece.h"
+
+namespace brave_perf_predictor {{
+
+struct ThirdPartyDomainEntry {{
+  base::StringPiece domain;
+  uint16_t entity_id;
+}};
+
+constexpr base::StringPiece kThirdPartyEntityNames[] = {{
+{entity_names}
+}};
+
+// Sorted by domain.
+constexpr ThirdPartyDomainEntry kThirdPartyDomains[] = {{
+{domains}
+}};
+
+// Sorted by root domain.
+constexpr ThirdPartyDomainEntry kThirdPartyRootDomains[] = {{
+{root_domains}
+}};
+
+}}  // namespace brave_perf_predictor
+
+#endif  // {guard}
+"""
+
+
+class PublicSuffixList(object):
+    """The subset of net::registry_controlled_domains needed here, with
+    private registries included and unknown registries treated as one
+    label."""
+
+    def __init__(self, path):
+        self.rules = set()
+        self.wildcards = set()
+        self.exceptions = set()
+        with open(path, 'r', encoding='utf-8') as f:
+            for line in f:
+                line = line.strip()
+                if not line or line.startswith('//'):
+                    continue
+                rule = line.split()[0]
+                if rule.startswith('!'):
+                    self.exceptions.add(self._to_ascii(rule[1:]))
+                elif rule.startswith('*.'):
+                    self.wildcards.add(self._to_ascii(rule[2:]))
+                else:
+                    self.rules.add(self._to_ascii(rule))
+
+    @staticmethod
+    def _to_ascii(rule):
+        try:
+            return rule.encode('idna').decode('ascii')
+        except UnicodeError:
+            return rule
+
+    def _registry(self, labels):
+        for i in range(len(labels)):
+            suffix = '.'.join(labels[i:])
+            if suffix in self.exceptions:
+                return '.'.join(labels[i + 1:])
+            if suffix in self.rules:
+                return suffix
+            if i + 1 < len(labels) and \
+                    '.'.join(labels[i + 1:]) in self.wildcards:
+                return suffix
+        return labels[-1]
+
+    def get_domain_and_registry(self, host):
+        """Mirrors GetDomainAndRegistry(), returning '' for IP addresses and
+        hosts that are registries themselves."""
+        host = host.lower().rstrip('.')
+        try:
+            ipaddress.ip_address(host.strip('[]'))
+            return ''
+        except ValueError:
+            pass
+        labels = host.split('.')
+        if not all(labels):
+            return ''
+        registry = self._registry(labels)
+        registry_labels = registry.count('.') + 1
+        if registry_labels >= len(labels):
+            return ''
+        return '.'.join(labels[-(registry_labels + 1):])
+
+
+def read_relevant_entities(path):
+    """Reads |relevant_entities| from bandwidth_linreg_parameters.h."""
+    with open(path, 'r', encoding='utf-8') as f:
+        match = re.search(r'relevant_entities\s*\{(.*?)\};', f.read(), re.S)
+    if not match:
+        raise ValueError('No relevant_entities in ' + path)
+    return set(json.loads('"{}"'.format(name)) for name in re.findall(
+        r'"((?:[^"\\]|\\.)*)"', match.group(1)))
+
+
+def quote(value):
+    return json.dumps(value)
+
+
+def format_table(table):
+    # Sorted bytewise, as base::StringPiece compares.
+    return '\n'.join(
+        '    {{{}, {}}},'.format(quote(domain), table[domain])
+        for domain in sorted(table, key=lambda d: d.encode('utf-8')))
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--input', required=True)
+    parser.add_argument('--relevant-entities', required=True)
+    parser.add_argument('--public-suffix-list', required=True)
+    parser.add_argument('--output', required=True)
+    parser.add_argument('--include-guard', required=True)
+    args = parser.parse_args()
+
+    with open(args.input, 'r', encoding='utf-8') as f:
+        entities = json.load(f)
+    relevant_entities = read_relevant_entities(args.relevant_entities)
+    public_suffix_list = PublicSuffixList(args.public_suffix_list)
+
+    entity_names = []
+    entity_ids = {}
+    domains = {}
+    root_domain_entities = {}
+    for entity in entities:
+        name = entity.get('name')
+        entity_domains = entity.get('domains')
+        if not isinstance(name, str) or not isinstance(entity_domains, list):
+            continue
+        if name not in relevant_entities:
+            continue
+        if name not in entity_ids:
+            entity_ids[name] = len(entity_names)
+            entity_names.append(name)
+        entity_id = entity_ids[name]
+        for domain in entity_domains:
+            if not isinstance(domain, str):
+                continue
+            # Every occurrence counts towards root domain clashes, including
+            # domains already claimed by an earlier entity.
+            root_domain = public_suffix_list.get_domain_and_registry(domain)
+            if root_domain:
+                root_domain_entities.setdefault(root_domain,
+                                                set()).add(entity_id)
+            domains.setdefault(domain, entity_id)
+
+    root_domains = {
+        root_domain: next(iter(ids))
+        for root_domain, ids in root_domain_entities.items() if len(ids) == 1
+    }
+
+    if len(entity_names) > 0xFFFF:
+        sys.stderr.write('Too many entities for a uint16_t id\n')
+        return 1
+    if not domains or not root_domains:
+        sys.stderr.write('No third-party domains in ' + args.input + '\n')
+        return 1
+
+    with open(args.output, 'w', encoding='utf-8') as f:
+        f.write(HEADER.format(
+            guard=args.include_guard,
+            entity_names='\n'.join(
+                '    {},'.format(quote(name)) for name in entity_names),
+            domains=format_table(domains),
+            root_domains=format_table(root_domains)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())